@@ -0,0 +1,1015 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+//------------------------------------------------------------------------------
+// Microbenchmarks of the numerical kernels of the MCMC and REML updates.
+//
+// All problems are generated synthetically with a fixed seed. Every kernel is
+// called once to compute the checksum and then repeatedly until at least
+// 'mintime' seconds have been spent (but at least 3 times), the wall clock
+// time of each of these calls is recorded. The results
+// are written as one JSON object, one record per kernel and problem size:
+//
+//   {"kernel": "envmatrix::decomp", "params": {"n": 1000, "bandwidth": 2},
+//    "reps": 1520, "min": ..., "median": ..., "mean": ..., "checksum": ...}
+//
+// Times are in seconds per call. The checksum is computed from the result of
+// the first call and allows to detect changes of the numerical results.
+//
+// usage: BayesX_bench [-quick] [-mintime sec] [-filter text] [-tmp dir]
+//                     [-out file]
+//
+//   -quick    smaller problem sizes only
+//   -mintime  minimum time spent per kernel and size (default 0.5)
+//   -filter   runs only kernels whose name contains 'text'
+//   -tmp      directory for the temporary files of dataset::read and
+//             map::computeneighbors (default: current directory)
+//   -out      writes the JSON output to 'file' instead of stdout
+//------------------------------------------------------------------------------
+
+
+#if !defined (__BUILDING_GNU)
+#define __BUILDING_GNU
+#endif
+
+#include"statmat.h"
+#include"envmatrix.h"
+#include"bandmat.h"
+#include"Random.h"
+#include"data.h"
+#include"map.h"
+#include"model.h"
+#include"model_parameters.h"
+#include"GENERAL_OPTIONS.h"
+#include"MASTER_obj.h"
+#include"distr.h"
+#include"distr_categorical.h"
+#include"design_pspline.h"
+#include"FC_linear.h"
+#include"FC_nonp.h"
+
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<iomanip>
+#include<algorithm>
+#include<vector>
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#include<cstring>
+#include<sys/time.h>
+
+#if defined(_OPENMP)
+#include<omp.h>
+#endif
+
+using std::vector;
+using std::ofstream;
+using std::ostream;
+
+namespace bench
+{
+
+using namespace MCMC;
+
+//------------------------------------------------------------------------------
+//------------------------------ helpers ---------------------------------------
+//------------------------------------------------------------------------------
+
+// FUNCTION: walltime
+// TASK: returns the wall clock time in seconds
+
+static double walltime(void)
+  {
+  struct timeval tv;
+  gettimeofday(&tv,0);
+  return double(tv.tv_sec) + 1.0e-6*double(tv.tv_usec);
+  }
+
+
+// FUNCTION: sum
+// TASK: returns the sum of the elements of 'm' (used as checksum)
+
+static double sum(const datamatrix & m)
+  {
+  double s = 0;
+  double * work = m.getV();
+  unsigned i,size = m.rows()*m.cols();
+  for (i=0;i<size;i++,work++)
+    s += *work;
+  return s;
+  }
+
+
+// FUNCTION: sumsquares
+// TASK: returns the sum of the squared elements of 'm' (used as checksum of
+//       centered quantities)
+
+static double sumsquares(const datamatrix & m)
+  {
+  double s = 0;
+  double * work = m.getV();
+  unsigned i,size = m.rows()*m.cols();
+  for (i=0;i<size;i++,work++)
+    s += *work * *work;
+  return s;
+  }
+
+
+// FUNCTION: jsonnumber
+// TASK: writes 'v' as JSON number, NaN and infinite values as null
+
+static void jsonnumber(ostream & out,const double & v)
+  {
+  if (v != v || v > 1.0e308 || v < -1.0e308)
+    out << "null";
+  else
+    out << std::setprecision(10) << v;
+  }
+
+
+// FUNCTION: spdbandmatrix
+// TASK: returns a diagonally dominant (i.e. positive definite) symmetric band
+//       matrix of dimension n with bandwidth bw
+
+static symbandmatrix<double> spdbandmatrix(const unsigned & n,
+                                           const unsigned & bw)
+  {
+  symbandmatrix<double> A(n,bw,0);
+  vector<double> rowsum(n,1.0);
+  unsigned i,j;
+  double v;
+  for (i=0;i<n;i++)
+    for (j=i+1;j<=i+bw && j<n;j++)
+      {
+      v = -randnumbers::uniform();
+      A.set(i,j,v);
+      rowsum[i] -= v;
+      rowsum[j] -= v;
+      }
+  for (i=0;i<n;i++)
+    A.set(i,i,rowsum[i]);
+  return A;
+  }
+
+
+//------------------------------------------------------------------------------
+//---------------------------- CLASS: kernel -----------------------------------
+//------------------------------------------------------------------------------
+
+// base class of all benchmarks
+// setup() generates the problem, prepare() restores the input before each
+// call (not timed), run() calls the kernel once (this is the timed part),
+// checksum() summarizes the result of the last call
+
+class kernel
+  {
+
+  public:
+
+  ST::string name;                        // name of the kernel
+  vector<ST::string> paramnames;          // names of the size parameters
+  vector<double> params;                  // values of the size parameters
+
+  kernel(const ST::string & n)
+    {
+    name = n;
+    }
+
+  virtual ~kernel() {}
+
+  void addparam(const ST::string & n,const double & v)
+    {
+    paramnames.push_back(n);
+    params.push_back(v);
+    }
+
+  virtual void setup(void) {}
+
+  virtual void prepare(void) {}
+
+  virtual void run(void) = 0;
+
+  virtual double checksum(void) = 0;
+
+  };
+
+
+//------------------------------------------------------------------------------
+//------------------------- dense and band matrices ----------------------------
+//------------------------------------------------------------------------------
+
+class envmatrix_decomp : public kernel
+  {
+
+  protected:
+
+  unsigned n;
+  unsigned bw;
+  envmatrix<double> A;
+
+  public:
+
+  envmatrix_decomp(const unsigned & nn,const unsigned & b)
+    : kernel("envmatrix::decomp")
+    {
+    n = nn;
+    bw = b;
+    addparam("n",n);
+    addparam("bandwidth",bw);
+    }
+
+  void setup(void)
+    {
+    A = envmatrix<double>(spdbandmatrix(n,bw));
+    }
+
+  void run(void)
+    {
+    A.setDecomposed(false);
+    A.decomp();
+    }
+
+  double checksum(void)
+    {
+    return A.getLogDet();
+    }
+
+  };
+
+
+class envmatrix_solve : public envmatrix_decomp
+  {
+
+  protected:
+
+  datamatrix b;
+  datamatrix x;
+
+  public:
+
+  envmatrix_solve(const unsigned & nn,const unsigned & bwi)
+    : envmatrix_decomp(nn,bwi)
+    {
+    name = "envmatrix::solve";
+    }
+
+  void setup(void)
+    {
+    envmatrix_decomp::setup();
+    A.decomp();
+    b = datamatrix(n,1);
+    unsigned i;
+    for (i=0;i<n;i++)
+      b(i,0) = randnumbers::rand_normal();
+    x = datamatrix(n,1,0);
+    }
+
+  void run(void)
+    {
+    A.solve(b,x);
+    }
+
+  double checksum(void)
+    {
+    return sum(x);
+    }
+
+  };
+
+
+class symbandmatrix_decomp : public kernel
+  {
+
+  protected:
+
+  unsigned n;
+  unsigned bw;
+  symbandmatrix<double> A;
+  symbandmatrix<double> A0;
+
+  public:
+
+  symbandmatrix_decomp(const unsigned & nn,const unsigned & b)
+    : kernel("symbandmatrix::decomp")
+    {
+    n = nn;
+    bw = b;
+    addparam("n",n);
+    addparam("bandwidth",bw);
+    }
+
+  void setup(void)
+    {
+    A0 = spdbandmatrix(n,bw);
+    }
+
+  // for more than two bands decomp() overwrites the matrix
+
+  void prepare(void)
+    {
+    A = A0;
+    }
+
+  void run(void)
+    {
+    A.decomp();
+    }
+
+  double checksum(void)
+    {
+    return A.get_det();
+    }
+
+  };
+
+
+class statmatrix_mult : public kernel
+  {
+
+  protected:
+
+  unsigned n;
+  unsigned p;
+  unsigned m;
+  datamatrix A;
+  datamatrix B;
+  datamatrix C;
+
+  public:
+
+  // C (n x m) = A (n x p) * B (p x m)
+
+  statmatrix_mult(const unsigned & nn,const unsigned & pp,const unsigned & mm)
+    : kernel("statmatrix::mult")
+    {
+    n = nn;
+    p = pp;
+    m = mm;
+    addparam("rows",n);
+    addparam("inner",p);
+    addparam("cols",m);
+    }
+
+  void setup(void)
+    {
+    A = datamatrix(n,p);
+    B = datamatrix(p,m);
+    C = datamatrix(n,m,0);
+    unsigned i,j;
+    for (i=0;i<n;i++)
+      for (j=0;j<p;j++)
+        A(i,j) = randnumbers::rand_normal();
+    for (i=0;i<p;i++)
+      for (j=0;j<m;j++)
+        B(i,j) = randnumbers::rand_normal();
+    }
+
+  void run(void)
+    {
+    C.mult(A,B);
+    }
+
+  double checksum(void)
+    {
+    return sum(C);
+    }
+
+  };
+
+
+//------------------------------------------------------------------------------
+//------------------------ structured additive models --------------------------
+//------------------------------------------------------------------------------
+
+// a Gaussian model with intercept and one P-spline term, set up in the same
+// way as superbayesreg (see create_linear, create_pspline)
+
+class psplinemodel
+  {
+
+  public:
+
+  ostream nullout;
+  GENERAL_OPTIONS generaloptions;
+  MASTER_OBJ master;
+  DISTR_gaussian distr;
+  FC_linear fclinear;
+  DESIGN_pspline design;
+  FC_nonp fcnonp;
+
+  psplinemodel(const unsigned & nrobs,const ST::string & tmp)
+    : nullout(0)
+    {
+
+    // no samples are stored since all iterations belong to the burnin
+
+    generaloptions = GENERAL_OPTIONS(1000000000,1000000000,1,false,false,0,
+                                     false,0.0,false,false,&nullout);
+
+    datamatrix x(nrobs,1);
+    datamatrix y(nrobs,1);
+    unsigned i;
+    for (i=0;i<nrobs;i++)
+      {
+      x(i,0) = randnumbers::uniform_ab(-3,3);
+      y(i,0) = sin(x(i,0)) + 0.3*randnumbers::rand_normal();
+      }
+
+    distr = DISTR_gaussian(1,0.005,&generaloptions,y,tmp+"/bench_sigma2.raw");
+    master.level1_likep.push_back(&distr);
+
+    unsigned nrlevel1 = 0;
+
+    datamatrix X(nrobs,1,1);
+    vector<ST::string> constnames;
+    constnames.push_back("const");
+    fclinear = FC_linear(&master,nrlevel1,&generaloptions,&distr,X,constnames,
+                         "linear effects",tmp+"/bench_linear.raw",false,false);
+
+    // options of the term as generated by the model parser of mcmcreg
+
+    vector<ST::string> tnames;
+    tnames.push_back("pspline");
+    term_nonp tnonp(tnames);
+    basic_termtype lineareffects;
+    vector<basic_termtype*> termtypes;
+    termtypes.push_back(&tnonp);
+    termtypes.push_back(&lineareffects);
+    modelterm modreg(&termtypes);
+    modreg.parse("y = x(pspline)");
+    vector<term> terms = modreg.getterms();
+
+    for (i=0;i<terms.size();i++)
+      if (terms[i].options.size() > 0 && terms[i].options[0] == "pspline")
+        break;
+
+    datamatrix iv;
+    design = DESIGN_pspline(x,iv,&generaloptions,&distr,&fclinear,
+                            terms[i].options,terms[i].varnames);
+
+    fcnonp = FC_nonp(&master,nrlevel1,&generaloptions,&distr,
+                     "f(x)",tmp+"/bench_pspline.raw",&design,
+                     terms[i].options,terms[i].varnames);
+
+    // posterior mode as starting values (see MCMCsim::posteriormode), this
+    // also sets up X'WX and the precision matrix of the P-spline
+
+    bool converged = false;
+    unsigned it = 0;
+    distr.posteriormode_end();
+    while (!converged && it < 100)
+      {
+      converged = distr.posteriormode();
+      if (fclinear.posteriormode() == false)
+        converged = false;
+      if (fcnonp.posteriormode() == false)
+        converged = false;
+      distr.posteriormode_end();
+      it++;
+      }
+
+    }
+
+  };
+
+
+class design_XtransposedWX : public kernel
+  {
+
+  protected:
+
+  unsigned nrobs;
+  ST::string tmp;
+  psplinemodel * model;
+  double factor;
+
+  public:
+
+  design_XtransposedWX(const unsigned & n,const ST::string & t)
+    : kernel("DESIGN::compute_XtransposedWX")
+    {
+    nrobs = n;
+    tmp = t;
+    model = 0;
+    addparam("nrobs",nrobs);
+    }
+
+  ~design_XtransposedWX()
+    {
+    delete model;
+    }
+
+  void setup(void)
+    {
+    model = new psplinemodel(nrobs,tmp);
+
+    // GENERAL_OPTIONS::update would print the iteration number to cout
+
+    model->generaloptions.nriter++;
+    model->distr.update();
+    model->fcnonp.update();
+    factor = 1.001;
+    }
+
+  void run(void)
+    {
+    // all sums of weights change, i.e. X'WX is always computed from scratch
+
+    unsigned i;
+    double * work = model->design.Wsum.getV();
+    for (i=0;i<model->design.Wsum.rows();i++,work++)
+      *work *= factor;
+    factor = 1.0/factor;
+
+    model->design.compute_XtransposedWX();
+    }
+
+  double checksum(void)
+    {
+    return model->design.XWX.getLogDet();
+    }
+
+  };
+
+
+class design_XtransposedWres : public design_XtransposedWX
+  {
+
+  protected:
+
+  datamatrix partres;
+
+  public:
+
+  design_XtransposedWres(const unsigned & n,const ST::string & t)
+    : design_XtransposedWX(n,t)
+    {
+    name = "DESIGN::compute_XtransposedWres";
+    }
+
+  void setup(void)
+    {
+    design_XtransposedWX::setup();
+    datamatrix f(model->design.Zout.rows(),1,0);
+    partres = datamatrix(model->design.posbeg.size(),1,0);
+    model->design.compute_partres(partres,f);
+    }
+
+  void run(void)
+    {
+    model->design.compute_XtransposedWres(partres,1.0,1.0);
+    }
+
+  double checksum(void)
+    {
+    return sumsquares(*(model->design.XWres_p));
+    }
+
+  };
+
+
+class fc_nonp_update : public design_XtransposedWX
+  {
+
+  public:
+
+  fc_nonp_update(const unsigned & n,const ST::string & t)
+    : design_XtransposedWX(n,t)
+    {
+    name = "FC_nonp::update";
+    }
+
+  void run(void)
+    {
+    model->generaloptions.nriter++;
+    model->fcnonp.update();
+    }
+
+  double checksum(void)
+    {
+    return sumsquares(model->fcnonp.beta);
+    }
+
+  };
+
+
+//------------------------------------------------------------------------------
+//---------------------------- IWLS loops --------------------------------------
+//------------------------------------------------------------------------------
+
+// FUNCTION: drawresponse
+// TASK: returns a response drawn for linear predictor 'eta' (the first
+//       argument only selects the distribution)
+
+static double drawresponse(const DISTR_poisson &,const double & eta)
+  {
+  return floor(exp(eta)+randnumbers::uniform());
+  }
+
+static double drawresponse(const DISTR_binomial &,const double & eta)
+  {
+  return randnumbers::uniform() < 1/(1+exp(-eta)) ? 1 : 0;
+  }
+
+
+// D is the response distribution (DISTR_poisson or DISTR_binomial), the
+// object is held by value since DISTR has no virtual destructor
+
+template<class D>
+class distr_iwls : public kernel
+  {
+
+  protected:
+
+  unsigned nrobs;
+  GENERAL_OPTIONS generaloptions;
+  D distr;
+  double like;
+
+  public:
+
+  distr_iwls(const ST::string & name,const unsigned & n)
+    : kernel(name)
+    {
+    nrobs = n;
+    addparam("nrobs",nrobs);
+    }
+
+  void setup(void)
+    {
+    datamatrix y(nrobs,1);
+    datamatrix eta(nrobs,1);
+    unsigned i;
+    for (i=0;i<nrobs;i++)
+      {
+      eta(i,0) = 0.5*randnumbers::rand_normal();
+      y(i,0) = drawresponse(distr,eta(i,0));
+      }
+
+    distr = D(&generaloptions,y);
+
+    distr.linearpred1.assign(eta);
+    }
+
+  void run(void)
+    {
+    // the overloads of the derived classes hide DISTR::compute_iwls
+
+    like = distr.DISTR::compute_iwls(true,true);
+    }
+
+  double checksum(void)
+    {
+    return like + sum(distr.workingweight);
+    }
+
+  };
+
+
+//------------------------------------------------------------------------------
+//--------------------------- data and maps ------------------------------------
+//------------------------------------------------------------------------------
+
+class dataset_read : public kernel
+  {
+
+  protected:
+
+  unsigned nrobs;
+  unsigned nrvar;
+  ST::string path;
+  dataset d;
+
+  public:
+
+  dataset_read(const unsigned & n,const unsigned & v,const ST::string & tmp)
+    : kernel("dataset::read")
+    {
+    nrobs = n;
+    nrvar = v;
+    path = tmp + "/bench_data.raw";
+    addparam("nrobs",nrobs);
+    addparam("nrvar",nrvar);
+    }
+
+  ~dataset_read()
+    {
+    remove(path.strtochar());
+    }
+
+  void setup(void)
+    {
+    ofstream out(path.strtochar());
+    unsigned i,j;
+    for (j=0;j<nrvar;j++)
+      out << "x" << j << (j < nrvar-1 ? " " : "\n");
+    out << std::setprecision(8);
+    for (i=0;i<nrobs;i++)
+      for (j=0;j<nrvar;j++)
+        {
+        if (j == 0)
+          out << i%100;
+        else
+          out << randnumbers::rand_normal();
+        out << (j < nrvar-1 ? " " : "\n");
+        }
+    }
+
+  void run(void)
+    {
+    ifstream in(path.strtochar());
+    ST::string missing = "NA";
+    d.read(in,missing,nrobs);
+    }
+
+  double checksum(void)
+    {
+    return d.obs();
+    }
+
+  };
+
+
+class map_computeneighbors : public kernel
+  {
+
+  protected:
+
+  unsigned k;
+  ST::string path;
+  MAP::map m;
+
+  public:
+
+  // k x k grid of unit squares
+
+  map_computeneighbors(const unsigned & kk,const ST::string & tmp)
+    : kernel("map::computeneighbors")
+    {
+    k = kk;
+    path = tmp + "/bench_map.bnd";
+    addparam("regions",k*k);
+    }
+
+  ~map_computeneighbors()
+    {
+    remove(path.strtochar());
+    }
+
+  void setup(void)
+    {
+    ofstream out(path.strtochar());
+    unsigned i,j;
+    for (i=0;i<k;i++)
+      for (j=0;j<k;j++)
+        {
+        out << "\"" << i*k+j << "\",5" << endl;
+        out << i << "," << j << endl;
+        out << i+1 << "," << j << endl;
+        out << i+1 << "," << j+1 << endl;
+        out << i << "," << j+1 << endl;
+        out << i << "," << j << endl;
+        }
+    out.close();
+    m = MAP::map(path,MAP::adjacent);
+    }
+
+  void run(void)
+    {
+    m.computeneighbors();
+    }
+
+  double checksum(void)
+    {
+    return m.get_maxn();
+    }
+
+  };
+
+
+//------------------------------------------------------------------------------
+//------------------------------ driver ----------------------------------------
+//------------------------------------------------------------------------------
+
+// FUNCTION: measure
+// TASK: runs kernel 'k' and writes its JSON record to 'out'
+
+static void measure(kernel & k,const double & mintime,ostream & out,
+                    bool & first)
+  {
+
+  k.setup();
+
+  k.prepare();
+  k.run();
+  double check = k.checksum();
+
+  vector<double> times;
+  double total = 0;
+  double t0,t1;
+
+  while (times.size() < 3 || total < mintime)
+    {
+    k.prepare();
+    t0 = walltime();
+    k.run();
+    t1 = walltime();
+    times.push_back(t1-t0);
+    total += t1-t0;
+    }
+
+  double mean = total/times.size();
+  std::sort(times.begin(),times.end());
+  unsigned n = times.size();
+  double median = n%2 == 1 ? times[n/2] : 0.5*(times[n/2-1]+times[n/2]);
+
+  if (!first)
+    out << ",\n";
+  first = false;
+
+  unsigned i;
+  out << "    {\"kernel\": \"" << k.name.strtochar() << "\", \"params\": {";
+  for (i=0;i<k.params.size();i++)
+    {
+    if (i > 0)
+      out << ", ";
+    out << "\"" << k.paramnames[i].strtochar() << "\": ";
+    jsonnumber(out,k.params[i]);
+    }
+  out << "}, \"reps\": " << n << ", \"min\": ";
+  jsonnumber(out,times[0]);
+  out << ", \"median\": ";
+  jsonnumber(out,median);
+  out << ", \"mean\": ";
+  jsonnumber(out,mean);
+  out << ", \"checksum\": ";
+  jsonnumber(out,check);
+  out << "}" << std::flush;
+
+  std::cerr << std::setprecision(10) << k.name.strtochar() << " ";
+  for (i=0;i<k.params.size();i++)
+    std::cerr << k.paramnames[i].strtochar() << "=" << k.params[i] << " ";
+  std::cerr << "median " << median << " s" << endl;
+
+  }
+
+} // end: namespace bench
+
+
+int main(int argc, char *argv[])
+  {
+
+  using namespace bench;
+
+  bool quick = false;
+  double mintime = 0.5;
+  const char * filter = "";
+  ST::string tmp = ".";
+  ST::string outfile = "";
+
+  int a;
+  for (a=1;a<argc;a++)
+    {
+    if (strcmp(argv[a],"-quick") == 0)
+      quick = true;
+    else if (strcmp(argv[a],"-mintime") == 0 && a+1 < argc)
+      mintime = atof(argv[++a]);
+    else if (strcmp(argv[a],"-filter") == 0 && a+1 < argc)
+      filter = argv[++a];
+    else if (strcmp(argv[a],"-tmp") == 0 && a+1 < argc)
+      tmp = argv[++a];
+    else if (strcmp(argv[a],"-out") == 0 && a+1 < argc)
+      outfile = argv[++a];
+    else
+      {
+      std::cerr << "usage: " << argv[0] << " [-quick] [-mintime sec]"
+                << " [-filter text] [-tmp dir] [-out file]" << endl;
+      return 1;
+      }
+    }
+
+  // problem sizes
+
+  vector<unsigned> nband;                 // dimension of band matrices
+  vector<unsigned> nmult;                 // dimension of dense matrices
+  vector<unsigned> nobs;                  // observations of model terms
+  vector<unsigned> niwls;                 // observations of IWLS loops
+  vector<unsigned> ngrid;                 // grid size of maps
+
+  nband.push_back(1000);
+  nband.push_back(10000);
+  nmult.push_back(50);
+  nmult.push_back(200);
+  nobs.push_back(1000);
+  nobs.push_back(10000);
+  niwls.push_back(10000);
+  niwls.push_back(100000);
+  ngrid.push_back(10);
+  ngrid.push_back(20);
+
+  if (!quick)
+    {
+    nband.push_back(100000);
+    nmult.push_back(500);
+    nobs.push_back(100000);
+    niwls.push_back(1000000);
+    ngrid.push_back(40);
+    }
+
+  vector<kernel*> kernels;
+  unsigned i,j;
+
+  for (i=0;i<nband.size();i++)
+    {
+    kernels.push_back(new envmatrix_decomp(nband[i],2));
+    kernels.push_back(new envmatrix_decomp(nband[i],20));
+    kernels.push_back(new envmatrix_solve(nband[i],2));
+    kernels.push_back(new envmatrix_solve(nband[i],20));
+    kernels.push_back(new symbandmatrix_decomp(nband[i],2));
+    kernels.push_back(new symbandmatrix_decomp(nband[i],20));
+    }
+  for (i=0;i<nmult.size();i++)
+    {
+    kernels.push_back(new statmatrix_mult(nmult[i],nmult[i],nmult[i]));
+    kernels.push_back(new statmatrix_mult(100*nmult[i],nmult[i]/10,1));
+    }
+  for (i=0;i<nobs.size();i++)
+    {
+    kernels.push_back(new design_XtransposedWX(nobs[i],tmp));
+    kernels.push_back(new design_XtransposedWres(nobs[i],tmp));
+    kernels.push_back(new fc_nonp_update(nobs[i],tmp));
+    kernels.push_back(new dataset_read(nobs[i],10,tmp));
+    }
+  for (i=0;i<niwls.size();i++)
+    {
+    kernels.push_back(new distr_iwls<DISTR_poisson>(
+                      "DISTR_poisson::compute_iwls",niwls[i]));
+    kernels.push_back(new distr_iwls<DISTR_binomial>(
+                      "DISTR_binomial::compute_iwls",niwls[i]));
+    }
+  for (i=0;i<ngrid.size();i++)
+    kernels.push_back(new map_computeneighbors(ngrid[i],tmp));
+
+  ofstream fout;
+  if (outfile != "")
+    {
+    fout.open(outfile.strtochar());
+    if (fout.fail())
+      {
+      std::cerr << "ERROR: cannot write to " << outfile.strtochar() << endl;
+      return 1;
+      }
+    }
+  ostream & out = (outfile != "") ? fout : std::cout;
+
+  out << "{\n  \"suite\": \"BayesX kernel benchmarks\",\n";
+  out << "  \"quick\": " << (quick ? "true" : "false") << ",\n";
+  out << "  \"mintime\": ";
+  jsonnumber(out,mintime);
+  out << ",\n";
+#if defined(_OPENMP)
+  out << "  \"threads\": " << omp_get_max_threads() << ",\n";
+#else
+  out << "  \"threads\": 1,\n";
+#endif
+#if defined(INCLUDE_BLAS)
+  out << "  \"blas\": true,\n";
+#else
+  out << "  \"blas\": false,\n";
+#endif
+  out << "  \"results\": [\n";
+
+  bool first = true;
+  for (j=0;j<kernels.size();j++)
+    {
+    if (strstr(kernels[j]->name.strtochar(),filter) != 0)
+      {
+      srand(123);
+      measure(*kernels[j],mintime,out,first);
+      }
+    delete kernels[j];
+    }
+
+  out << "\n  ]\n}\n";
+
+  return 0;
+  }
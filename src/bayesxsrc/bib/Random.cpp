@@ -508,6 +508,216 @@ double truncnormal(const double & a,const double & b)
   }
 
 
+// polar method, returns two independent standard normal variates
+
+static void normal_pair(double & z1,double & z2)
+  {
+  double v1,v2,r;
+  do
+    {
+    v1 = 2*uniform()-1;
+    v2 = 2*uniform()-1;
+    r = v1*v1+v2*v2;
+    }
+  while ((r >= 1) || (r == 0));
+
+  r = sqrt(-2*log(r)/r);
+  z1 = v1*r;
+  z2 = v2*r;
+  }
+
+
+void trunc_normal_lower(const double * a,double * x,const unsigned & n)
+  {
+  unsigned i;
+  bool spare = false;
+  double z1=0;
+  double z2=0;
+  double z;
+  double lambda;
+
+  for (i=0;i<n;i++,a++,x++)
+    {
+
+    if (*a < 0.45)
+      {
+      // normal (a < 0) or half-normal proposals
+      do
+        {
+        if (spare)
+          {
+          z = z2;
+          spare = false;
+          }
+        else
+          {
+          normal_pair(z1,z2);
+          z = z1;
+          spare = true;
+          }
+        if (*a >= 0)
+          z = fabs(z);
+        }
+      while (z < *a);
+      }
+    else
+      {
+      // exponential proposals
+      lambda = 0.5*(*a+sqrt(*a * *a+4));
+      do
+        {
+        z = *a-log(uniform())/lambda;
+        }
+      while (uniform() > exp(-0.5*(z-lambda)*(z-lambda)));
+      }
+
+    *x = z;
+    }
+
+  }
+
+
+double trunc_normal_lower(const double & a)
+  {
+  double x;
+  trunc_normal_lower(&a,&x,1);
+  return x;
+  }
+
+
+// Polya-Gamma PG(1,c) sampler (Polson, Scott and Windle, 2013).
+// Draws J*(1,z) with z = |c|/2 from a mixture of a truncated inverse
+// Gaussian (x < t) and a truncated exponential (x >= t) proposal, accepted
+// with the alternating series representation of the density.
+// PG(1,c) = J*(1,z)/4.
+
+static const double pg_trunc = 0.64;
+
+// log of the standard normal distribution function
+
+static double logPhi_exact(const double & x)
+  {
+  return log(0.5*erfc(-x/sqrt(2.0)));
+  }
+
+// n-th coefficient of the alternating series
+
+static double pg_coefficient(const unsigned & n,const double & x)
+  {
+  double k = (n+0.5)*M_PI;
+  if (x > pg_trunc)
+    return k*exp(-0.5*k*k*x);
+  else if (x > 0)
+    return exp(-1.5*(log(0.5*M_PI)+log(x))+log(k)-2.0*(n+0.5)*(n+0.5)/x);
+  else
+    return 0;
+  }
+
+// probability of the truncated exponential part of the proposal
+
+static double pg_mass_texpon(const double & z)
+  {
+  double t = pg_trunc;
+  double fz = 0.125*M_PI*M_PI+0.5*z*z;
+  double b = sqrt(1.0/t)*(t*z-1);
+  double a = -sqrt(1.0/t)*(t*z+1);
+  double x0 = log(fz)+fz*t;
+  double xb = x0-z+logPhi_exact(b);
+  double xa = x0+z+logPhi_exact(a);
+  double qdivp = 4/M_PI*(exp(xb)+exp(xa));
+  return 1.0/(1.0+qdivp);
+  }
+
+// inverse Gaussian with mean 1/z truncated to (0,t)
+
+static double pg_rtigauss(const double & z)
+  {
+  double t = pg_trunc;
+  double x = t+1.0;
+  if (z < 1/t)
+    {
+    double alpha = 0.0;
+    double e1,e2;
+    while (uniform() > alpha)
+      {
+      do
+        {
+        e1 = -log(uniform());
+        e2 = -log(uniform());
+        }
+      while (e1*e1 > 2*e2/t);
+      x = 1+e1*t;
+      x = t/(x*x);
+      alpha = exp(-0.5*z*z*x);
+      }
+    }
+  else
+    {
+    double mu = 1.0/z;
+    double y,muy;
+    while (x > t)
+      {
+      y = rand_normal();
+      y *= y;
+      muy = mu*y;
+      x = mu+0.5*mu*muy-0.5*mu*sqrt(4*muy+muy*muy);
+      if (uniform() > mu/(mu+x))
+        x = mu*mu/x;
+      }
+    }
+  return x;
+  }
+
+
+static double rand_polyagamma1(const double & c)
+  {
+  double z = 0.5*fabs(c);
+  double fz = 0.125*M_PI*M_PI+0.5*z*z;
+  double pexp = pg_mass_texpon(z);
+  double x,s,y;
+  unsigned n;
+
+  while (true)
+    {
+    if (uniform() < pexp)
+      x = pg_trunc-log(uniform())/fz;
+    else
+      x = pg_rtigauss(z);
+
+    s = pg_coefficient(0,x);
+    y = uniform()*s;
+    n = 0;
+    while (true)
+      {
+      n++;
+      if (n % 2 == 1)
+        {
+        s -= pg_coefficient(n,x);
+        if (y <= s)
+          return 0.25*x;
+        }
+      else
+        {
+        s += pg_coefficient(n,x);
+        if (y > s)
+          break;
+        }
+      }
+    }
+
+  }
+
+
+double rand_polyagamma(const unsigned & b,const double & c)
+  {
+  double sum = 0;
+  unsigned i;
+  for (i=0;i<b;i++)
+    sum += rand_polyagamma1(c);
+  return sum;
+  }
+
+
 // efficient random number generation from truncated normal for copula models.
 //compared to trunc_normal2, u has already been computed
 /*double trunc_normal_copula(const double & a,const double & b,const double & mu,
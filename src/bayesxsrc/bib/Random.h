@@ -109,6 +109,20 @@ double __EXPORT_TYPE trunc_normal4(const double & a,const double & mu,
 
 double __EXPORT_TYPE truncnormal(const double & a,const double & b);
 
+// FUNCTION: trunc_normal_lower
+// TASK: fills x[0],...,x[n-1] with draws from standard normal distributions
+//       truncated to [a[i],infinity). Exact mixed rejection sampler
+//       (Geweke 1991, Robert 1995): normal proposals for a < 0, half-normal
+//       proposals for 0 <= a < 0.45 and exponential proposals with optimal
+//       rate for a >= 0.45. Normal variates are generated in pairs (polar
+//       method), i.e. blocks of draws need about half the uniforms of
+//       single draws.
+
+void __EXPORT_TYPE trunc_normal_lower(const double * a,double * x,
+                                      const unsigned & n);
+
+double __EXPORT_TYPE trunc_normal_lower(const double & a);
+
 // efficient random number generation from truncated normal for copula models.
 //compared to trunc_normal2, u has already been computed
 //double __EXPORT_TYPE trunc_normal_copula(const double & a,const double & b,const double & mu,
@@ -168,6 +182,14 @@ void __EXPORT_TYPE rand_wishart(Matrix<double> & Sigma,const unsigned & n,Matrix
 
 double __EXPORT_TYPE rand_inv_gaussian(const double mu, const double lambda);
 
+// FUNCTION: rand_polyagamma
+// TASK: generates a random number from the Polya-Gamma distribution
+//       PG(b,c) for positive integer b as sum of b draws from PG(1,c).
+//       PG(1,c) is sampled exactly with the alternating series method of
+//       Polson, Scott and Windle (2013).
+
+double __EXPORT_TYPE rand_polyagamma(const unsigned & b,const double & c);
+
 // Erzeugen einer Zufallszahl x ~ 1+1/x auf dem Intervall [1/f,f]
 
 double __EXPORT_TYPE rand_variance(const double f);
@@ -0,0 +1,128 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+#include"arena.h"
+
+namespace scratch
+{
+
+#if defined(COUNT_ALLOCATIONS)
+std::atomic<unsigned long> nrheapallocations(0);
+#endif
+
+// minimum size of a block (number of doubles)
+
+static const unsigned arena_minblocksize = 4096;
+
+
+arena::arena(void)
+  {
+  current = 0;
+  used = 0;
+  total = 0;
+  }
+
+
+arena::~arena()
+  {
+  unsigned i;
+  for (i=0;i<blocks.size();i++)
+    delete [] blocks[i];
+  }
+
+
+double * arena::allocate(const unsigned & n)
+  {
+
+  if (n == 0)
+    return 0;
+
+  // next block that is large enough, further blocks are added at the end
+
+  while (current < blocks.size() && used+n > blocksizes[current])
+    {
+    current++;
+    used = 0;
+    }
+
+  if (current == blocks.size())
+    {
+    unsigned size = n < arena_minblocksize ? arena_minblocksize : n;
+    blocks.push_back(new double[size]);
+    blocksizes.push_back(size);
+    used = 0;
+    }
+
+  double * p = blocks[current]+used;
+  used += n;
+  total += n;
+  return p;
+  }
+
+
+double * arena::allocate(const unsigned & n,const double & init)
+  {
+  double * p = allocate(n);
+  double * work = p;
+  unsigned i;
+  for (i=0;i<n;i++,work++)
+    *work = init;
+  return p;
+  }
+
+
+void arena::reset(void)
+  {
+
+  if (blocks.size() > 1)
+    {
+    // replace the blocks by a single block that would have been sufficient
+
+    unsigned long size = 0;
+    unsigned i;
+    for (i=0;i<blocks.size();i++)
+      {
+      size += blocksizes[i];
+      delete [] blocks[i];
+      }
+    if (size < total)
+      size = total;
+
+    blocks.erase(blocks.begin(),blocks.end());
+    blocksizes.erase(blocksizes.begin(),blocksizes.end());
+    blocks.push_back(new double[size]);
+    blocksizes.push_back(unsigned(size));
+    }
+
+  current = 0;
+  used = 0;
+  total = 0;
+  }
+
+
+arena & iteration_arena(void)
+  {
+  static arena a;
+  return a;
+  }
+
+
+} // end: namespace scratch
@@ -0,0 +1,111 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+#if !defined (ARENA_INCLUDED)
+
+#define ARENA_INCLUDED
+
+#include"../export_type.h"
+#include<vector>
+
+#if defined(COUNT_ALLOCATIONS)
+#include<atomic>
+#endif
+
+//------------------------------------------------------------------------------
+//-------------------------- namespace scratch ---------------------------------
+//------------------------------------------------------------------------------
+
+// Scratch memory for temporaries of the MCMC updates. Memory is taken from
+// the arena by advancing a pointer and released all at once by reset(),
+// which MCMCsim::simulate calls at the end of each iteration. Memory from
+// the arena must therefore never be kept beyond the current iteration.
+// After the first iterations the arena consists of a single block that is
+// large enough, i.e. no further heap allocations take place.
+//
+// If compiled with COUNT_ALLOCATIONS, Array2D counts its heap allocations
+// and MCMCsim::simulate reports the average number per iteration.
+
+namespace scratch
+{
+
+class __EXPORT_TYPE arena
+  {
+
+  protected:
+
+  std::vector<double *> blocks;              // memory blocks
+  std::vector<unsigned> blocksizes;          // sizes of the blocks
+  unsigned current;                          // block currently used
+  unsigned used;                             // used elements of this block
+  unsigned long total;                       // elements allocated since the
+                                             // last reset
+
+  private:
+
+  arena(const arena &);
+  const arena & operator=(const arena &);
+
+  public:
+
+  // CONSTRUCTOR
+
+  arena(void);
+
+  // DESTRUCTOR
+
+  ~arena();
+
+  // FUNCTION: allocate
+  // TASK: returns memory for n doubles, valid until the next reset
+
+  double * allocate(const unsigned & n);
+
+  // FUNCTION: allocate
+  // TASK: returns memory for n doubles initialized with 'init'
+
+  double * allocate(const unsigned & n,const double & init);
+
+  // FUNCTION: reset
+  // TASK: releases all memory allocated since the last reset, if more than
+  //       one block was needed the blocks are replaced by a single block of
+  //       the total size
+
+  void reset(void);
+
+  };
+
+// FUNCTION: iteration_arena
+// TASK: returns the arena that is reset after each MCMC iteration
+
+arena & __EXPORT_TYPE iteration_arena(void);
+
+#if defined(COUNT_ALLOCATIONS)
+
+// number of heap allocations of Array2D since the start of the program
+// (atomic, since matrices are also allocated within OpenMP regions)
+
+extern std::atomic<unsigned long> nrheapallocations;
+
+#endif
+
+} // end: namespace scratch
+
+#endif
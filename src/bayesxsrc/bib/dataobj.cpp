@@ -184,6 +184,38 @@ dataobject::dataobject(const ST::string & n,ofstream * lo,istream * in)
 	 create();
 	 }
 
+void dataobject::addvariable(const ST::string & name,const double * v,
+                             const unsigned & n)
+  {
+
+  errormessages.clear();
+
+  if ((d.obs() == 0) && (d.varnr() == 0))
+    d.setobs(n);
+
+  if ((n == 0) || (n != d.obs()))
+    {
+    errormessages.push_back("ERROR: variable " + name +
+                            " has an invalid number of observations\n");
+    return;
+    }
+
+  realvar r(n);
+  unsigned i;
+  for (i=0;i<n;i++,v++)
+    {
+    if (*v != *v)
+      r[i] = NA;
+    else
+      r[i] = *v;
+    }
+
+  d.addvariable(name,r);
+  errormessages = d.geterrormessages();
+
+  }
+
+
 dataobject::dataobject(const dataobject & o) : statobject(statobject(o))
   {
   create();
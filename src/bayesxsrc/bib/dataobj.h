@@ -283,6 +283,16 @@ class __EXPORT_TYPE dataobject : public statobject
     return d;
     }
 
+  // FUNCTION: addvariable
+  // TASK: adds variable 'name' with observations v[0],...,v[n-1] (e.g. a
+  //       column of a calling program), NaN's are treated as missing values
+  // POSSIBLE ERRORS:
+  // - 'name' is not a valid or an already existing variable name
+  // - n differs from the number of observations of the dataset
+
+  void addvariable(const ST::string & name,const double * v,
+                   const unsigned & n);
+
 
   };
 
@@ -147,7 +147,7 @@ envmatrix<T>::envmatrix(const vector<T> & v, const vector<T> & d,
   {
   assert(d.size()+1==xe.size());
   assert(v.size()==xe[d.size()]);
-  assert(bw<d.size());
+  assert(unsigned(bw)<d.size());
   xenv=xe;
   diag=d;
   dim=diag.size();
@@ -0,0 +1,147 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+#include"inprocess.h"
+#include"dataobj.h"
+#include"superbayesreg.h"
+#include<iostream>
+#include<sstream>
+#include<exception>
+
+using std::cout;
+using std::cin;
+using std::flush;
+
+
+// redirects the screen output into a stream buffer, the original buffer of
+// cout is restored when the object is destroyed (also if an exception is
+// thrown)
+
+class coutredirection
+  {
+
+  protected:
+
+  std::streambuf * coutbuf;
+
+  public:
+
+  coutredirection(std::streambuf * b)
+    {
+    coutbuf = cout.rdbuf(b);
+    }
+
+  ~coutredirection()
+    {
+    cout << flush;
+    cout.rdbuf(coutbuf);
+    }
+
+  };
+
+
+bool run_inprocess(const vector<ST::string> & varnames,
+                   const vector<const double *> & columns,
+                   const unsigned & nrobs,
+                   const ST::string & model,
+                   const ST::string & options,
+                   const ST::string & path,
+                   vector<ST::string> & names,
+                   vector< vector<ST::string> > & labels,
+                   vector<datamatrix> & summaries,
+                   vector<datamatrix> & samples,
+                   ST::string & log)
+  {
+
+  // the screen output is redirected into a string
+
+  std::ostringstream screen;
+  bool errors = false;
+
+  {
+  coutredirection redirection(screen.rdbuf());
+
+  // exceptions (e.g. std::bad_alloc) must not reach the calling program
+
+  try
+    {
+    ofstream logout;                    // no logfile
+
+    // dataset
+
+    dataobject data("inprocessdata",&logout,&cin);
+
+    unsigned j;
+    for (j=0;j<varnames.size() && (errors == false);j++)
+      {
+      data.addvariable(varnames[j],columns[j],nrobs);
+      if (data.geterrormessages().size() > 0)
+        {
+        errors = true;
+        for (unsigned k=0;k<data.geterrormessages().size();k++)
+          cout << data.geterrormessages()[k];
+        }
+      }
+
+    // estimation
+
+    if (errors == false)
+      {
+      vector<statobject*> objects;
+      objects.push_back(&data);
+
+      superbayesreg reg("inprocessreg",&logout,&cin,path,&objects);
+      reg.set_inmemory(true);
+
+      ST::string command = "hregress " + model;
+      if (options.length() > 0)
+        command = command + ", " + options;
+      command = command + " using inprocessdata";
+
+      reg.parse(command);
+
+      if (reg.geterrormessages().size() > 0)
+        {
+        errors = true;
+        for (unsigned k=0;k<reg.geterrormessages().size();k++)
+          cout << reg.geterrormessages()[k];
+        }
+      else
+        errors = reg.get_results(names,labels,summaries,samples);
+      }
+
+    }
+  catch (const std::exception & e)
+    {
+    errors = true;
+    cout << "ERROR: " << e.what() << "\n";
+    }
+  catch (...)
+    {
+    errors = true;
+    cout << "ERROR: unknown exception\n";
+    }
+  }
+
+  log = ST::string(screen.str());
+
+  return errors;
+  }
@@ -0,0 +1,61 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+#include"../export_type.h"
+
+#ifndef INPROCESS_INCLUDED
+#define INPROCESS_INCLUDED
+
+#include"clstring.h"
+#include"statmat.h"
+#include<vector>
+
+using std::vector;
+
+// FUNCTION: run_inprocess
+// TASK: estimates a model with method 'hregress' of an mcmcreg object
+//       without reading or writing any files, i.e. for calling BayesX from
+//       within another program (e.g. R, see ../rinterface.cpp)
+//       varnames  : names of the variables
+//       columns   : columns[j] points to the nrobs observations of variable
+//                   varnames[j]
+//       model     : model specification, e.g. "y = x1 + x2(pspline)"
+//       options   : options of method hregress, e.g. "family=poisson"
+//       path      : directory with subdirectories 'temp' and 'output', only
+//                   used for checking the (default) file paths, no results
+//                   are stored there
+//       names, labels, summaries, samples : results for each full
+//                   conditional (see superbayesreg::get_results)
+//       log       : screen output of the run
+//       returns true, if an error occured
+
+bool __EXPORT_TYPE run_inprocess(const vector<ST::string> & varnames,
+                                 const vector<const double *> & columns,
+                                 const unsigned & nrobs,
+                                 const ST::string & model,
+                                 const ST::string & options,
+                                 const ST::string & path,
+                                 vector<ST::string> & names,
+                                 vector< vector<ST::string> > & labels,
+                                 vector<datamatrix> & summaries,
+                                 vector<datamatrix> & samples,
+                                 ST::string & log);
+
+#endif
@@ -0,0 +1,340 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+#include"linalg.h"
+#include<vector>
+#include<cstddef>
+
+#if defined(INCLUDE_BLAS)
+
+// BLAS/LAPACK routines (Fortran calling convention, hidden string lengths
+// at the end)
+
+extern "C"
+{
+void dgemm_(const char * transa,const char * transb,const int * m,
+            const int * n,const int * k,const double * alpha,const double * a,
+            const int * lda,const double * b,const int * ldb,
+            const double * beta,double * c,const int * ldc,size_t,size_t);
+
+void dtrsv_(const char * uplo,const char * trans,const char * diag,
+            const int * n,const double * a,const int * lda,double * x,
+            const int * incx,size_t,size_t,size_t);
+
+void dgetrf_(const int * m,const int * n,double * a,const int * lda,
+             int * ipiv,int * info);
+
+void dgetri_(const int * n,double * a,const int * lda,const int * ipiv,
+             double * work,const int * lwork,int * info);
+
+void dpotrf_(const char * uplo,const int * n,double * a,const int * lda,
+             int * info,size_t);
+
+void dpotri_(const char * uplo,const int * n,double * a,const int * lda,
+             int * info,size_t);
+
+void dsyev_(const char * jobz,const char * uplo,const int * n,double * a,
+            const int * lda,double * w,double * work,const int * lwork,
+            int * info,size_t,size_t);
+}
+
+#endif
+
+
+namespace linalg
+{
+
+using std::vector;
+
+// FUNCTION: mult_blocked
+// TASK: cache blocked version of C = C + A*B, for each element of C the
+//       products are summed up in the order k=0,1,... Rows of B are
+//       traversed contiguously.
+
+static void mult_blocked(const double * A,const double * B,double * C,
+                         const unsigned & m,const unsigned & k,
+                         const unsigned & n)
+  {
+  const unsigned kblock = 128;
+  const unsigned nblock = 512;
+
+  unsigned i,l,j,l0,j0,lend,jlen;
+  const double * a;
+  const double * b;
+  double * c;
+
+  for (j0=0;j0<n;j0+=nblock)
+    {
+    jlen = (n-j0 < nblock) ? n-j0 : nblock;
+    for (l0=0;l0<k;l0+=kblock)
+      {
+      lend = (k-l0 < kblock) ? k : l0+kblock;
+      for (i=0;i<m;i++)
+        {
+        a = A+i*k+l0;
+        for (l=l0;l<lend;l++,a++)
+          {
+          if (*a == 0)
+            continue;
+          b = B+l*n+j0;
+          c = C+i*n+j0;
+          for (j=0;j<jlen;j++,b++,c++)
+            *c += *a * *b;
+          }
+        }
+      }
+    }
+  }
+
+
+bool mult(const double * A,const double * B,double * C,
+          const unsigned & m,const unsigned & k,const unsigned & n,
+          const bool & add)
+  {
+
+  if ((m == 0) || (n == 0))
+    return true;
+
+  unsigned i;
+  if (add == false)
+    {
+    double * c = C;
+    for (i=0;i<m*n;i++,c++)
+      *c = 0;
+    }
+
+  if (k == 0)
+    return true;
+
+#if defined(INCLUDE_BLAS)
+
+  // small products are not worth the call overhead
+
+  if (double(m)*double(n)*double(k) >= 4096)
+    {
+    // row major C = A*B is column major C' = B'*A'
+
+    int mi = n;
+    int ni = m;
+    int ki = k;
+    double one = 1;
+    dgemm_("N","N",&mi,&ni,&ki,&one,B,&mi,A,&ki,&one,C,&mi,1,1);
+    return true;
+    }
+
+#endif
+
+  mult_blocked(A,B,C,m,k,n);
+
+  return true;
+  }
+
+
+#if defined(INCLUDE_BLAS)
+
+// a symmetric row major matrix equals its column major representation,
+// the lower triangle of a row major matrix is the upper triangle of the
+// column major one
+
+bool inverse(double * A,const unsigned & n)
+  {
+  if (n == 0)
+    return false;
+  int ni = n;
+  int info;
+  vector<int> ipiv(n);
+
+  // A' is inverted, (A')^(-1) = (A^(-1))'
+
+  dgetrf_(&ni,&ni,A,&ni,&ipiv[0],&info);
+  if (info != 0)
+    return false;
+
+  int lwork = -1;
+  double wsize;
+  dgetri_(&ni,A,&ni,&ipiv[0],&wsize,&lwork,&info);
+  lwork = int(wsize);
+  if (lwork < ni)
+    lwork = ni;
+  vector<double> work(lwork);
+  dgetri_(&ni,A,&ni,&ipiv[0],&work[0],&lwork,&info);
+
+  return info == 0;
+  }
+
+
+bool inverse_spd(double * A,const unsigned & n)
+  {
+  if (n == 0)
+    return false;
+  int ni = n;
+  int info;
+
+  vector<double> save(A,A+n*n);
+
+  dpotrf_("U",&ni,A,&ni,&info,1);
+  if (info == 0)
+    dpotri_("U",&ni,A,&ni,&info,1);
+
+  if (info != 0)
+    {
+    for (unsigned i=0;i<n*n;i++)
+      A[i] = save[i];
+    return false;
+    }
+
+  // complete the lower triangle (row major) from the upper one
+
+  unsigned i,j;
+  for (i=0;i<n;i++)
+    for (j=i+1;j<n;j++)
+      A[j*n+i] = A[i*n+j];
+
+  return true;
+  }
+
+
+bool cholesky(double * A,const unsigned & n)
+  {
+  if (n == 0)
+    return false;
+  int ni = n;
+  int info;
+
+  vector<double> save(A,A+n*n);
+
+  // upper triangle of the column major representation = lower triangle of
+  // the row major one
+
+  dpotrf_("U",&ni,A,&ni,&info,1);
+
+  if (info != 0)
+    {
+    for (unsigned i=0;i<n*n;i++)
+      A[i] = save[i];
+    return false;
+    }
+
+  unsigned i,j;
+  for (i=0;i<n;i++)
+    for (j=i+1;j<n;j++)
+      A[i*n+j] = 0;
+
+  return true;
+  }
+
+
+bool solve_lower(const double * L,double * b,const unsigned & n,
+                 const bool & trans)
+  {
+  if (n == 0)
+    return true;
+  int ni = n;
+  int inc = 1;
+
+  // the row major L is the column major upper triangular matrix L'
+
+  if (trans)
+    dtrsv_("U","N","N",&ni,L,&ni,b,&inc,1,1,1);
+  else
+    dtrsv_("U","T","N",&ni,L,&ni,b,&inc,1,1,1);
+
+  return true;
+  }
+
+
+bool eigen_sym(double * A,double * d,const unsigned & n)
+  {
+  if (n == 0)
+    return false;
+  int ni = n;
+  int info;
+
+  vector<double> save(A,A+n*n);
+
+  int lwork = -1;
+  double wsize;
+  dsyev_("V","U",&ni,A,&ni,d,&wsize,&lwork,&info,1,1);
+  lwork = int(wsize);
+  if (lwork < 3*ni)
+    lwork = 3*ni;
+  vector<double> work(lwork);
+  dsyev_("V","U",&ni,A,&ni,d,&work[0],&lwork,&info,1,1);
+
+  if (info != 0)
+    {
+    for (unsigned i=0;i<n*n;i++)
+      A[i] = save[i];
+    return false;
+    }
+
+  // eigenvectors are the columns of the column major result, i.e. the rows
+  // of A
+
+  unsigned i,j;
+  double h;
+  for (i=0;i<n;i++)
+    for (j=i+1;j<n;j++)
+      {
+      h = A[i*n+j];
+      A[i*n+j] = A[j*n+i];
+      A[j*n+i] = h;
+      }
+
+  return true;
+  }
+
+#else
+
+bool inverse(double * A,const unsigned & n)
+  {
+  return false;
+  }
+
+
+bool inverse_spd(double * A,const unsigned & n)
+  {
+  return false;
+  }
+
+
+bool cholesky(double * A,const unsigned & n)
+  {
+  return false;
+  }
+
+
+bool solve_lower(const double * L,double * b,const unsigned & n,
+                 const bool & trans)
+  {
+  return false;
+  }
+
+
+bool eigen_sym(double * A,double * d,const unsigned & n)
+  {
+  return false;
+  }
+
+#endif
+
+} // end: namespace linalg
+
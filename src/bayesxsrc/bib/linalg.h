@@ -0,0 +1,121 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+#if !defined (LINALG_INCLUDED)
+
+#define LINALG_INCLUDED
+
+#include"../export_type.h"
+
+//------------------------------------------------------------------------------
+//-------------------------- namespace linalg ----------------------------------
+//------------------------------------------------------------------------------
+
+// Dense kernels used by statmatrix, Matrix and PreMatrix. All matrices are
+// stored row by row. The template versions are used for element types
+// without kernel and return false, i.e. the caller uses its own algorithm.
+// For double:
+// - if compiled with INCLUDE_BLAS (opt-in, see BLASFLAGS in ../Makefile)
+//   the BLAS/LAPACK libraries R is linked against are used
+// - otherwise (default) 'mult' uses a cache blocked loop (same order of summation as
+//   the original loops, i.e. identical results), all other functions
+//   return false
+
+namespace linalg
+{
+
+// FUNCTION: mult
+// TASK: C = A*B (add=false) or C = C + A*B (add=true), A is m x k, B is
+//       k x n, returns false if no kernel is available
+
+template<class T>
+bool mult(const T * A,const T * B,T * C,const unsigned & m,
+          const unsigned & k,const unsigned & n,const bool & add)
+  {
+  return false;
+  }
+
+bool __EXPORT_TYPE mult(const double * A,const double * B,double * C,
+                        const unsigned & m,const unsigned & k,
+                        const unsigned & n,const bool & add);
+
+// FUNCTION: inverse
+// TASK: replaces the n x n matrix A by its inverse (LU decomposition),
+//       returns false if no kernel is available or A is singular
+
+template<class T>
+bool inverse(T * A,const unsigned & n)
+  {
+  return false;
+  }
+
+bool __EXPORT_TYPE inverse(double * A,const unsigned & n);
+
+// FUNCTION: inverse_spd
+// TASK: replaces the symmetric positive definite n x n matrix A by its
+//       inverse (Cholesky decomposition), returns false if no kernel is
+//       available or A is not positive definite
+
+template<class T>
+bool inverse_spd(T * A,const unsigned & n)
+  {
+  return false;
+  }
+
+bool __EXPORT_TYPE inverse_spd(double * A,const unsigned & n);
+
+// FUNCTION: cholesky
+// TASK: replaces the symmetric positive definite n x n matrix A by its
+//       lower triangular Cholesky root L (A = L*L'), the upper triangle is
+//       set to zero. Returns false if no kernel is available or A is not
+//       positive definite
+
+template<class T>
+bool cholesky(T * A,const unsigned & n)
+  {
+  return false;
+  }
+
+bool __EXPORT_TYPE cholesky(double * A,const unsigned & n);
+
+// FUNCTION: solve_lower
+// TASK: solves L*x = b (trans=false) or L'*x = b (trans=true) for the lower
+//       triangular n x n matrix L, b is overwritten by x. Returns false if
+//       no kernel is available
+
+template<class T>
+bool solve_lower(const T * L,T * b,const unsigned & n,const bool & trans)
+  {
+  return false;
+  }
+
+bool __EXPORT_TYPE solve_lower(const double * L,double * b,
+                               const unsigned & n,const bool & trans);
+
+// FUNCTION: eigen_sym
+// TASK: computes the eigenvalues d and eigenvectors (columns of A) of the
+//       symmetric n x n matrix A, returns false if no kernel is available
+//       or the algorithm did not converge
+
+bool __EXPORT_TYPE eigen_sym(double * A,double * d,const unsigned & n);
+
+} // end: namespace linalg
+
+#endif
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #endif
 
 #include "statmat.h"
+#include "linalg.h"
 
 #include <fstream>
 
@@ -88,6 +89,16 @@ const statmatrix<T> & statmatrix<T>::operator=(const SparseMatrix & m)
 template<class T>
 void statmatrix<T>::solveroot_t(const statmatrix & b,statmatrix & x)
   {
+  if (this->rows() > 0)
+    {
+    T * xp = x.getV();
+    T * bp = b.getV();
+    for (unsigned k=0;k<this->rows();k++,xp++,bp++)
+      *xp = *bp;
+    if (linalg::solve_lower(this->getV(),x.getV(),this->rows(),true))
+      return;
+    }
+
   int i,j;
   T h;
   T * xp;
@@ -112,6 +123,19 @@ template<class T>
 void statmatrix<T>::solveroot(const statmatrix & b,statmatrix & help,
                               statmatrix & x)
   {
+  if (this->rows() > 0)
+    {
+    T * hp = help.getV();
+    T * bp = b.getV();
+    for (unsigned k=0;k<this->rows();k++,hp++,bp++)
+      *hp = *bp;
+    if (linalg::solve_lower(this->getV(),help.getV(),this->rows(),false))
+      {
+      solveroot_t(help,x);
+      return;
+      }
+    }
+
   int i,j;
   T h;
   T * mr;
@@ -238,6 +262,10 @@ void statmatrix<T>::mult(const statmatrix & A,const statmatrix & B)
   assert(this->rows() == A.rows());
   assert(this->cols() == B.cols());
 
+  if (linalg::mult(A.getV(),B.getV(),this->getV(),A.rows(),A.cols(),
+                   B.cols(),false))
+    return;
+
   T * workA;
   T * workB;
   T * workR = this->getV();
@@ -260,6 +288,114 @@ void statmatrix<T>::mult(const statmatrix & A,const statmatrix & B)
   }
 
 
+template<class T>
+void statmatrix<T>::mult(const statmatrix_block<T> & A,
+                         const statmatrix_block<T> & B,const T & alpha)
+  {
+
+  unsigned i;
+  T * workR = this->getV();
+  unsigned size = this->rows()*this->cols();
+  for (i=0;i<size;i++,workR++)
+    *workR = T(0);
+
+  addmult(A,B,alpha);
+  }
+
+
+template<class T>
+void statmatrix<T>::addmult(const statmatrix_block<T> & A,
+                            const statmatrix_block<T> & B,const T & alpha)
+  {
+
+  assert(A.cols() == B.rows());
+  assert(this->rows() == A.rows());
+  assert(this->cols() == B.cols());
+
+  unsigned n = this->cols();
+  unsigned i,k,j;
+  T a;
+  const T * workA;
+  const T * workB;
+  T * workR;
+
+  // i-k-j order: rows of B and of the result are traversed contiguously
+
+  for (i=0;i<A.rows();i++)
+    {
+    workA = A.getrow(i);
+    for (k=0;k<A.cols();k++,workA++)
+      {
+      if (*workA != T(0))
+        {
+        a = alpha * *workA;
+        workB = B.getrow(k);
+        workR = this->getV()+i*n;
+        for (j=0;j<n;j++,workB++,workR++)
+          *workR += a * *workB;
+        }
+      }
+    }
+
+  }
+
+
+template<class T>
+statmatrix_block<T> statmatrix<T>::getBlockview(unsigned rl,unsigned cl,
+                                                unsigned ru,unsigned cu) const
+  {
+  return statmatrix_block<T>(*this,rl,cl,ru,cu);
+  }
+
+
+template<class T>
+statmatrix_block<T> statmatrix<T>::getRowBlockview(unsigned rl,
+                                                   unsigned ru) const
+  {
+  return statmatrix_block<T>(*this,rl,0,ru,this->cols());
+  }
+
+
+template<class T>
+statmatrix_block<T> statmatrix<T>::getColBlockview(unsigned cl,
+                                                   unsigned cu) const
+  {
+  return statmatrix_block<T>(*this,0,cl,this->rows(),cu);
+  }
+
+
+template<class T>
+T statmatrix_block<T>::trace(void) const
+  {
+  assert(nrrows == nrcols);
+  T t = T(0);
+  unsigned i;
+  for (i=0;i<nrrows;i++)
+    t += v[i*stride+i];
+  return t;
+  }
+
+
+template<class T>
+T tracemult(const statmatrix_block<T> & A,const statmatrix_block<T> & B)
+  {
+
+  assert(A.cols() == B.rows());
+  assert(A.rows() == B.cols());
+
+  T t = T(0);
+  unsigned i,k;
+  const T * workA;
+  for (i=0;i<A.rows();i++)
+    {
+    workA = A.getrow(i);
+    for (k=0;k<A.cols();k++,workA++)
+      t += *workA * B(k,i);
+    }
+  return t;
+  }
+
+
 template<class T>
 void statmatrix<T>::mult_scalar(const statmatrix & A, const T & b)
   {
@@ -289,6 +425,10 @@ void statmatrix<T>::addmult(const statmatrix & A,const statmatrix & B)
   assert(this->rows() == A.rows());
   assert(this->cols() == B.cols());
 
+  if (linalg::mult(A.getV(),B.getV(),this->getV(),A.rows(),A.cols(),
+                   B.cols(),true))
+    return;
+
   T * workA;
   T * workB;
   T * workR = this->getV();
@@ -351,28 +491,60 @@ template<class T>
 statmatrix<T> statmatrix<T>::inverse(void)
   {
   assert(this->rows()==this->cols());
-  if (this->rows() == 1)
+  if (this->rows() <= 2)
+    {
+    statmatrix<T> result(this->rows(),this->rows());
+    result.assigninverse(*this);
+    return result;
+    }
+  else
+    return Matrix<T>::inverse();
+  }
+
+
+template<class T>
+void statmatrix<T>::assigninverse(const statmatrix & A)
+  {
+  assert(A.rows()==A.cols());
+  if (A.rows() > 2)
     {
-    assert( *getV() != T(0) );
-    return statmatrix<T>(1,1,T(1)/(*getV()));
+    *this = statmatrix<T>(A.Matrix<T>::inverse());
+    return;
     }
-  else if (this->rows()==2)
+  if ((this->rows() != A.rows()) || (this->cols() != A.cols()))
+    *this = statmatrix<T>(A.rows(),A.rows());
+  T* work = getV();
+  if (A.rows() == 1)
     {
-    T det = this->get(0,0)*this->get(1,1)-this->get(0,1)*this->get(1,0);
+    assert( *A.getV() != T(0) );
+    *work = T(1)/(*A.getV());
+    }
+  else if (A.rows()==2)
+    {
+    T det = A.get(0,0)*A.get(1,1)-A.get(0,1)*A.get(1,0);
     assert(det !=  T(0));
-    statmatrix<T> result(2,2);
-    T* work = result.getV();
-    *work =  this->get(1,1)/det;                 // result(0,0)
+    *work =  A.get(1,1)/det;                     // result(0,0)
     work++;
-    *work =  -this->get(0,1)/det;                // result(0,1)
+    *work =  -A.get(0,1)/det;                    // result(0,1)
     work++;
-    *work =  -this->get(1,0)/det;                // result(1,0)
+    *work =  -A.get(1,0)/det;                    // result(1,0)
     work++;
-    *work =  this->get(0,0)/det;                 // result(0,0)
-    return result;
+    *work =  A.get(0,0)/det;                     // result(0,0)
     }
-  else
-    return Matrix<T>::inverse();
+  }
+
+
+template<class T>
+void statmatrix<T>::assignroot(const statmatrix & A)
+  {
+  if ((this->rows() == A.rows()) && (this->cols() == A.cols()) &&
+      (A.rows() == A.cols()) && (A.rows() > 0))
+    {
+    assign(A);
+    if (this->rootinplace())
+      return;
+    }
+  *this = A.root();
   }
 
 template<class T>
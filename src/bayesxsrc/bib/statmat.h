@@ -34,6 +34,8 @@ using std::vector;
 //---------------------------- CLASS: statmatrix -------------------------------
 //------------------------------------------------------------------------------
 
+template <class T> class statmatrix_block;
+
 #if !defined(__BUILDING_GNU)
 class SparseMatrix;
 
@@ -110,6 +112,20 @@ class adja;
 
   void assign(const statmatrix & A);
 
+  // FUNCTION: assignroot
+  // TASK: assigns the Cholesky root of A (see Matrix::root) to the calling
+  //       matrix, the storage of the calling matrix is reused if the
+  //       dimensions agree
+
+  void assignroot(const statmatrix & A);
+
+  // FUNCTION: assigninverse
+  // TASK: assigns the inverse of A (see inverse) to the calling matrix,
+  //       for 1x1 and 2x2 matrices the storage of the calling matrix is
+  //       reused if the dimensions agree
+
+  void assigninverse(const statmatrix & A);
+
   // FUNCTION: plus
   // TASK: assigns A+B to the calling matrix
   //       faster than C = A+B
@@ -144,6 +160,21 @@ class adja;
 
   void mult(const statmatrix & A,const statmatrix & B);
 
+  // FUNCTION: mult
+  // TASK: assigns alpha*A*B to the calling matrix, A and B may be blocks of
+  //       other matrices (see getBlockview), no temporaries are created.
+  //       The calling matrix must not share memory with A or B
+
+  void mult(const statmatrix_block<T> & A,const statmatrix_block<T> & B,
+            const T & alpha=T(1));
+
+  // FUNCTION: addmult
+  // TASK: computes alpha*A*B and adds the result to the calling matrix,
+  //       A and B may be blocks of other matrices (see getBlockview)
+
+  void addmult(const statmatrix_block<T> & A,const statmatrix_block<T> & B,
+               const T & alpha=T(1));
+
   // FUNCTION: mult_scalar
   // TASK: multiplies b*A and assigns the result to the calling matrix
 
@@ -444,6 +475,18 @@ class adja;
 
   T compute_quadform(const statmatrix<T> & x,const unsigned & c=0);
 
+  // FUNCTION: getBlockview, getRowBlockview, getColBlockview
+  // TASK: same as getBlock, getRowBlock and getColBlock but return
+  //       non-owning views instead of copies. A view is valid as long as the
+  //       calling matrix is neither destroyed nor reassigned
+
+  statmatrix_block<T> getBlockview(unsigned rl,unsigned cl,unsigned ru,
+                                   unsigned cu) const;
+
+  statmatrix_block<T> getRowBlockview(unsigned rl,unsigned ru) const;
+
+  statmatrix_block<T> getColBlockview(unsigned cl,unsigned cu) const;
+
   	//	Datenzeiger zugreifbar
 
   T *getV() const { return this->m_v; }
@@ -473,6 +516,82 @@ class adja;
 
   };
 
+//------------------------------------------------------------------------------
+//------------------------- CLASS: statmatrix_block ----------------------------
+//------------------------------------------------------------------------------
+
+// non-owning view of a rectangular block of a statmatrix, element (i,j) of
+// the block is stored at v[i*stride+j]
+
+template <class T>
+class statmatrix_block
+
+  {
+
+  protected:
+
+  const T * v;
+  unsigned nrrows;
+  unsigned nrcols;
+  unsigned stride;
+
+  public:
+
+  // CONSTRUCTOR 1
+  // TASK: view of the complete matrix A
+
+  statmatrix_block(const statmatrix<T> & A)
+    : v(A.getV()), nrrows(A.rows()), nrcols(A.cols()), stride(A.cols()) {}
+
+  // CONSTRUCTOR 2
+  // TASK: view of rows rl,...,ru-1 and columns cl,...,cu-1 of A
+
+  statmatrix_block(const statmatrix<T> & A,unsigned rl,unsigned cl,
+                   unsigned ru,unsigned cu)
+    : v(A.getV()+rl*A.cols()+cl), nrrows(ru-rl), nrcols(cu-cl),
+      stride(A.cols())
+    {
+    assert(rl < ru && ru <= A.rows());
+    assert(cl < cu && cu <= A.cols());
+    }
+
+  unsigned rows(void) const
+    {
+    return nrrows;
+    }
+
+  unsigned cols(void) const
+    {
+    return nrcols;
+    }
+
+  // FUNCTION: getrow
+  // TASK: returns a pointer to the first element of row i
+
+  const T * getrow(const unsigned & i) const
+    {
+    return v+i*stride;
+    }
+
+  const T & operator()(const unsigned & i,const unsigned & j) const
+    {
+    return v[i*stride+j];
+    }
+
+  // FUNCTION: trace
+  // TASK: returns the trace of the (square) block
+
+  T trace(void) const;
+
+  };
+
+
+// FUNCTION: tracemult
+// TASK: returns trace(A*B) without computing the product A*B
+
+template <class T>
+T tracemult(const statmatrix_block<T> & A,const statmatrix_block<T> & B);
+
 typedef statmatrix<double> datamatrix;
 
 // FUNCTION: multdiagback
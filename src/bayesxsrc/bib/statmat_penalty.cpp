@@ -818,6 +818,8 @@ int eigen(statmatrix<double> & a, statmatrix<double> & values,
 
 bool eigen2(datamatrix & a, datamatrix & d)
   {
+  if (linalg::eigen_sym(a.getV(),d.getV(),a.rows()))
+    return true;
   datamatrix e(d.rows(),1,0);
   tridiag(a,d,e);
   return eigentridiag(d,e,a);
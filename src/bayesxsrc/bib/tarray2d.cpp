@@ -47,7 +47,6 @@ Array2D(unsigned rows, unsigned cols, const T init)
 {
 	m_rows = rows;
 	m_cols = cols;
-	m_row = new T*[ m_rows ];
 	create();
 	if (m_v)
 	{
@@ -74,7 +73,6 @@ Array2D(const Array2D<T> &init)
 {
 	m_rows = init.m_rows;
 	m_cols = init.m_cols;
-	m_row = new T*[ m_rows ];
 	create();
 	if (m_v)
 		copyContents(init);
@@ -98,10 +96,20 @@ const Array2D<T> &
 Array2D<T>::
 operator=(const Array2D<T> &from)
 {
+	if (this == &from)
+		return *this;
+
+	//	Bei gleicher Dimension wird der vorhandene Speicher verwendet
+
+	if (m_v && m_rows == from.m_rows && m_cols == from.m_cols)
+	{
+		copyContents(from);
+		return *this;
+	}
+
 	discard();
 	m_rows = from.m_rows;
 	m_cols = from.m_cols;
-	m_row = new T*[ m_rows ];
 	create();
 	if (m_v)
 		copyContents(from);
@@ -421,12 +429,16 @@ void Array2D<T>::create()
 	if (m_rows == 0 || m_cols == 0)
 	{
 		m_v = 0;
+		m_row = 0;
 		m_rows = 0;
 		m_cols = 0;
 	}
 	else
 	{
 		unsigned size = m_rows * m_cols;
+#if defined(COUNT_ALLOCATIONS)
+		scratch::nrheapallocations++;
+#endif
 		m_v = new T[ size ];
 		if (m_v)
 		{
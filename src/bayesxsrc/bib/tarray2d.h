@@ -27,6 +27,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <iostream>
 #include <limits.h>
 #include <assert.h>
+#if defined(COUNT_ALLOCATIONS)
+#include "arena.h"
+#endif
 // #include <bool.h>
 
 using std::istream;
@@ -36,6 +36,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "tmatrix.h"
 #include "tlinklst.h"
 #include "tarray.h"
+#include "linalg.h"
 
 //#include <strstream>
 #include <string.h>
@@ -55,6 +56,24 @@ root() const
    if (!result)
       return result;
 
+   if (!result.rootinplace())
+      return Matrix<T>(0);
+
+   return result;
+}
+
+
+template <class T>
+bool
+Matrix<T>::
+rootinplace()
+{
+   unsigned n = this->rows( );
+   Matrix<T> & result = *this;
+
+   if ((n > 1) && linalg::cholesky(result.getV(),n))
+      return true;
+
    if (n == 1)
       {
       T x = this->get(0, 0);
@@ -64,7 +83,7 @@ root() const
       else if (x == T(0))
 	 result(0, 0) = T(0);
       else
-	 return Matrix<T>( 0 );
+	 return false;
       }
    else
       {
@@ -83,7 +102,7 @@ root() const
 	    sum -= r * r;
 	    }
 	 if (sum <= T(0))
-	    return Matrix<T>(0);
+	    return false;
 	 result(i, i) =  T(sqrt(sum));
 	 for (j = i + 1; j < n; j++)
 	    {
@@ -96,7 +115,7 @@ root() const
 	    }
 	 }
       }
-   return result;
+   return true;
 }
 
 
@@ -184,6 +203,12 @@ cinverse() const
       return Matrix<T>( 1, 1, T(1) / v );
       }
 
+      {
+      Matrix<T> Inv(*this);
+      if (linalg::inverse_spd(Inv.getV(),this->rows()))
+         return Inv;
+      }
+
    Matrix<T> CH = decompCholesky();
    if (!CH)
       return Matrix<T>(0);
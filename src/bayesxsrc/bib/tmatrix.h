@@ -123,6 +123,8 @@ public :
    // transposed - Transponieren
    // sscp - SSCP-Matrix
    // root - Choleskyzerlegung
+   // rootinplace - Choleskyzerlegung ohne Kopie, ueberschreibt die Matrix
+   //               (false, falls die Matrix nicht positiv definit ist)
 
    Matrix kronecker(const Matrix &m) const
       { Matrix<T> res; PreMatrix<T>::kronecker(m).purge(res); return res; }
@@ -180,6 +182,7 @@ public :
 
    Matrix cinverse() const;
    Matrix root () const;
+   bool rootinplace ();
 
    Matrix vcat(const Matrix &bottom) const
 	   { Matrix<T> res; PreMatrix<T>::vcat(bottom).purge(res); return res; }
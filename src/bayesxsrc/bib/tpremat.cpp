@@ -40,6 +40,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #endif
 
 #include "tlinklst.h"
+#include "linalg.h"
 #include "tarray.h"
 #include <math.h>
 #include <limits.h>
@@ -286,6 +287,12 @@ PreMatrix<T> PreMatrix<T>::operator*( const PreMatrix<T> &m ) const
 
 #else
 
+	// BLAS bzw. blockweise Multiplikation (siehe linalg.h)
+
+	if (linalg::mult(this->getV(),m.getV(),result.getV(),this->rows(),
+	                 this->cols(),m.cols(),false))
+		return result;
+
 	// Schnelle NonRealMatrixmultiplikation
 
 	// Ergebnis-Zeiger
@@ -1330,6 +1337,12 @@ luinverse() const
     return PreMatrix<T>( 1, 1, T( T(1) / v ) );
     }
 
+    {
+    PreMatrix<T> Inv( *this );
+    if ( linalg::inverse( Inv.getV( ), this->rows( ) ) )
+      return Inv;
+    }
+
   PreMatrix<T> Inverse( this->rows( ), this->cols( ) );
   if ( !Inverse )
     return PreMatrix<T>( 0 );
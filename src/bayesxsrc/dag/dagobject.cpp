@@ -132,6 +132,7 @@ void estimaterun(dagobject & d)
 
 	unsigned ty = d.typ.getvalue();					// rj: type of the adjacency matrix to start with
 	unsigned int number = d.number.getvalue();		// rj: number of dags/models in the output
+	unsigned int moves = d.moves.getvalue();		// rj: maximal number of moves per iteration
 
 	bool print_dags = d.print_dags.getvalue();		// dag: detailed output about the regression models
 	bool detail_ia = d.detail_ia.getvalue();		    // dag: detailed output about the interactions
@@ -353,6 +354,12 @@ void estimaterun(dagobject & d)
     FULLCOND_rj_int RJ_ia;
     FULLCOND_rj_mix RJ_mix;
 
+    if (moves > 1 && (family == "discrete_ia" || mixed_case==true))
+    {
+        d.out("WARNING: option 'moves' is ignored for families discrete_ia and mixed,\n"
+              "         one move per iteration is made.\n");
+    }
+
 	vector<FULLCOND *> fc;
 
     if (family != "discrete_ia" && mixed_case==false)        // no interactions, discrete or continuous
@@ -360,6 +367,7 @@ void estimaterun(dagobject & d)
          RJ = FULLCOND_rj (fix_file, res_file, number, alpha, switch_typ, print_models, ty,dagp,
                                             &mopt,D,"dag_rj",D.cols(),D.cols(),path);
          RJ.setflags(MCMC::norelchange);
+         RJ.set_moves(moves);
          fc.push_back(&RJ);
          for (cc=0, dd=0,i=0;i<D.cols();i++)
          {
@@ -437,6 +445,7 @@ void dagobject::create(void)
 	iterationsprint = intoption("printit",100,1,100000000);
 	typ				= intoption("type",0,0,4);
 	number			= intoption("number",10,0,10000);
+	moves			= intoption("moves",1,1,10000);
 
 	alpha	= doubleoption("alpha",0.05,0,1);
 	value_a = doubleoption("delta",1,0,20);
@@ -483,6 +492,7 @@ void dagobject::create(void)
 	estimateoptions.push_back(&print_models);
 	estimateoptions.push_back(&switch_typ);
 	estimateoptions.push_back(&number);
+	estimateoptions.push_back(&moves);
 	estimateoptions.push_back(&alpha);
 	estimateoptions.push_back(&print_dags);
 	estimateoptions.push_back(&res_file);
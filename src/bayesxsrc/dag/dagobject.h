@@ -94,6 +94,7 @@ class __EXPORT_TYPE dagobject : public statobject
   intoption iterationsprint;
   intoption typ;
   intoption number;
+  intoption moves;			// rj: maximal number of moves per iteration
 
   stroption prior_sig;		// dag: variance of prior
   stroption res_file;		// rj: path for aggregated results
@@ -448,6 +448,25 @@ void FULLCOND_dag::calc_Sigma (void)
 
 		workbeta_mean = beta_mean.getV();
 
+		// x'y is taken from the cross products of the data if available
+		// (summed up in the same order)
+
+		bool cross = has_crossproducts() && (ncoef == ncoef_m);
+		vector<unsigned> xyindex;
+
+		if(cross)
+		{
+			xyindex = vector<unsigned>(ncoef,0);
+			for(i=0,k=1; i<nvar; i++)
+			{
+				if(adcol(i,0)==1)
+				{
+					xyindex[k] = i+1;
+					k++;
+				}
+			}
+		}
+
 		if(priori_beta == "non_inf")
 		{
 			// beta_mean = SIGMA * X'y; SIGMA = inv(X'X)
@@ -459,13 +478,18 @@ void FULLCOND_dag::calc_Sigma (void)
 				sum1 = 0;
 				for(i=0; i<ncoef; i++)
 				{
-					workx = x.getV()+i;
-					sum2 = 0;
-					worky = y.getV();
-					for(j=0; j<nobs; j++, worky++)
+					if(cross)
+						sum2 = xydata(xyindex[i],0);
+					else
 					{
-						sum2 = sum2 + (*workx) * (*worky);
-						workx = workx + ncoef;
+						workx = x.getV()+i;
+						sum2 = 0;
+						worky = y.getV();
+						for(j=0; j<nobs; j++, worky++)
+						{
+							sum2 = sum2 + (*workx) * (*worky);
+							workx = workx + ncoef;
+						}
 					}
 					sum1 = sum1 + (*worksigma) * sum2;
 					worksigma = worksigma + ncoef;
@@ -482,14 +506,19 @@ void FULLCOND_dag::calc_Sigma (void)
 				sum1 = 0;
 				for(i=0; i<ncoef; i++, worksigma++)
 				{
-					worky = y.getV();
-					workx = x.getV()+i;
-					sum2 = 0;
-
-					for(j=0; j<nobs; j++, worky++)
+					if(cross)
+						sum2 = xydata(xyindex[i],0);
+					else
 					{
-						sum2 = sum2 + (*workx) * (*worky);  // + sigma_i/alpha * I * b_i
-						workx = workx + ncoef;
+						worky = y.getV();
+						workx = x.getV()+i;
+						sum2 = 0;
+
+						for(j=0; j<nobs; j++, worky++)
+						{
+							sum2 = sum2 + (*workx) * (*worky);  // + sigma_i/alpha * I * b_i
+							workx = workx + ncoef;
+						}
 					}
 
 					sum1 = sum1 + (*worksigma) * sum2;
@@ -921,10 +950,13 @@ double FULLCOND_dag::calc_SQT_b(const datamatrix & b_n)
 								const datamatrix & xx_new, unsigned int ncoef_new)
    {
 
-	   lin.assign(lin_prop);
 	   beta_help = beta_help_new;
 
-	   x = x_new;
+	   if(has_crossproducts() == false)
+	   {
+		   lin.assign(lin_prop);
+		   x = x_new;
+	   }
 	   xx = xx_new;
 
 	   if(ncoef_new>ncoef)
@@ -938,6 +970,34 @@ double FULLCOND_dag::calc_SQT_b(const datamatrix & b_n)
        //ncoef_ia is changed in change_current
 
 	   ncoef = ncoef_new;
+
+	   if(has_crossproducts())
+	   {
+		   // proposals have been computed without x_new and lin_prop,
+		   // x and the linear predictor are built from the data
+
+		   unsigned m,k,l;
+		   double * workdata;
+		   double * workx;
+
+		   x = datamatrix(nobs,ncoef,1);
+
+		   l=1;
+		   for(m=0; m<nvar; m++)
+		   {
+			   if(adcol(m,0)==1)
+			   {
+				   workdata = data.getV()+m;
+				   workx = x.getV()+l;
+				   for(k=0; k<nobs; k++, workdata+=nvar, workx+=ncoef)
+					   *workx = *workdata;
+				   l++;
+			   }
+		   }
+
+		   calc_lin();
+	   }
+
 	   SQT_x = calc_SQT_x();
 	   SQT_b = calc_SQT_b();
 
@@ -1183,6 +1243,49 @@ void FULLCOND_dag::calc_lin_prop(const datamatrix & x_prop, const datamatrix & b
 
 
 
+	double FULLCOND_dag::calc_SQT_x_cross(const datamatrix & xx_n, const datamatrix & b_n,
+										unsigned int i, bool birth)
+	{
+		// y'y - 2b'x'y + b'x'xb
+
+		unsigned k,l,m;
+		unsigned nc = b_n.rows();
+
+		double * workb = b_n.getV();
+		double * workxx = xx_n.getV();
+		double xy = 0;
+		double xxb;
+		double bxxb = 0;
+
+		// x'y, column l of the proposed x corresponds to element m+1 of xydata
+
+		xy = (*workb) * xydata(0,0);
+		workb++;
+		for(m=0; m<nvar; m++)
+		{
+			if( (adcol(m,0)==1 && (birth || m!=i)) || (birth && m==i) )
+			{
+				xy = xy + (*workb) * xydata(m+1,0);
+				workb++;
+			}
+		}
+		assert(workb == b_n.getV()+nc);
+
+		for(k=0; k<nc; k++)
+		{
+			xxb = 0;
+			workb = b_n.getV();
+			for(l=0; l<nc; l++, workxx++, workb++)
+				xxb = xxb + (*workxx) * (*workb);
+			bxxb = bxxb + b_n(k,0)*xxb;
+		}
+
+		return xydata(self+1,0) - 2*xy + bxxb;
+	}
+
+
+
+
 	double FULLCOND_dag::calc_SQT_b(void)
 	{
 		unsigned i;
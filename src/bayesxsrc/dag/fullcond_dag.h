@@ -78,6 +78,11 @@ class __EXPORT_TYPE FULLCOND_dag : public FULLCOND
 	  double SQT_x_n;		// the new SQT_x for the proposed model
 	  double SQT_b_n;		// the new SQT_b for the proposed model
 
+	  datamatrix xydata;	// cross products of the intercept and of all
+							// variables with the response (element 0 and k+1),
+							// empty if the response is not fixed (see
+							// set_crossproducts)
+
 	  double a_invg;	// 1. parameter of the inv-gamma distribution of sigma_i
 	  double b_invg;	// 2. parameter of the inv-gamma distribution of sigma_i
 
@@ -167,6 +172,7 @@ class __EXPORT_TYPE FULLCOND_dag : public FULLCOND
 	  SQT_b = fc.SQT_b;
 	  SQT_x_n = fc.SQT_x_n;
 	  SQT_b_n = fc.SQT_b_n;
+	  xydata = fc.xydata;
 	  ncoef = fc.ncoef;
 	  ncoef_m = fc.ncoef_m;
 	  ncoef_ia = fc.ncoef_ia;
@@ -213,6 +219,7 @@ class __EXPORT_TYPE FULLCOND_dag : public FULLCOND
 	  SQT_b = fc.SQT_b;
 	  SQT_x_n = fc.SQT_x_n;
 	  SQT_b_n = fc.SQT_b_n;
+	  xydata = fc.xydata;
 	  ncoef= fc.ncoef;
       ncoef_m = fc.ncoef_m;
 	  ncoef_ia = fc.ncoef_ia;
@@ -820,6 +827,35 @@ class __EXPORT_TYPE FULLCOND_dag : public FULLCOND
 
 
 
+	// FUNCTION: set_crossproducts
+	// TASK: sets xydata, i.e. column self+1 of the cross products of the
+	// data. Afterwards proposals of birth and death steps are evaluated
+	// without the data (see calc_SQT_x_cross), the current x is rebuilt
+	// from the data in change.
+	void set_crossproducts(const datamatrix & xy)
+	{
+		xydata = xy;
+	}
+
+
+	// FUNCTION: has_crossproducts
+	// TASK: returns true if xydata is set
+	bool has_crossproducts(void) const
+	{
+		return xydata.rows() > 0;
+	}
+
+
+	// FUNCTION: calc_SQT_x_cross(xx_n, b_n, i, birth)
+	// TASK: calculates the SQT_x for the model with the parents of self
+	// plus (birth==true) or minus (birth==false) the variable i, xx_n and
+	// b_n are x'x and the coefficients of this model. Computed as
+	// y'y - 2b'x'y + b'x'xb from the cross products, i.e. independent of
+	// the number of observations.
+	double calc_SQT_x_cross(const datamatrix & xx_n, const datamatrix & b_n,
+							unsigned int i, bool birth);
+
+
 	// FUNCTION: calc_yXb(yy, XX, bb)
 	// TASK: calculates the (yy-Xxbb)'(yy-XXbb)
 	double calc_yXb(const datamatrix & yy, const datamatrix & XX,
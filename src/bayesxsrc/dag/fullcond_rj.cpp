@@ -55,6 +55,8 @@ namespace MCMC
 
 	set_options();
 
+	nrmoves = 1;
+
 	file_of_results = true;
 	path_res = "c:\\results.res";
 
@@ -89,6 +91,8 @@ FULLCOND_rj::FULLCOND_rj (vector < FULLCOND_dag * > dagp, MCMCoptions * o, const
 
 	mixed_case=false;
 
+	nrmoves = 1;
+
 	file_of_results = false;
 	path_res ="c:\\results.res";
 
@@ -134,6 +138,19 @@ FULLCOND_rj::FULLCOND_rj (ST::string fix, const ST::string & rp, unsigned int li
 
 	mixed_case=false;
 
+	nrmoves = 1;
+	ini_crossproducts();
+
+	// the response of Gaussian models is fixed, i.e. their proposals can be
+	// evaluated with the cross products of the data
+
+	unsigned j;
+	for(j=0; j<nvar; j++)
+	{
+		if(preg_mods[j]->get_family() == "Gaussian" && preg_mods[j]->get_ncoef_ia() == 0)
+			preg_mods[j]->set_crossproducts(xxdata.getCol(j+1));
+	}
+
 	file_of_results = true;
 	path_res =rp;
 
@@ -194,6 +211,9 @@ FULLCOND_rj::FULLCOND_rj (ST::string fix, const ST::string & rp, unsigned int li
 
 	  path_res = fc.path_res;
       family = fc.family;
+
+	  xxdata = fc.xxdata;
+	  nrmoves = fc.nrmoves;
   }
 
 
@@ -255,6 +275,9 @@ FULLCOND_rj::FULLCOND_rj (ST::string fix, const ST::string & rp, unsigned int li
 	  path_res = fc.path_res;
       family = fc.family;
 
+	  xxdata = fc.xxdata;
+	  nrmoves = fc.nrmoves;
+
 	  return *this;
   }
 
@@ -353,16 +376,46 @@ void FULLCOND_rj::birth_step(unsigned int v_i, unsigned int v_j)
 		// instead of: datamatrix x_new (nobs,ncoef_new);
 // Vorschlag:
 //		datamatrix & x_new = preg_mods[v_j]->get_x_new_b() ;
-		datamatrix x_new = preg_mods[v_j]->get_x_new_b() ;
+		// (not needed if the proposal is evaluated with the cross products)
+		datamatrix x_new;
+		if(preg_mods[v_j]->has_crossproducts() == false)
+			x_new = preg_mods[v_j]->get_x_new_b() ;
 		// instead of: datamatrix xx_new (ncoef_new,ncoef_new);
 // Vorschlag:
 //		datamatrix & xx_new = preg_mods[v_j]->get_xx_new_b() ;
 		datamatrix xx_new = preg_mods[v_j]->get_xx_new_b() ;
 
-		assert(ncoef_new==b_new.rows());
-
 		double beta_new = rand_normal(); //coefficient which will be added
 
+		// calculate ratio
+
+		double ratio = birth_ratio(v_i,v_j,beta_new,b_new,x_new,xx_new);
+
+
+		//accept proposal and change the corresponding values
+
+		if(func::accept(ratio) == true)
+			birth_accept(v_i,v_j,b_new,x_new,xx_new);
+
+		nrtrials_b ++;
+		step_aborted = false;
+
+	} // end of "if(azy_test(i,j)== true) ...."
+}
+
+
+
+
+// FUNCTION: birth_ratio
+// computes the proposal and the acceptance ratio of a birth-step
+
+double FULLCOND_rj::birth_ratio(unsigned int v_i, unsigned int v_j, double beta_new,
+					datamatrix & b_new, datamatrix & x_new, datamatrix & xx_new)
+{
+		unsigned int ncoef_new = preg_mods[v_j]->get_ncoef() + 1;
+
+		assert(ncoef_new==b_new.rows());
+
 		// computing of the new values
 		make_new_b("b", v_i,v_j,beta_new, xx_new,b_new, x_new);
 
@@ -373,17 +426,35 @@ void FULLCOND_rj::birth_step(unsigned int v_i, unsigned int v_j)
 		double log_num;
 		double ratio;
 
-		log_num = preg_mods[v_j]->calc_SQT_x(x_new, b_new) + preg_mods[v_j]->calc_SQT_b(b_new);
-		log_denom = preg_mods[v_j]->calc_SQT_x() +  preg_mods[v_j]->calc_SQT_b();
+		if(preg_mods[v_j]->has_crossproducts())
+		{
+			log_num = preg_mods[v_j]->calc_SQT_x_cross(xx_new, b_new, v_i, true)
+						+ preg_mods[v_j]->calc_SQT_b(b_new);
+			log_denom = preg_mods[v_j]->get_SQT_x() +  preg_mods[v_j]->calc_SQT_b();
+		}
+		else
+		{
+			log_num = preg_mods[v_j]->calc_SQT_x(x_new, b_new) + preg_mods[v_j]->calc_SQT_b(b_new);
+			log_denom = preg_mods[v_j]->calc_SQT_x() +  preg_mods[v_j]->calc_SQT_b();
+		}
 
 		ratio = -1/(2*preg_mods[v_j]->get_sigma_i())
 				*(log_num - log_denom) - p_prop(beta_new) ;
 
+		return ratio;
+}
 
-		//accept proposal and change the corresponding values
 
-		if(func::accept(ratio) == true)
-		{
+
+
+// FUNCTION: birth_accept
+// changes the current state according to an accepted birth-step
+
+void FULLCOND_rj::birth_accept(unsigned int v_i, unsigned int v_j, const datamatrix & b_new,
+					const datamatrix & x_new, const datamatrix & xx_new)
+{
+			unsigned int ncoef_new = preg_mods[v_j]->get_ncoef() + 1;
+
 			preg_mods[v_j]->change_adcol(v_i,1);
 			preg_mods[v_j]->change(v_i, b_new, x_new, xx_new, ncoef_new);
 
@@ -392,24 +463,6 @@ void FULLCOND_rj::birth_step(unsigned int v_i, unsigned int v_j)
 
 			zeta(v_i,v_j)=1;
 			zeta.change_list(v_i,v_j,0);
-
-			/*********************
-				unsigned k,l;
-				for(k=0; k<nvar; k++)
-				{
-					for(l=0; l<nvar; l++)
-						cout<<zeta(k,l)<<" ";
-					cout<<endl;
-				}
-				cout<<endl
-					<<endl;;
-			*********************/
-		}
-
-		nrtrials_b ++;
-		step_aborted = false;
-
-	} // end of "if(azy_test(i,j)== true) ...."
 }
 
 
@@ -423,15 +476,7 @@ void FULLCOND_rj::death_step(unsigned int v_i, unsigned int v_j)
 	if(mixed_case==true)
 				preg_mods[v_j]->create_matrices("d", ncoef_new);
 
-	// instead of: datamatrix b_new (ncoef_new,1);
-	datamatrix & b_new = preg_mods[v_j]->get_b_new_d();
-	// instead of: datamatrix x_new (nobs,ncoef_new);
-	datamatrix & x_new = preg_mods[v_j]->get_x_new_d();
-	// instead of: datamatrix xx_new (ncoef_new,ncoef_new);
-	datamatrix & xx_new = preg_mods[v_j]->get_xx_new_d();
-
-
-	if(b_new.rows() != ncoef_new)
+	if(preg_mods[v_j]->get_b_new_d().rows() != ncoef_new)
 	{
 		cout<<"main_effects: "<<preg_mods[v_j]->get_ncoef_m()<<endl;
 		cout<<"interactions: "<<preg_mods[v_j]->get_ncoef_ia()<<endl;
@@ -439,6 +484,39 @@ void FULLCOND_rj::death_step(unsigned int v_i, unsigned int v_j)
 	}
 
 
+	// calculate ratio
+
+    double ratio = death_ratio(v_i,v_j);
+
+
+	// accept proposal and change the corresponding values
+
+	if(func::accept(ratio) == true)
+	{
+		death_accept(v_i,v_j);
+	}
+
+	nrtrials_d ++;
+	step_aborted = false;
+}
+
+
+
+
+// FUNCTION: death_ratio
+// computes the proposal and the acceptance ratio of a death-step, the
+// proposed values are stored in b_new_d, x_new_d, xx_new_d of the
+// regression model v_j
+
+double FULLCOND_rj::death_ratio(unsigned int v_i, unsigned int v_j)
+{
+	// instead of: datamatrix b_new (ncoef_new,1);
+	datamatrix & b_new = preg_mods[v_j]->get_b_new_d();
+	// instead of: datamatrix x_new (nobs,ncoef_new);
+	datamatrix & x_new = preg_mods[v_j]->get_x_new_d();
+	// instead of: datamatrix xx_new (ncoef_new,ncoef_new);
+	datamatrix & xx_new = preg_mods[v_j]->get_xx_new_d();
+
 	double beta_old; //coefficient which will vanish
 
 	// computing of the new values
@@ -452,49 +530,195 @@ void FULLCOND_rj::death_step(unsigned int v_i, unsigned int v_j)
 	double log_num;
 	double log_denom;
 
-	log_num = preg_mods[v_j]->calc_SQT_x(x_new, b_new) + preg_mods[v_j]->calc_SQT_b(b_new);
-	log_denom = preg_mods[v_j]->calc_SQT_x() + preg_mods[v_j]->calc_SQT_b();
+	if(preg_mods[v_j]->has_crossproducts())
+	{
+		log_num = preg_mods[v_j]->calc_SQT_x_cross(xx_new, b_new, v_i, false)
+					+ preg_mods[v_j]->calc_SQT_b(b_new);
+		log_denom = preg_mods[v_j]->get_SQT_x() + preg_mods[v_j]->calc_SQT_b();
+	}
+	else
+	{
+		log_num = preg_mods[v_j]->calc_SQT_x(x_new, b_new) + preg_mods[v_j]->calc_SQT_b(b_new);
+		log_denom = preg_mods[v_j]->calc_SQT_x() + preg_mods[v_j]->calc_SQT_b();
+	}
 
 	ratio = -1/(2*preg_mods[v_j]->get_sigma_i())
 			*(log_num - log_denom) + p_prop(beta_old) ;
 
+	return ratio;
+}
 
 
 
-	// accept proposal and change the corresponding values
 
-	if(func::accept(ratio) == true)
-	{
+// FUNCTION: death_accept
+// changes the current state according to an accepted death-step
+
+void FULLCOND_rj::death_accept(unsigned int v_i, unsigned int v_j)
+{
+		unsigned int ncoef_new = preg_mods[v_j]->get_ncoef() - 1;
+
         zeta(v_i,v_j)=0;
 		zeta.change_list(v_i,v_j,1);
 		preg_mods[v_j]->change_adcol(v_i,0);
-		preg_mods[v_j]->change(v_i, b_new, x_new, xx_new, ncoef_new);
+		preg_mods[v_j]->change(v_i, preg_mods[v_j]->get_b_new_d(),
+						preg_mods[v_j]->get_x_new_d(),
+						preg_mods[v_j]->get_xx_new_d(), ncoef_new);
 
 		acceptance_d ++;
-		nrtrials_d ++;
 		zeta.edge_minus();
+}
 
-		/*********************
-			unsigned k,l;
-			for(k=0; k<nvar; k++)
+
+
+
+// FUNCTION: rj_batch
+// makes at most nrmoves moves on pairs of variables that are pairwise disjoint.
+// Birth and death steps of such pairs change different regression models,
+// i.e. their proposals do not depend on each other and are computed
+// concurrently. The moves are then accepted or rejected one after another
+// as in rj_step; a birth step that would create a cycle given the
+// moves accepted before is rejected. Switch steps are made in the second
+// pass, since they draw random numbers during the computation.
+
+void FULLCOND_rj::rj_batch(void)
+{
+	unsigned m;
+	unsigned vertex_i;
+	unsigned vertex_j;
+
+	vector <bool> used(nvar,false);
+
+	batch_i.erase(batch_i.begin(),batch_i.end());
+	batch_j.erase(batch_j.begin(),batch_j.end());
+	batch_type.erase(batch_type.begin(),batch_type.end());
+	batch_beta.erase(batch_beta.begin(),batch_beta.end());
+
+
+	// ********** choose pairs of variables and the kind of step *************
+
+	for(m=0; m<nrmoves; m++)
+	{
+		vertex_i = rand() % nvar;
+		vertex_j = vertex_i;
+
+		while(vertex_i==vertex_j)
+			vertex_j= rand() % nvar;
+
+		if(used[vertex_i] || used[vertex_j])
+			continue;
+
+		used[vertex_i] = true;
+		used[vertex_j] = true;
+
+		char steptype;
+		bool ok;
+
+		if (zeta(vertex_i,vertex_j) == 1)
+		{
+			steptype = 'd';
+			ok = (conditions == false) || conditions_okay_d(vertex_i,vertex_j);
+		}
+		else if (zeta(vertex_j,vertex_i) == 1)
+		{
+			steptype = 's';
+			ok = (conditions == false) || conditions_okay_s(vertex_i,vertex_j);
+		}
+		else
+		{
+			steptype = 'b';
+			ok = (conditions == false) || conditions_okay_b(vertex_i,vertex_j);
+		}
+
+		if(ok == false)
+			continue;
+
+		batch_i.push_back(vertex_i);
+		batch_j.push_back(vertex_j);
+		batch_type.push_back(steptype);
+
+		if(steptype == 'b')
+			batch_beta.push_back(rand_normal());
+		else
+			batch_beta.push_back(0);
+
+		if(mixed_case==true)
+		{
+			if(steptype == 'b')
+				preg_mods[vertex_j]->create_matrices("b", preg_mods[vertex_j]->get_ncoef()+1);
+			else if(steptype == 'd')
+				preg_mods[vertex_j]->create_matrices("d", preg_mods[vertex_j]->get_ncoef()-1);
+		}
+	}
+
+	int n = batch_i.size();
+	int p;
+
+	if(batch_b.size() < unsigned(n))
+	{
+		batch_b.resize(n);
+		batch_x.resize(n);
+		batch_xx.resize(n);
+	}
+	batch_ratio.resize(n);
+
+
+	// ********** proposals and acceptance ratios of birth and death steps ***
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(p=0; p<n; p++)
+	{
+		if(batch_type[p] == 'b')
+		{
+			batch_b[p] = preg_mods[batch_j[p]]->get_b_new_b();
+			if(preg_mods[batch_j[p]]->has_crossproducts() == false)
+				batch_x[p] = preg_mods[batch_j[p]]->get_x_new_b();
+			batch_xx[p] = preg_mods[batch_j[p]]->get_xx_new_b();
+
+			batch_ratio[p] = birth_ratio(batch_i[p],batch_j[p],batch_beta[p],
+								batch_b[p],batch_x[p],batch_xx[p]);
+		}
+		else if(batch_type[p] == 'd')
+			batch_ratio[p] = death_ratio(batch_i[p],batch_j[p]);
+	}
+
+
+	// ********** accept or reject ********************************************
+
+	for(p=0; p<n; p++)
+	{
+		vertex_i = batch_i[p];
+		vertex_j = batch_j[p];
+
+		if(batch_type[p] == 'b')
+		{
+			if(zeta.azy_test(vertex_i,vertex_j) == true)
 			{
-				for(l=0; l<nvar; l++)
-					cout<<zeta(k,l)<<" ";
-				cout<<endl;
+				if(func::accept(batch_ratio[p]) == true)
+					birth_accept(vertex_i,vertex_j,batch_b[p],batch_x[p],batch_xx[p]);
+
+				nrtrials_b ++;
 			}
-			cout<<endl
-				<<endl;;
-		*********************/
+		}
+		else if(batch_type[p] == 'd')
+		{
+			if(func::accept(batch_ratio[p]) == true)
+				death_accept(vertex_i,vertex_j);
+
+			nrtrials_d ++;
+		}
+		else
+			switch_step(vertex_i,vertex_j);
 	}
 
-	nrtrials_d ++;
 	step_aborted = false;
 }
 
 
 
 
-
 // FUNCTION: switch_step
 // makes switch step from j->i to i->j
 
@@ -916,26 +1140,37 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 
 
 
+		// birth and death steps of models with cross products (see
+		// FULLCOND_dag::set_crossproducts) need neither x_new nor the
+		// proposed linear predictor
+
+		bool cross = (step != "s") && preg_mods[j]->has_crossproducts()
+					&& (xxdata.rows() == nvar+1);
+
+
 	   //*********************** compute x_new ************************************
 		double * workx_new;
 		double * workx;
 		double * workdata;
 
-		workx_new = x_new.getV();
-		workx = preg_mods[j]->getV_x();
-		workdata = data.getV()+i;
-
-		for(k=0; k<nobs; k++)
+		if(cross == false)
 		{
-			for(l=0; l<ncoef_new; l++, workx_new++, workx++)
+			workx_new = x_new.getV();
+			workx = preg_mods[j]->getV_x();
+			workdata = data.getV()+i;
+
+			for(k=0; k<nobs; k++)
 			{
-				if(l != t)
-					*workx_new = *workx;
-				else
+				for(l=0; l<ncoef_new; l++, workx_new++, workx++)
 				{
-					*workx_new = *workdata;
-					workdata = workdata + nvar;
-					workx--;
+					if(l != t)
+						*workx_new = *workx;
+					else
+					{
+						*workx_new = *workdata;
+						workdata = workdata + nvar;
+						workx--;
+					}
 				}
 			}
 		}
@@ -954,6 +1189,28 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 
 		double value;
 
+		// if x_new consists of the intercept and main effects only, the new
+		// row and column of xx_new are taken from the cross products of the
+		// data (which are summed up in the same order)
+
+		bool cached = (xxdata.rows() == nvar+1) && (preg_mods[j]->get_ncoef_ia() == 0);
+		vector<unsigned> colvar;
+
+		if(cached)
+		{
+			colvar = vector<unsigned>(ncoef_new,0);
+			l=1;
+			for(k=0; k<nvar; k++)
+			{
+				if( (k==i) || (zeta(k,j)==1) )
+				{
+					colvar[l] = k+1;
+					l++;
+				}
+			}
+			assert(l==ncoef_new);
+		}
+
 		workxx_new = xx_new.getV();
 		workxx = preg_mods[j]->getV_xx();
 
@@ -967,15 +1224,20 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 						*workxx_new = *workxx;
 					else
 					{
-						workx1 = x_new.getV() + k;
-						workx2 = x_new.getV() +l;
-						value =0;
-
-						for(kk=0; kk<nobs; kk++)
+						if(cached)
+							value = xxdata(colvar[k],colvar[l]);
+						else
 						{
-							value = value + (*workx1) * (*workx2);
-							workx1 = workx1 + ncoef_new;
-							workx2 = workx2 + ncoef_new;
+							workx1 = x_new.getV() + k;
+							workx2 = x_new.getV() +l;
+							value =0;
+
+							for(kk=0; kk<nobs; kk++)
+							{
+								value = value + (*workx1) * (*workx2);
+								workx1 = workx1 + ncoef_new;
+								workx2 = workx2 + ncoef_new;
+							}
 						}
 
 						*workxx_new = value;
@@ -988,15 +1250,20 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 			{
 				for(l=0; l<ncoef_new; l++,workxx_new++)
 				{
-					workx1 = x_new.getV()+k;
-					workx2 = x_new.getV()+l;
-					value =0;
-
-					for(kk=0; kk<nobs; kk++)
+					if(cached)
+						value = xxdata(colvar[k],colvar[l]);
+					else
 					{
-						value = value + (*workx1) * (*workx2);
-						workx1 = workx1 + ncoef_new;
-						workx2 = workx2 + ncoef_new;
+						workx1 = x_new.getV()+k;
+						workx2 = x_new.getV()+l;
+						value =0;
+
+						for(kk=0; kk<nobs; kk++)
+						{
+							value = value + (*workx1) * (*workx2);
+							workx1 = workx1 + ncoef_new;
+							workx2 = workx2 + ncoef_new;
+						}
 					}
 
 					*workxx_new = value;
@@ -1031,7 +1298,8 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 			}
 
 			//compute proposed linear predictor
-			preg_mods[j]->calc_lin_prop( x_new, b_new);
+			if(cross == false)
+				preg_mods[j]->calc_lin_prop( x_new, b_new);
 		}
 	}
 
@@ -1070,21 +1338,31 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 
 
 
+		// death steps of models with cross products (see
+		// FULLCOND_dag::set_crossproducts) need neither x_new nor the
+		// proposed linear predictor
+
+		bool cross = (step != "s") && preg_mods[j]->has_crossproducts();
+
+
 		//************************** compute x_new ************************************
 		double * workx_new;
 		double * workx;
 
-		workx_new = x_new.getV();
-		workx = preg_mods[j]->getV_x();
-
-		for(k=0; k<nobs; k++)
+		if(cross == false)
 		{
-			for(l=0; l<ncoef; l++, workx_new++, workx++)
+			workx_new = x_new.getV();
+			workx = preg_mods[j]->getV_x();
+
+			for(k=0; k<nobs; k++)
 			{
-				if(l != t)
-					*workx_new = *workx;
-				else
-					workx_new--;
+				for(l=0; l<ncoef; l++, workx_new++, workx++)
+				{
+					if(l != t)
+						*workx_new = *workx;
+					else
+						workx_new--;
+				}
 			}
 		}
 
@@ -1146,7 +1424,8 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 			}
 
 			//compute proposed linear predictor
-			preg_mods[j]->calc_lin_prop(x_new, b_new);
+			if(cross == false)
+				preg_mods[j]->calc_lin_prop(x_new, b_new);
 		}
 	}
 
@@ -1910,7 +2189,10 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 		cout<<endl;
 		*********************/
 
-		  rj_step ();
+		  if(nrmoves > 1)
+			  rj_batch();
+		  else
+			  rj_step ();
 
 
 
@@ -2215,6 +2497,44 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 
 
 
+  // FUNCTION: ini_crossproducts
+  // TASK: initializes xxdata
+  void FULLCOND_rj::ini_crossproducts(void)
+  {
+	  unsigned k,l,kk;
+	  double value;
+	  double * workx1;
+	  double * workx2;
+
+	  xxdata = datamatrix(nvar+1,nvar+1,0);
+
+	  xxdata(0,0) = nobs;
+
+	  for(k=0; k<nvar; k++)
+	  {
+		  workx1 = data.getV()+k;
+		  value = 0;
+		  for(kk=0; kk<nobs; kk++, workx1+=nvar)
+			  value = value + (*workx1);
+		  xxdata(0,k+1) = value;
+		  xxdata(k+1,0) = value;
+
+		  for(l=k; l<nvar; l++)
+		  {
+			  workx1 = data.getV()+k;
+			  workx2 = data.getV()+l;
+			  value = 0;
+			  for(kk=0; kk<nobs; kk++, workx1+=nvar, workx2+=nvar)
+				  value = value + (*workx1) * (*workx2);
+			  xxdata(k+1,l+1) = value;
+			  xxdata(l+1,k+1) = value;
+		  }
+	  }
+  }
+
+
+
+
   // FUNCTION: set_options
   // TASK: sets the options
   void FULLCOND_rj::set_options(void)
@@ -2369,6 +2689,9 @@ void FULLCOND_rj::switch_version_2(unsigned v_i, unsigned v_j)
 		optionsp->out("Type of starting dag: " + ST::inttostring(type) + "\n");
         optionsp->out("Distribution family: " + preg_mods[0]->get_family()   + "\n");
 
+		if(nrmoves > 1)
+			optionsp->out("Maximal number of moves per iteration: " + ST::inttostring(nrmoves) + "\n");
+
 
 		if(conditions == true)
 		{
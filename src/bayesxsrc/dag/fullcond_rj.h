@@ -185,6 +185,25 @@ class __EXPORT_TYPE FULLCOND_rj : public FULLCOND
 
       ST::string family;       // continuous, binary with(out) interaction or mixed
 
+	  datamatrix xxdata;		// cross products of the data, row/column 0
+								// corresponds to the intercept, row/column k+1
+								// to variable k (used to compute xx_new in
+								// birth steps)
+
+	  unsigned nrmoves;			// maximal number of birth/death/switch
+								// moves per iteration, see rj_batch
+
+	  // proposals of the current batch of moves (see rj_batch)
+
+	  vector <unsigned> batch_i;
+	  vector <unsigned> batch_j;
+	  vector <char> batch_type;		// 'b' birth, 'd' death, 's' switch
+	  vector <double> batch_beta;	// coefficient proposed in a birth step
+	  vector <double> batch_ratio;	// acceptance ratio of birth/death steps
+	  vector <datamatrix> batch_b;	// proposed values of birth steps
+	  vector <datamatrix> batch_x;
+	  vector <datamatrix> batch_xx;
+
 
 
 
@@ -194,7 +213,10 @@ class __EXPORT_TYPE FULLCOND_rj : public FULLCOND
 
 
   // DEFAULT CONSTRUCTOR:
-  FULLCOND_rj(void) : FULLCOND() {}
+  FULLCOND_rj(void) : FULLCOND()
+  {
+	  nrmoves = 1;
+  }
 
 
   // CONSTRUCTOR_1
@@ -235,6 +257,37 @@ class __EXPORT_TYPE FULLCOND_rj : public FULLCOND
   void rj_step(void);
 
 
+  // FUNCTION: rj_batch
+  // makes nrmoves moves on pairs of variables that are pairwise disjoint,
+  // the proposals of the birth and death steps are computed concurrently
+  // (if compiled with OpenMP) and accepted one after another
+  void rj_batch(void);
+
+
+  // FUNCTION: birth_ratio
+  // TASK: computes the proposal and the acceptance ratio of a birth-step
+  // without changing the current state
+  double birth_ratio(unsigned int v_i, unsigned int v_j, double beta_new,
+					datamatrix & b_new, datamatrix & x_new, datamatrix & xx_new);
+
+
+  // FUNCTION: death_ratio
+  // TASK: computes the proposal and the acceptance ratio of a death-step
+  // without changing the current state
+  double death_ratio(unsigned int v_i, unsigned int v_j);
+
+
+  // FUNCTION: birth_accept
+  // TASK: changes the current state according to an accepted birth-step
+  void birth_accept(unsigned int v_i, unsigned int v_j, const datamatrix & b_new,
+					const datamatrix & x_new, const datamatrix & xx_new);
+
+
+  // FUNCTION: death_accept
+  // TASK: changes the current state according to an accepted death-step
+  void death_accept(unsigned int v_i, unsigned int v_j);
+
+
   // FUNCTION: birth_step
   // makes birth step
   virtual void birth_step(unsigned int v_i, unsigned int v_j);
@@ -445,6 +498,21 @@ class __EXPORT_TYPE FULLCOND_rj : public FULLCOND
   void ini_ratio(void);
 
 
+  // FUNCTION: ini_crossproducts
+  // TASK: initializes xxdata
+  void ini_crossproducts(void);
+
+
+  // FUNCTION: set_moves
+  // TASK: sets the maximal number of moves per iteration (pairs sharing a
+  //       vertex with a pair already in the batch are skipped, i.e. fewer
+  //       moves may be made, see rj_batch)
+  void set_moves(unsigned m)
+  {
+	  nrmoves = m > 0 ? m : 1;
+  }
+
+
   // FUNCTION: ini_hyperpar
   // TASK: initializes hyperparamaters etc
   void ini_hyperpar(void);
@@ -172,7 +172,6 @@ void FULLCOND_rj_ia::death_step(unsigned int i, unsigned int j)
 			preg_mods[j]->change(b_new, x_new, xx_new, ncoef_new);
 
 			acceptance_d ++;
-			nrtrials_d ++;
 			zeta.edge_minus();
 
 			cout<<"successful death"<<endl;
@@ -241,7 +240,6 @@ void FULLCOND_rj_ia::death_step(unsigned int i, unsigned int j)
 
 
 		acceptance_d ++;
-		nrtrials_d ++;
 		zeta.edge_minus();
 
 		cout<<"successful death_ia"<<endl;
@@ -311,7 +311,6 @@ void FULLCOND_rj_int::death_step(unsigned int i, unsigned int j)
 			preg_mods[j]->change_current('d', ias_del);
 
 			acceptance_d ++;
-			nrtrials_d ++;
 			zeta.edge_minus();
 
 			/*********************
@@ -399,7 +399,8 @@ bool MCMCsimulate::simulate(const vector<ST::string> & header, const int & seed,
           genoptions_mult[0]->out("\n");
           }
 
-       if (likep_mult[i]->get_family() == "cox" && likep_mult[i]->get_predict() == true)
+       if (likepexisting && likep_mult[i]->get_family() == "cox" &&
+           likep_mult[i]->get_predict() == true)
           {
 
 //          for(j=begin[i];j<=end[i];j++)
@@ -409,7 +410,8 @@ bool MCMCsimulate::simulate(const vector<ST::string> & header, const int & seed,
             j++;
           ( dynamic_cast<pspline_baseline*>(fullcondp[j]) )->compute_int_ti_mean();
           }
-       else if (likep_mult[i]->get_family() == "multistate" && likep_mult[i]->get_predict() == true)
+       else if (likepexisting && likep_mult[i]->get_family() == "multistate" &&
+                likep_mult[i]->get_predict() == true)
           {
           j = begin[i];
           while( !fullcondp[j]->is_baseline() )
@@ -273,23 +273,16 @@ using std::flush;
 
       // compute score-function and expected fisher information
 
+      compute_score_fisher(H,Hinv,zcut,X.cols(),theta.rows(),thetaold,
+                           score,Fisher);
+
       for(i=0; i<theta.rows(); i++)
         {
-        score(i,0)=-1*(H.getBlock(X.cols()+zcut[i],X.cols()+zcut[i],X.cols()+zcut[i+1],X.cols()+zcut[i+1])*thetaold(i,0)).trace()+
-                   ((H.getRowBlock(X.cols()+zcut[i],X.cols()+zcut[i+1]))*Hinv*(H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1]))*thetaold(i,0)).trace();
         for(l=zcut[i]; l<zcut[i+1]; l++)
           {
           help = (wresid*(Z.getCol(l)))(0,0);
           score(i,0) += help*help*thetaold(i,0);
           }
-
-        for(k=0; k<theta.rows(); k++)
-          {
-          Fisher(i,k)=2*(H.getBlock(X.cols()+zcut[i],X.cols()+zcut[k],X.cols()+zcut[i+1],X.cols()+zcut[k+1])*H.getBlock(X.cols()+zcut[k],X.cols()+zcut[i],X.cols()+zcut[k+1],X.cols()+zcut[i+1])*thetaold(i,0)*thetaold(k,0)).trace()-
-                      4*(H.getRowBlock(X.cols()+zcut[k],X.cols()+zcut[k+1])*Hinv*H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*H.getBlock(X.cols()+zcut[i],X.cols()+zcut[k],X.cols()+zcut[i+1],X.cols()+zcut[k+1])*thetaold(i,0)*thetaold(k,0)).trace()+
-                      2*(H.getRowBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*Hinv*H.getColBlock(X.cols()+zcut[k],X.cols()+zcut[k+1])*H.getRowBlock(X.cols()+zcut[k],X.cols()+zcut[k+1])*Hinv*H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*thetaold(i,0)*thetaold(k,0)).trace();
-          Fisher(k,i)=Fisher(i,k);
-          }
         }
 
       // fisher scoring for theta
@@ -929,6 +922,9 @@ bool remlest::estimate_dispers(const datamatrix resp, const datamatrix & offset,
   statmatrix<double>Hinv(beta.rows(),beta.rows(),0);
   statmatrix<double>wresid(1,resp.rows(),0);                     //row vector !!
   statmatrix<double>w1resid(resp.rows(),1,0);
+  statmatrix<double>HHinv(beta.rows(),beta.rows(),0);
+  statmatrix<double>HHinvHi;
+  double scale;
 
   // Transform smoothing paramater starting values to variances
   datamatrix consttheta;
@@ -1055,34 +1051,34 @@ bool remlest::estimate_dispers(const datamatrix resp, const datamatrix & offset,
 
       // compute score-function and expected fisher information
 
+      compute_score_fisher(H,Hinv,zcut,X.cols(),theta.rows()-1,thetaold,
+                           score,Fisher);
+
+      // HHinv = H*Hinv, the rows of theta_i in HHinv are H_i*Hinv
+      HHinv.mult(H,Hinv);
+      scale = thetaold(theta.rows()-1,0);
+
       for(i=0; i<theta.rows()-1; i++)
         {
-        score(i,0)=-1*(H.getBlock(X.cols()+zcut[i],X.cols()+zcut[i],X.cols()+zcut[i+1],X.cols()+zcut[i+1])*thetaold(i,0)).trace()+
-                   ((H.getRowBlock(X.cols()+zcut[i],X.cols()+zcut[i+1]))*Hinv*(H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1]))*thetaold(i,0)).trace();
         for(l=zcut[i]; l<zcut[i+1]; l++)
           {
           help = (wresid*(Z.getCol(l)))(0,0);
           score(i,0) += help*help*thetaold(i,0);
           }
-        Fisher(theta.rows()-1,i)=2*(H.getBlock(X.cols()+zcut[i],X.cols()+zcut[i],X.cols()+zcut[i+1],X.cols()+zcut[i+1])*thetaold(i,0)/thetaold(theta.rows()-1,0)).trace()-
-                    4*(H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*H.getRowBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*Hinv*thetaold(i,0)/thetaold(theta.rows()-1,0)).trace()+
-                    2*(H*Hinv*H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*H.getRowBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*Hinv*thetaold(i,0)/thetaold(theta.rows()-1,0)).trace();
+        HHinvHi = datamatrix(beta.rows(),zcut[i+1]-zcut[i]);
+        HHinvHi.mult(HHinv,H.getColBlockview(X.cols()+zcut[i],X.cols()+zcut[i+1]));
+        Fisher(theta.rows()-1,i)=2*thetaold(i,0)/scale*H.getBlockview(X.cols()+zcut[i],X.cols()+zcut[i],X.cols()+zcut[i+1],X.cols()+zcut[i+1]).trace()-
+                    4*thetaold(i,0)/scale*tracemult(HHinv.getRowBlockview(X.cols()+zcut[i],X.cols()+zcut[i+1]),H.getColBlockview(X.cols()+zcut[i],X.cols()+zcut[i+1]))+
+                    2*thetaold(i,0)/scale*tracemult(HHinv.getRowBlockview(X.cols()+zcut[i],X.cols()+zcut[i+1]),statmatrix_block<double>(HHinvHi));
         Fisher(i,theta.rows()-1)=Fisher(theta.rows()-1,i);
-        for(k=0; k<theta.rows()-1; k++)
-          {
-          Fisher(i,k)=2*(H.getBlock(X.cols()+zcut[i],X.cols()+zcut[k],X.cols()+zcut[i+1],X.cols()+zcut[k+1])*H.getBlock(X.cols()+zcut[k],X.cols()+zcut[i],X.cols()+zcut[k+1],X.cols()+zcut[i+1])*thetaold(i,0)*thetaold(k,0)).trace()-
-                      4*(H.getRowBlock(X.cols()+zcut[k],X.cols()+zcut[k+1])*Hinv*H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*H.getBlock(X.cols()+zcut[i],X.cols()+zcut[k],X.cols()+zcut[i+1],X.cols()+zcut[k+1])*thetaold(i,0)*thetaold(k,0)).trace()+
-                      2*(H.getRowBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*Hinv*H.getColBlock(X.cols()+zcut[k],X.cols()+zcut[k+1])*H.getRowBlock(X.cols()+zcut[k],X.cols()+zcut[k+1])*Hinv*H.getColBlock(X.cols()+zcut[i],X.cols()+zcut[i+1])*thetaold(i,0)*thetaold(k,0)).trace();
-          Fisher(k,i)=Fisher(i,k);
-          }
         }
-      score(theta.rows()-1,0)=-(double)nrobspos/thetaold(theta.rows()-1,0)+
-            0.5*(2/thetaold(theta.rows()-1,0)*H*Hinv).trace()+
-            w1resid.sum2(0)/thetaold(theta.rows()-1,0);
+      score(theta.rows()-1,0)=-(double)nrobspos/scale+
+            HHinv.trace()/scale+
+            w1resid.sum2(0)/scale;
 
-      Fisher(theta.rows()-1,theta.rows()-1)=2*(double)nrobspos/(thetaold(theta.rows()-1,0)*thetaold(theta.rows()-1,0))-
-             4*(H*Hinv/(thetaold(theta.rows()-1,0)*thetaold(theta.rows()-1,0))).trace()+
-             2*(H*Hinv*H*Hinv/(thetaold(theta.rows()-1,0)*thetaold(theta.rows()-1,0))).trace();
+      Fisher(theta.rows()-1,theta.rows()-1)=2*(double)nrobspos/(scale*scale)-
+             4*HHinv.trace()/(scale*scale)+
+             2*tracemult(statmatrix_block<double>(HHinv),statmatrix_block<double>(HHinv))/(scale*scale);
 
       // fisher scoring for theta
       theta = thetaold + Fisher.solve(score);
@@ -1128,13 +1124,16 @@ bool remlest::estimate_dispers(const datamatrix resp, const datamatrix & offset,
       if (stop)
         return true;
 
-      score(0,0)=-(double)nrobspos/thetaold(theta.rows()-1,0)+
-            0.5*(2/thetaold(theta.rows()-1,0)*H*Hinv).trace()+
-            w1resid.sum2(0)/thetaold(theta.rows()-1,0);
+      HHinv.mult(H,Hinv);
+      scale = thetaold(theta.rows()-1,0);
 
-      Fisher(0,0)=2*(double)nrobspos/(thetaold(theta.rows()-1,0)*thetaold(theta.rows()-1,0))-
-             4*(H*Hinv/(thetaold(theta.rows()-1,0)*thetaold(theta.rows()-1,0))).trace()+
-             2*(H*Hinv*H*Hinv/(thetaold(theta.rows()-1,0)*thetaold(theta.rows()-1,0))).trace();
+      score(0,0)=-(double)nrobspos/scale+
+            HHinv.trace()/scale+
+            w1resid.sum2(0)/scale;
+
+      Fisher(0,0)=2*(double)nrobspos/(scale*scale)-
+             4*HHinv.trace()/(scale*scale)+
+             2*tracemult(statmatrix_block<double>(HHinv),statmatrix_block<double>(HHinv))/(scale*scale);
 
       theta(theta.rows()-1,0) = thetaold(theta.rows()-1,0) + score(0,0)/Fisher(0,0);
 
@@ -2562,7 +2561,7 @@ bool remlest::estimate_survival(const datamatrix resp,
       {
       for(k=j; k< theta.rows(); k++)
         {
-        Fisher(j,k) = 2*((Hinv.getBlock(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1])*Hinv.getBlock(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1])).trace())/(theta(j,0)*theta(j,0)*theta(j,0)*theta(k,0)*theta(k,0)*theta(k,0));
+        Fisher(j,k) = 2*tracemult(Hinv.getBlockview(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1]),Hinv.getBlockview(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1]))/(theta(j,0)*theta(j,0)*theta(j,0)*theta(k,0)*theta(k,0)*theta(k,0));
         Fisher(k,j) = Fisher(j,k);
         }
       }
@@ -3662,7 +3661,7 @@ bool remlest::estimate_survival_interval(datamatrix resp,
       {
       for(k=j; k< theta.rows(); k++)
         {
-        Fisher(j,k) = 2*((Hinv.getBlock(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1])*Hinv.getBlock(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1])).trace())/(theta(j,0)*theta(j,0)*theta(j,0)*theta(k,0)*theta(k,0)*theta(k,0));
+        Fisher(j,k) = 2*tracemult(Hinv.getBlockview(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1]),Hinv.getBlockview(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1]))/(theta(j,0)*theta(j,0)*theta(j,0)*theta(k,0)*theta(k,0)*theta(k,0));
         Fisher(k,j) = Fisher(j,k);
         }
       }
@@ -5575,7 +5574,7 @@ for(i=0; i<nrobs; i++)
         {
         for(k=j; k< theta.rows(); k++)
           {
-          Fisher(j,k) = 2*((Hinv.getBlock(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1])*Hinv.getBlock(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1])).trace())/(theta(j,0)*theta(j,0)*theta(j,0)*theta(k,0)*theta(k,0)*theta(k,0));
+          Fisher(j,k) = 2*tracemult(Hinv.getBlockview(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1]),Hinv.getBlockview(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1]))/(theta(j,0)*theta(j,0)*theta(j,0)*theta(k,0)*theta(k,0)*theta(k,0));
           Fisher(k,j) = Fisher(j,k);
           }
         }
@@ -5622,7 +5621,7 @@ for(i=0; i<nrobs; i++)
         for(k=j; k< theta.rows(); k++)
           {
 //          Fisher(j,k) = 2*exp(theta(j,0))*exp(theta(k,0))*((Hinv.getBlock(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1])*Hinv.getBlock(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1])).trace())/(exp(theta(j,0))*exp(theta(j,0))*exp(theta(j,0))*exp(theta(k,0))*exp(theta(k,0))*exp(theta(k,0)));
-          Fisher(j,k) = 2*((Hinv.getBlock(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1])*Hinv.getBlock(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1])).trace())/(exp(theta(j,0))*exp(theta(j,0))*exp(theta(k,0))*exp(theta(k,0)));
+          Fisher(j,k) = 2*tracemult(Hinv.getBlockview(X.cols()+zcut[j],X.cols()+zcut[k],X.cols()+zcut[j+1],X.cols()+zcut[k+1]),Hinv.getBlockview(X.cols()+zcut[k],X.cols()+zcut[j],X.cols()+zcut[k+1],X.cols()+zcut[j+1]))/(exp(theta(j,0))*exp(theta(j,0))*exp(theta(k,0))*exp(theta(k,0)));
           Fisher(k,j) = Fisher(j,k);
           }
         }
@@ -6592,3 +6591,61 @@ void remlest::outerror(const ST::string & s)
 
 
 
+
+
+//------------------------------------------------------------------------------
+//------------------- Score function and Fisher information --------------------
+//------------------------------------------------------------------------------
+
+void compute_score_fisher(const datamatrix & H,const datamatrix & Hinv,
+                          const vector<unsigned> & cut,const unsigned & first,
+                          const unsigned & nrtheta,const datamatrix & thetaold,
+                          datamatrix & score,datamatrix & Fisher)
+  {
+  unsigned i,k;
+  double tt;
+
+  // HHinv[i] = H_i*Hinv, where H_i are the rows of H belonging to theta_i
+  vector<datamatrix> HHinv(nrtheta);
+  for(i=0; i<nrtheta; i++)
+    {
+    HHinv[i] = datamatrix(cut[i+1]-cut[i],Hinv.cols());
+    HHinv[i].mult(H.getRowBlockview(first+cut[i],first+cut[i+1]),Hinv);
+    }
+
+  // HHinvH[i*nrtheta+k] = H_i*Hinv*H^k, where H^k are the columns of H
+  // belonging to theta_k
+  vector<datamatrix> HHinvH(nrtheta*nrtheta);
+  for(i=0; i<nrtheta; i++)
+    {
+    for(k=0; k<nrtheta; k++)
+      {
+      HHinvH[i*nrtheta+k] = datamatrix(cut[i+1]-cut[i],cut[k+1]-cut[k]);
+      HHinvH[i*nrtheta+k].mult(HHinv[i],
+                       H.getColBlockview(first+cut[k],first+cut[k+1]));
+      }
+    }
+
+  for(i=0; i<nrtheta; i++)
+    {
+    score(i,0)=-1*thetaold(i,0)*H.getBlockview(first+cut[i],first+cut[i],
+                                   first+cut[i+1],first+cut[i+1]).trace()+
+               thetaold(i,0)*HHinvH[i*nrtheta+i].trace();
+
+    for(k=0; k<=i; k++)
+      {
+      statmatrix_block<double> Hik = H.getBlockview(first+cut[i],
+                                first+cut[k],first+cut[i+1],first+cut[k+1]);
+      statmatrix_block<double> Hki = H.getBlockview(first+cut[k],
+                                first+cut[i],first+cut[k+1],first+cut[i+1]);
+      tt = thetaold(i,0)*thetaold(k,0);
+
+      Fisher(i,k)=2*tt*tracemult(Hik,Hki)-
+                  4*tt*tracemult(statmatrix_block<double>(HHinvH[k*nrtheta+i]),Hik)+
+                  2*tt*tracemult(statmatrix_block<double>(HHinvH[i*nrtheta+k]),
+                                 statmatrix_block<double>(HHinvH[k*nrtheta+i]));
+      Fisher(k,i)=Fisher(i,k);
+      }
+    }
+
+  }
@@ -219,6 +219,19 @@ class remlest
 
   };
 
+// FUNCTION: compute_score_fisher
+// TASK: computes the trace terms of the score function and the expected
+//       Fisher information for the variance parameters theta_0,...,
+//       theta_{nrtheta-1}. The random effects of theta_i correspond to the
+//       rows/columns first+cut[i],...,first+cut[i+1]-1 of H, Hinv is the
+//       inverse of the penalised H. All products are computed on block views
+//       and H_i*Hinv is formed only once per variance parameter
+
+void compute_score_fisher(const datamatrix & H,const datamatrix & Hinv,
+                          const vector<unsigned> & cut,const unsigned & first,
+                          const unsigned & nrtheta,const datamatrix & thetaold,
+                          datamatrix & score,datamatrix & Fisher);
+
 #endif
 
 
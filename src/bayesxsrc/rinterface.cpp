@@ -0,0 +1,214 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+// R interface of the shared library BayesXsrc.so, see R function
+// run.bayesx.inprocess()
+
+#include"inprocess.h"
+#include"values.h"
+#include<exception>
+
+#define R_NO_REMAP
+#include<R.h>
+#include<Rinternals.h>
+#include<R_ext/Rdynload.h>
+
+
+// FUNCTION: matrix2R
+// TASK: copies a datamatrix into a (column major) R matrix, missing values
+//       are returned as NA
+
+static SEXP matrix2R(const datamatrix & m)
+  {
+  unsigned rows = m.rows();
+  unsigned cols = m.cols();
+  if (m.getV() == NULL)
+    rows = 0;
+
+  SEXP res = PROTECT(Rf_allocMatrix(REALSXP,rows,cols));
+  double * r = REAL(res);
+
+  unsigned i,j;
+  for (i=0;i<rows;i++)
+    for (j=0;j<cols;j++)
+      {
+      double v = m(i,j);
+      r[i+j*rows] = (v == MAXDOUBLE) ? NA_REAL : v;
+      }
+
+  UNPROTECT(1);
+  return res;
+  }
+
+
+extern "C" {
+
+// FUNCTION: bayesx_inprocess
+// TASK: estimates a model without temporary files
+//       data    : named list of numeric vectors of equal length
+//       model   : model formula in BayesX syntax
+//       options : options of method hregress
+//       path    : directory with subdirectories temp and output (see
+//                 run_inprocess)
+//       returns list(log, error, results) where results is a named list with
+//       elements list(summary, samples) for each model term
+
+SEXP bayesx_inprocess(SEXP data, SEXP model, SEXP options, SEXP path)
+  {
+
+  SEXP dnames = Rf_getAttrib(data,R_NamesSymbol);
+  int nrvar = Rf_length(data);
+
+  // checks are done before any C++ object is created, since Rf_error does
+  // not return
+
+  int j;
+  for (j=0;j<nrvar;j++)
+    {
+    if (TYPEOF(VECTOR_ELT(data,j)) != REALSXP)
+      Rf_error("variable %d is not a numeric vector",j+1);
+    if (Rf_length(VECTOR_ELT(data,j)) != Rf_length(VECTOR_ELT(data,0)))
+      Rf_error("variables must have the same length");
+    }
+  if (nrvar > 0 && Rf_length(dnames) != nrvar)
+    Rf_error("variables must be named");
+
+  vector<ST::string> varnames;
+  vector<const double *> columns;
+  unsigned nrobs = (nrvar > 0) ? Rf_length(VECTOR_ELT(data,0)) : 0;
+
+  vector<ST::string> names;
+  vector< vector<ST::string> > labels;
+  vector<datamatrix> summaries;
+  vector<datamatrix> samples;
+  ST::string log;
+  bool errors;
+
+  // C++ exceptions must not cross the .Call boundary, they are reported
+  // via the error element of the result
+
+  try
+    {
+    for (j=0;j<nrvar;j++)
+      {
+      varnames.push_back(ST::string(CHAR(STRING_ELT(dnames,j))));
+      columns.push_back(REAL(VECTOR_ELT(data,j)));
+      }
+
+    errors = run_inprocess(varnames,columns,nrobs,
+                           ST::string(CHAR(STRING_ELT(model,0))),
+                           ST::string(CHAR(STRING_ELT(options,0))),
+                           ST::string(CHAR(STRING_ELT(path,0))),
+                           names,labels,summaries,samples,log);
+    }
+  catch (const std::exception & e)
+    {
+    errors = true;
+    log = ST::string("ERROR: ") + ST::string(e.what()) + "\n";
+    }
+  catch (...)
+    {
+    errors = true;
+    log = "ERROR: unknown exception\n";
+    }
+
+  if (errors)
+    {
+    names.clear();
+    labels.clear();
+    summaries.clear();
+    samples.clear();
+    }
+
+  // results
+
+  SEXP results = PROTECT(Rf_allocVector(VECSXP,names.size()));
+  SEXP rnames = PROTECT(Rf_allocVector(STRSXP,names.size()));
+
+  const char * cn[] = {"pmean","pstd","pqu_l1_lower","pqu_l2_lower","pmed",
+                       "pqu_l2_upper","pqu_l1_upper"};
+
+  unsigned i,k;
+  for (i=0;i<names.size();i++)
+    {
+    SET_STRING_ELT(rnames,i,Rf_mkChar(names[i].strtochar()));
+
+    SEXP term = PROTECT(Rf_allocVector(VECSXP,2));
+    SEXP tnames = PROTECT(Rf_allocVector(STRSXP,2));
+    SET_STRING_ELT(tnames,0,Rf_mkChar("summary"));
+    SET_STRING_ELT(tnames,1,Rf_mkChar("samples"));
+    Rf_setAttrib(term,R_NamesSymbol,tnames);
+
+    SEXP s = PROTECT(matrix2R(summaries[i]));
+    SEXP dimnames = PROTECT(Rf_allocVector(VECSXP,2));
+    SEXP coln = PROTECT(Rf_allocVector(STRSXP,7));
+    for (k=0;k<7;k++)
+      SET_STRING_ELT(coln,k,Rf_mkChar(cn[k]));
+    SET_VECTOR_ELT(dimnames,1,coln);
+    if (labels[i].size() == unsigned(Rf_nrows(s)))
+      {
+      SEXP rown = PROTECT(Rf_allocVector(STRSXP,labels[i].size()));
+      for (k=0;k<labels[i].size();k++)
+        SET_STRING_ELT(rown,k,Rf_mkChar(labels[i][k].strtochar()));
+      SET_VECTOR_ELT(dimnames,0,rown);
+      UNPROTECT(1);
+      }
+    Rf_setAttrib(s,R_DimNamesSymbol,dimnames);
+
+    SET_VECTOR_ELT(term,0,s);
+    SET_VECTOR_ELT(term,1,matrix2R(samples[i]));
+    SET_VECTOR_ELT(results,i,term);
+
+    UNPROTECT(5);
+    }
+
+  Rf_setAttrib(results,R_NamesSymbol,rnames);
+
+  SEXP res = PROTECT(Rf_allocVector(VECSXP,3));
+  SEXP resnames = PROTECT(Rf_allocVector(STRSXP,3));
+  SET_STRING_ELT(resnames,0,Rf_mkChar("log"));
+  SET_STRING_ELT(resnames,1,Rf_mkChar("error"));
+  SET_STRING_ELT(resnames,2,Rf_mkChar("results"));
+  Rf_setAttrib(res,R_NamesSymbol,resnames);
+  SET_VECTOR_ELT(res,0,Rf_mkString(log.strtochar()));
+  SET_VECTOR_ELT(res,1,Rf_ScalarLogical(errors ? TRUE : FALSE));
+  SET_VECTOR_ELT(res,2,results);
+
+  UNPROTECT(4);
+  return res;
+  }
+
+
+static const R_CallMethodDef callmethods[] =
+  {
+  {"bayesx_inprocess", (DL_FUNC) &bayesx_inprocess, 4},
+  {NULL, NULL, 0}
+  };
+
+
+void R_init_BayesXsrc(DllInfo * dll)
+  {
+  R_registerRoutines(dll,NULL,callmethods,NULL,NULL);
+  R_useDynamicSymbols(dll,FALSE);
+  }
+
+} // end: extern "C"
+
@@ -95,6 +95,9 @@ DISTRIBUTION_multgaussian::DISTRIBUTION_multgaussian(const double & a,
   SIGMA_rmr = datamatrix(1,nrcat-1);
   SIGMA_mr = datamatrix(nrcat-1,nrcat-1);
 
+  offsetcoef = datamatrix(nrcat,nrcat-1);
+  compute_offsetcoef();
+
   }
 
 
@@ -108,6 +111,7 @@ const DISTRIBUTION_multgaussian & nd)
   sigma_rmr = nd.sigma_rmr;
   SIGMA_mr = nd.SIGMA_mr;
   SIGMA_rmr = nd.SIGMA_rmr;
+  offsetcoef = nd.offsetcoef;
   A = nd.A;
   B = nd.B;
   nrcat = nd.nrcat;
@@ -127,6 +131,7 @@ const DISTRIBUTION_multgaussian & nd)
   sigma_rmr = nd.sigma_rmr;
   SIGMA_mr = nd.SIGMA_mr;
   SIGMA_rmr = nd.SIGMA_rmr;
+  offsetcoef = nd.offsetcoef;
   A = nd.A;
   B = nd.B;
   nrcat = nd.nrcat;
@@ -231,58 +236,82 @@ void DISTRIBUTION_multgaussian::compute_SIGMA_mr(unsigned r)
   }
 
 
-void DISTRIBUTION_multgaussian::compute_offset(void)
+void DISTRIBUTION_multgaussian::compute_offsetcoef(unsigned r)
+  {
+
+  datamatrix help(1,nrcat-1);
+
+  help.mult(SIGMA_rmr,SIGMA_mr);
+
+  unsigned l;
+  double * workcoef = offsetcoef.getV()+r*(nrcat-1);
+  double * workhelp = help.getV();
+  for (l=0;l<nrcat-1;l++,workcoef++,workhelp++)
+    *workcoef = *workhelp;
+
+  }
+
+
+void DISTRIBUTION_multgaussian::compute_offsetcoef(void)
   {
 
   if (nrcat==2)
     {
+    offsetcoef(0,0) = scale(0,1)/scale(1,1);
+    offsetcoef(1,0) = scale(0,1)/scale(0,0);
+    }
+  else
+    {
+
+    unsigned r;
 
-    unsigned i;
-    double f1 = scale(0,1)/scale(1,1);
-    double f2 = scale(0,1)/scale(0,0);
-    for (i=0;i<nrobs;i++)
+    for (r=0;r<nrcat;r++)
       {
-      offset(i,0) = f1*(response(i,1)-(*linpred_current)(i,1));
-      offset(i,1) = f2*(response(i,0)-(*linpred_current)(i,0));
+      compute_SIGMA_rmr(r);
+      compute_SIGMA_mr(r);
+      compute_offsetcoef(r);
       }
 
     }
-  else
-    {
 
-    unsigned i,k,l,r;
+  }
 
-    datamatrix help(1,nrcat-1);
 
-    for (r=0;r<nrcat;r++)
-      {
+void DISTRIBUTION_multgaussian::compute_offset(const unsigned & r)
+  {
 
-      compute_SIGMA_rmr(r);
+  // the observations are independent blocks, the coefficients are computed
+  // only if Sigma changes (see compute_sigmarmr)
 
-      compute_SIGMA_mr(r);
+  double * workcoef = offsetcoef.getV()+r*(nrcat-1);
+  double * workresp = response.getV();
+  double * worklin = (*linpred_current).getV();
+  double * workoffset = offset.getV();
 
-      help.mult(SIGMA_rmr,SIGMA_mr);
+  int i;
 
-      double di;
+#if defined(_OPENMP)
+#pragma omp parallel for if(nrobs >= 1000)
+#endif
+  for (i=0;i<int(nrobs);i++)
+    {
+    unsigned k,l;
+    double o = 0;
+    double * respi = workresp+i*nrcat;
+    double * lini = worklin+i*nrcat;
 
-      for (i=0;i<nrobs;i++)
+    l = 0;
+    for (k=0;k<nrcat;k++)
+      {
+      if (k != r)
         {
+        o += workcoef[l]*(respi[k]-lini[k]);
+        l++;
+        } // end: if (k != r)
+      } //end: for (k=0;k<nrcat;k++)
 
-        offset(i,r) = 0;
-
-        l = 0;
-        for (k=0;k<nrcat;k++)
-          {
-          if (k != r)
-            {
-            di = response(i,k)-(*linpred_current)(i,k);
-            offset(i,r) += help(0,l)*di;
-            l++;
-            } // end: if (k != r)
-          } //end: for (k=0;k<nrcat;k++)
-        } // end: for (i=0;i<nrobs;i++)
-      } // end: for (r=0;r<offset.cols();r++)
-    }
+    workoffset[i*nrcat+r] = o;
+    } // end: for (i=0;i<nrobs;i++)
 
   } // end: compute_offset
 
@@ -292,24 +321,31 @@ void DISTRIBUTION_multgaussian::compute_IWproduct(void)
 
   diff.minus(response,*linpred_current);
 
-  unsigned i,j,k;
+  // sumB is symmetric, only the upper triangle is computed
 
-  double * sumBwork = sumB.getV();
-  double * diff1;
-  double * diff2;
+  int i;
 
-  for(i=0;i<sumB.rows();i++)
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if(nrobs >= 1000)
+#endif
+  for(i=0;i<int(nrcat);i++)
     {
-    for(j=0;j<sumB.cols();j++,sumBwork++)
+    unsigned j,k;
+    double sum;
+    double * diff1;
+    double * diff2;
+
+    for(j=i;j<nrcat;j++)
       {
-      *sumBwork = 0;
+      sum = 0;
       diff1 = diff.getV()+i;
       diff2 = diff.getV()+j;
 
-      for(k=0;k<nrobs;k++,diff1+=sumB.cols(),diff2+=sumB.cols())
-        *sumBwork +=  *diff1 * *diff2;
+      for(k=0;k<nrobs;k++,diff1+=nrcat,diff2+=nrcat)
+        sum +=  *diff1 * *diff2;
 
-      *sumBwork *= 0.5;
+      sumB(i,j) = 0.5*sum;
+      sumB(j,i) = sumB(i,j);
       }
     }
 
@@ -320,7 +356,7 @@ void DISTRIBUTION_multgaussian::compute_respminuslinpred(datamatrix & res,
 const unsigned & co)
   {
 
-  compute_offset();
+  compute_offset(co);
 
   unsigned i;
   double * reswork = res.getV();
@@ -340,6 +376,7 @@ void DISTRIBUTION_multgaussian::compute_sigmarmr(void)
     {
     sigma_rmr(0,0) = scale(0,0)-(scale(0,1)*scale(0,1))/scale(1,1);
     sigma_rmr(1,0) = scale(1,1)-(scale(0,1)*scale(0,1))/scale(0,0);
+    compute_offsetcoef();
     }
   else
     {
@@ -351,6 +388,7 @@ void DISTRIBUTION_multgaussian::compute_sigmarmr(void)
       {
       compute_SIGMA_mr(r);
       compute_SIGMA_rmr(r);
+      compute_offsetcoef(r);
       help = SIGMA_rmr*SIGMA_mr*SIGMA_rmr.transposed();
       sigma_rmr(r,0) = scale(r,r) - help(0,0);
       } // end: for (r=0;r<nrcat;r++)
@@ -389,6 +427,8 @@ bool DISTRIBUTION_multgaussian::posteriormode(void)
     sigma_rmr(j,0) = scale(j,j);
     }
 
+  compute_offsetcoef();
+
   bool res = true;
 
   return res;
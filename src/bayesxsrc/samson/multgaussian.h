@@ -43,6 +43,9 @@ class __EXPORT_TYPE DISTRIBUTION_multgaussian : public DISTRIBUTION
    datamatrix SIGMA_mr;         // Sigma_-r
    datamatrix SIGMA_rmr;        // Sigma_r|-r (row vector)
    datamatrix sigma_rmr;        // column vector of sigma^2_r | -r
+   datamatrix offsetcoef;       // r-th row stores the coefficients
+                                // SIGMA_r|-r * (SIGMA_-r)^-1 of the offset
+                                // o_r|-r, recomputed only if Sigma changes
 
    datamatrix offset;           // stores the offsets in a nrobs x nrcat matrix
                                 // i -th row corresponds to i-th observation
@@ -70,17 +73,30 @@ class __EXPORT_TYPE DISTRIBUTION_multgaussian : public DISTRIBUTION
 
    void compute_SIGMA_rmr(unsigned r);
 
+   // FUNCTION: compute_offsetcoef
+   // TASK: computes row r of 'offsetcoef' (k > 2)
+   //       SIGMA_rmr and SIGMA_mr must already be computed for r
+
+   void compute_offsetcoef(unsigned r);
+
+   // FUNCTION: compute_offsetcoef
+   // TASK: computes the coefficients of the offsets of all components
+
+   void compute_offsetcoef(void);
+
   // FUNCTION: compute_sigmarmr
   // TASK: computes for r=1,...,k: sigma2_r|-r =
   //       sigma2_r - SIGMA_r|-r * (SIGMA_-r)^-1 * (SIGMA_r|-r)'
   //       stores the results in the column vector sigma_rmr
+  //       the coefficients of the offsets are updated as well
 
   void compute_sigmarmr(void);
 
   // FUNCTION: compute_offset
-  // TASK computes the offset and stores it in the matrix 'offset'
+  // TASK computes the offset o_r|-r of component r and stores it in
+  //      column r of the matrix 'offset'
 
-  void compute_offset(void);
+  void compute_offset(const unsigned & r);
 
   // FUNCTION: standardise
   // TASK: standarizes the response
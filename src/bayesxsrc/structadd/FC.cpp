@@ -22,10 +22,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "FC.h"
 #include "clstring.h"
+#include "binary_output.h"
+#include <algorithm>
 
 using std::ofstream;
 using std::ifstream;
 using std::ios;
+using std::nth_element;
+using std::sort;
 
 //------------------------------------------------------------------------------
 //----------------- CLASS: FC implementation of member functions ---------------
@@ -42,7 +46,19 @@ void FC::read_options(vector<ST::string> & op,vector<ST::string> & vn)
 
 FC::FC(void)
   {
+  optionsp = NULL;
   this->nosamples = false;
+  nosamplessave = false;
+  addon = 0;
+  acceptance = 0;
+  nrtrials = 0;
+  outsidelinpredlimits = 0;
+  propscale = 1;
+  adaptive = false;
+  acceptanceburnin = 0;
+  nrtrialsburnin = 0;
+  meaneffect = 0;
+  monitor = true;
   }
 
 
@@ -69,6 +85,10 @@ FC::FC(GENERAL_OPTIONS * o,const ST::string & t,const unsigned & rows,
   acceptance = 0;
   nrtrials = 0;
   outsidelinpredlimits = 0;
+  propscale = 1;
+  adaptive = false;
+  acceptanceburnin = 0;
+  nrtrialsburnin = 0;
 
   column = 0;
 
@@ -76,6 +96,8 @@ FC::FC(GENERAL_OPTIONS * o,const ST::string & t,const unsigned & rows,
 
   meaneffect = 0;
 
+  monitor = true;
+
   check_errors();
   }
 
@@ -120,11 +142,18 @@ FC::FC(const FC & m)
   acceptance = m.acceptance;
   nrtrials = m.nrtrials;
   outsidelinpredlimits = m.outsidelinpredlimits;
+  propscale = m.propscale;
+  adaptive = m.adaptive;
+  acceptanceburnin = m.acceptanceburnin;
+  nrtrialsburnin = m.nrtrialsburnin;
 
   column = m.column;
 
   meaneffect = m.meaneffect;
 
+  monitor = m.monitor;
+  diagnostics = m.diagnostics;
+
   errors = m.errors;
   errormessages = m.errormessages;
 
@@ -176,11 +205,18 @@ const FC & FC::operator=(const FC & m)
   acceptance = m.acceptance;
   nrtrials = m.nrtrials;
   outsidelinpredlimits = m.outsidelinpredlimits;
+  propscale = m.propscale;
+  adaptive = m.adaptive;
+  acceptanceburnin = m.acceptanceburnin;
+  nrtrialsburnin = m.nrtrialsburnin;
 
   column = m.column;
 
   meaneffect = m.meaneffect;
 
+  monitor = m.monitor;
+  diagnostics = m.diagnostics;
+
   errors = m.errors;
   errormessages = m.errormessages;
 
@@ -420,6 +456,39 @@ void FC::get_samples(const ST::string & filename,ofstream & outg) const
 
     unsigned nrpar = beta.rows()*beta.cols();
 
+    if (optionsp->binaryoutput)
+      {
+      // one float64 column per parameter, no visualization commands since
+      // the Windows version of BayesX cannot read binary files
+
+      ST::string filenameb = filename.substr(0,filename.length()-4) + ".bin";
+
+      binary_output outb(filenameb,optionsp->samplesize);
+      vector<ST::string> colnames;
+      if (beta.cols() > 1)
+        {
+        for (j=0;j<beta.rows();j++)
+          for(k=0;k<beta.cols();k++)
+            colnames.push_back("b_" + ST::inttostring(j+1) + "_" +
+                               ST::inttostring(k+1));
+        }
+      else
+        {
+        for (j=0;j<nrpar;j++)
+          colnames.push_back("b_" + ST::inttostring(j+1));
+        }
+
+      for (j=0;j<nrpar;j++)
+        outb.add_column(colnames[j],sampled_beta.getV()+j,nrpar);
+
+      if (outb.write())
+        optionsp->out("ERROR: unable to write file " + filenameb + "\n",true,true);
+      else
+        optionsp->out(filenameb + "\n");
+
+      return;
+      }
+
     ofstream out(filename.strtochar());
     assert(!out.fail());
 
@@ -445,7 +514,7 @@ void FC::get_samples(const ST::string & filename,ofstream & outg) const
       for (j=0;j<nrpar;j++,sampled_betap++)
         out << *sampled_betap << " ";
 
-      out << endl;
+      out << "\n";
       }
 
     out.close();
@@ -496,6 +565,22 @@ void FC::update(void)
      sampled_beta = datamatrix(ssize,npar,0);
      }
 
+    if ((samplesize==1) && (optionsp->convdiag || optionsp->inmemory))
+      optionsp->storedFC.push_back(this);
+
+    if (optionsp->convdiag)
+      {
+      if (samplesize==1)
+        {
+        if (monitor && (nosamples == false) && (title != ""))
+          diagnostics = convergence_diagnostics(beta.rows()*beta.cols(),
+                                                optionsp->diaglag);
+        else
+          diagnostics = convergence_diagnostics();
+        }
+      diagnostics.update(beta.getV(),addon);
+      }
+
 
     double betatransform;
 
@@ -654,6 +739,21 @@ void FC::update(void)
     optionsp->out("  Maximum:            " + ST::doubletostring(diffmax,6) + "\n");
 
     optionsp->out("\n");
+
+    if (optionsp->convdiag && diagnostics.ready())
+      {
+      optionsp->out("  Convergence diagnostics  \n");
+      optionsp->out("\n");
+      optionsp->out("  Minimum ESS:        " +
+                    ST::doubletostring(diagnostics.min_ess(),6) + "\n");
+      optionsp->out("  Maximum R-hat:      " +
+                    ST::doubletostring(diagnostics.max_rhat(),6) + "\n");
+      optionsp->out("  Maximum |Geweke z|: " +
+                    ST::doubletostring(diagnostics.max_geweke(),6) + "\n");
+      optionsp->out("  Maximum |ACF(1)|:   " +
+                    ST::doubletostring(diagnostics.max_autocorr(1),6) + "\n");
+      optionsp->out("\n");
+      }
     optionsp->out("\n");
 
     betameanold.assign(betamean);
@@ -727,6 +827,19 @@ void FC::outresults_acceptance(void)
       rate = (double(acceptance)/double(nrtrials))*100;
       }
     optionsp->out("    Acceptance rate:    "  + ST::doubletostring(rate,4) + " %\n");
+    if (adaptive)
+      {
+      if (nrtrials == 0)
+        rate = (double(acceptance-acceptanceburnin)/
+               double(optionsp->nriter-optionsp->burnin))*100;
+      else
+        rate = (double(acceptance-acceptanceburnin)/
+               double(nrtrials-nrtrialsburnin))*100;
+      optionsp->out("    Acceptance rate after burnin: "  +
+                    ST::doubletostring(rate,4) + " %\n");
+      optionsp->out("    Adapted proposal scale:       "  +
+                    ST::doubletostring(propscale,4) + "\n");
+      }
     if (optionsp->saveestimation)
       {
       if (outsidelinpredlimits > 0)
@@ -740,6 +853,46 @@ void FC::outresults_acceptance(void)
 
 
 
+void FC::adapt_propscale(double acc)
+  {
+  if (optionsp->adaptiwls)
+    {
+    adaptive = true;
+
+    if (optionsp->nriter <= optionsp->burnin)
+      {
+      propscale *= exp(pow(double(optionsp->nriter),-0.6)*
+                       (acc-optionsp->targetacceptance));
+      if (propscale > 1)
+        propscale = 1;
+      else if (propscale < 0.001)
+        propscale = 0.001;
+      }
+
+    if (optionsp->nriter == optionsp->burnin)
+      {
+      acceptanceburnin = acceptance;
+      nrtrialsburnin = nrtrials;
+      }
+    }
+  }
+
+
+void FC::shrink_proposalmean(datamatrix & mean,const datamatrix & current)
+  {
+  if (propscale < 1)
+    {
+    double shrink = sqrt(1-propscale*propscale);
+    double * meanp = mean.getV();
+    double * currentp = current.getV();
+    unsigned i;
+    unsigned n = mean.rows()*mean.cols();
+    for (i=0;i<n;i++,meanp++,currentp++)
+      *meanp += shrink*(*currentp - *meanp);
+    }
+  }
+
+
 double FC::simconfBand(bool l1)
   {
   unsigned i,j;
@@ -973,18 +1126,193 @@ void FC::outresults_help(ofstream & out_stata, ofstream & out_R,
 
     }
 
+  if ((optionsp->binaryoutput) && (pathresults.isvalidfile() != 1) &&
+      (nr == beta.rows()))
+    outresults_binary(pathresults.substr(0,pathresults.length()-4) + ".bin",
+                      "varname",vnames,col);
+
   optionsp->out("\n");
 
   }
 
 
+void FC::outresults_binary(const ST::string & path,const ST::string & varname,
+                           const vector<ST::string> & vnames,
+                           unsigned col) const
+  {
+
+  unsigned nr = beta.rows();
+  unsigned nc = beta.cols();
+
+  if ((optionsp->samplesize == 0) || (nr == 0))
+    return;
+
+  ST::string l1 = ST::doubletostring(optionsp->lower1,4);
+  ST::string l2 = ST::doubletostring(optionsp->lower2,4);
+  ST::string u1 = ST::doubletostring(optionsp->upper1,4);
+  ST::string u2 = ST::doubletostring(optionsp->upper2,4);
+  l1 = l1.replaceallsigns('.','p');
+  l2 = l2.replaceallsigns('.','p');
+  u1 = u1.replaceallsigns('.','p');
+  u2 = u2.replaceallsigns('.','p');
+
+  datamatrix stddev(nr,1);
+  unsigned i;
+  for (i=0;i<nr;i++)
+    {
+    if (betavar(i,col) < 0.0000000000001)
+      stddev(i,0) = 0;
+    else
+      stddev(i,0) = sqrt(betavar(i,col));
+    }
+
+  binary_output outb(path,nr);
+
+  outb.add_index("intnr");
+  if (vnames.size() == nr)
+    outb.add_column(varname,vnames);
+  outb.add_column("pmean",betamean.getV()+col,nc);
+
+  if (optionsp->samplesize > 1)
+    {
+    outb.add_column("pstd",stddev.getV());
+    if (nosamplessave == false)
+      {
+      outb.add_column("pqu" + l1,betaqu_l1_lower.getV()+col,nc);
+      outb.add_column("pqu" + l2,betaqu_l2_lower.getV()+col,nc);
+      outb.add_column("pmed",betaqu50.getV()+col,nc);
+      outb.add_column("pqu" + u1,betaqu_l2_upper.getV()+col,nc);
+      outb.add_column("pqu" + u2,betaqu_l1_upper.getV()+col,nc);
+      }
+    }
+
+  if (outb.write())
+    optionsp->out("ERROR: unable to write file " + path + "\n",true,true);
+
+  }
+
+
+
+void FC::compute_quantiles(void)
+  {
+
+  if ((optionsp->samplesize == 0) || (nosamplessave==true))
+    return;
+
+  int nrpar=beta.rows()*beta.cols();
+  unsigned n = sampled_beta.rows();
+
+  double percent[5] = {optionsp->lower1,optionsp->lower2,50,
+                       optionsp->upper1,optionsp->upper2};
+  double * qu[5] = {betaqu_l1_lower.getV(),betaqu_l2_lower.getV(),
+                    betaqu50.getV(),betaqu_l2_upper.getV(),
+                    betaqu_l1_upper.getV()};
+
+  // blocks of parameters are copied into column major buffers, the order
+  // statistics of each column are then found by selection (nth_element)
+  // instead of sorting; blocks are processed in parallel if compiled with
+  // OpenMP
+
+  const int blocksize = 32;
+  int nrblocks = (nrpar+blocksize-1)/blocksize;
+  int b;
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (b=0;b<nrblocks;b++)
+    {
+    int first = b*blocksize;
+    int nrcols = (nrpar-first < blocksize) ? nrpar-first : blocksize;
+
+    vector<double> buffer(n*nrcols);
+
+    unsigned i;
+    int j;
+    double * rowp;
+    for (i=0;i<n;i++)
+      {
+      rowp = sampled_beta.getV()+i*nrpar+first;
+      for (j=0;j<nrcols;j++,rowp++)
+        buffer[j*n+i] = *rowp;
+      }
+
+    double q[5];
+    unsigned l;
+    for (j=0;j<nrcols;j++)
+      {
+      column_quantiles(&buffer[j*n],n,percent,5,q);
+      for (l=0;l<5;l++)
+        qu[l][first+j] = q[l];
+      }
+
+    }
+
+  }
+
+
+void FC::column_quantiles(double * x,const unsigned & n,
+                          const double * percent,const unsigned & nrq,
+                          double * q)
+  {
+
+  // required order statistics, definition of the quantiles as in
+  // statmatrix<T>::quantile
+
+  vector<unsigned> pos;
+  unsigned l;
+  for (l=0;l<nrq;l++)
+    {
+    double k = n*(percent[l]/100.0);
+    unsigned kganz = unsigned(k);
+    if (kganz == 0)
+      pos.push_back(0);
+    else if (kganz == n)
+      pos.push_back(n-1);
+    else if (k == kganz)
+      {
+      pos.push_back(kganz-1);
+      pos.push_back(kganz);
+      }
+    else
+      pos.push_back(kganz);
+    }
+
+  sort(pos.begin(),pos.end());
+
+  // successive selection, x[pos[m]] is the pos[m]-th smallest value
+
+  unsigned start = 0;
+  for (l=0;l<pos.size();l++)
+    {
+    if (pos[l] >= start)
+      {
+      nth_element(x+start,x+pos[l],x+n);
+      start = pos[l]+1;
+      }
+    }
+
+  for (l=0;l<nrq;l++)
+    {
+    double k = n*(percent[l]/100.0);
+    unsigned kganz = unsigned(k);
+    if (kganz == 0)
+      q[l] = x[0];
+    else if (kganz == n)
+      q[l] = x[n-1];
+    else if (k == kganz)
+      q[l] = (x[kganz-1]+x[kganz])/2.0;
+    else
+      q[l] = x[kganz];
+    }
+
+  }
+
 
 void FC::outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                     const ST::string & pathresults)
   {
 
-  unsigned nrpar=beta.rows()*beta.cols();
-
   if (title != "")
     {
     optionsp->out("\n");
@@ -996,29 +1324,7 @@ void FC::outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2Bay
   if (optionsp->samplesize > 0)
     {
 
-    unsigned i;
-
-    statmatrix<int> index(sampled_beta.rows(),1);
-
-    double* wqu1l = betaqu_l1_lower.getV();
-    double* wqu2l = betaqu_l2_lower.getV();
-    double* wqu50 = betaqu50.getV();
-    double* wqu1u = betaqu_l2_upper.getV();
-    double* wqu2u = betaqu_l1_upper.getV();
-
-    if (nosamplessave==false)
-      {
-      for(i=0;i<nrpar;i++,wqu1l++,wqu2l++,wqu50++,wqu1u++,wqu2u++)
-        {
-        index.indexinit();
-        sampled_beta.indexsort(index,0,sampled_beta.rows()-1,i,0);
-        *wqu1l = sampled_beta.quantile(optionsp->lower1,i,index);
-        *wqu2l = sampled_beta.quantile(optionsp->lower2,i,index);
-        *wqu50 = sampled_beta.quantile(50,i,index);
-        *wqu1u = sampled_beta.quantile(optionsp->upper1,i,index);
-        *wqu2u = sampled_beta.quantile(optionsp->upper2,i,index);
-        }
-      }
+    compute_quantiles();
 
     if (pathresults.isvalidfile() != 1)
       {
@@ -1129,6 +1435,10 @@ void FC::outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2Bay
 
         }
 
+      if (optionsp->binaryoutput)
+        outresults_binary(pathresults.substr(0,pathresults.length()-4) +
+                          ".bin","",vector<ST::string>());
+
       }
 
     }  // if (optionsp->get_samplesize() > 0)
@@ -1194,6 +1504,10 @@ void FC::outresults_singleparam(ofstream & out_stata,ofstream & out_R,
   if (pathresults.isvalidfile() != 1)
     {
 
+    if (optionsp->binaryoutput)
+      outresults_binary(pathresults.substr(0,pathresults.length()-4) +
+                        ".bin","",vector<ST::string>());
+
     ofstream ou(pathresults.strtochar());
 
     if (optionsp->samplesize > 1)
@@ -1226,12 +1540,150 @@ void FC::outresults_singleparam(ofstream & out_stata,ofstream & out_R,
 
 
 
+void FC::outresults_diagnostics(ofstream & out)
+  {
+  if (diagnostics.get_nrpar() > 0)
+    {
+    unsigned j,l;
+    unsigned nl = diagnostics.get_nrlags();
+    ST::string t = title.replaceallsigns(' ','_');
+    for (j=0;j<diagnostics.get_nrpar();j++)
+      {
+      out << t << "   " << (j+1) << "   ";
+      out << diagnostics.ess(j) << "   ";
+      out << diagnostics.rhat(j) << "   ";
+      out << diagnostics.geweke(j) << "   ";
+      for (l=1;l<=nl;l++)
+        out << diagnostics.autocorr(j,l) << "   ";
+      out << endl;
+      }
+    }
+  }
+
+
+void FC::truncate_samples(void)
+  {
+  if ((optionsp != NULL) && (nosamplessave == false) &&
+      (optionsp->samplesize > 0) &&
+      (sampled_beta.rows() > optionsp->samplesize))
+    {
+    datamatrix h = sampled_beta.getRowBlock(0,optionsp->samplesize);
+    sampled_beta = h;
+    }
+  }
+
+
+void FC::write_state(ofstream & out)
+  {
+  save_value(out,beta);
+  save_value(out,beta_mode);
+  save_value(out,betamean);
+  save_value(out,betas2);
+  save_value(out,betavar);
+  save_value(out,betamin);
+  save_value(out,betamax);
+  save_value(out,betameanold);
+  save_value(out,betavarold);
+  save_value(out,betaminold);
+  save_value(out,betamaxold);
+  save_value(out,sampled_beta);
+  save_value(out,addon);
+  save_value(out,acceptance);
+  save_value(out,nrtrials);
+  save_value(out,outsidelinpredlimits);
+  save_value(out,propscale);
+  save_value(out,adaptive);
+  save_value(out,acceptanceburnin);
+  save_value(out,nrtrialsburnin);
+  save_value(out,meaneffect);
+
+  int pos = -1;
+  unsigned i;
+  if (optionsp != NULL)
+    for (i=0;i<optionsp->storedFC.size();i++)
+      if (optionsp->storedFC[i] == this)
+        pos = i;
+  save_value(out,pos);
+  if (pos >= 0)
+    diagnostics.write_state(out);
+  }
+
+
+void FC::read_state(ifstream & in)
+  {
+  unsigned rows = beta.rows();
+  unsigned cols = beta.cols();
+
+  load_value(in,beta);
+  if ((beta.rows() != rows) || (beta.cols() != cols))
+    {
+    in.setstate(std::ios::failbit);
+    return;
+    }
+
+  load_value(in,beta_mode);
+  load_value(in,betamean);
+  load_value(in,betas2);
+  load_value(in,betavar);
+  load_value(in,betamin);
+  load_value(in,betamax);
+  load_value(in,betameanold);
+  load_value(in,betavarold);
+  load_value(in,betaminold);
+  load_value(in,betamaxold);
+  load_value(in,sampled_beta);
+  load_value(in,addon);
+  load_value(in,acceptance);
+  load_value(in,nrtrials);
+  load_value(in,outsidelinpredlimits);
+  load_value(in,propscale);
+  load_value(in,adaptive);
+  load_value(in,acceptanceburnin);
+  load_value(in,nrtrialsburnin);
+  load_value(in,meaneffect);
+
+  int pos;
+  load_value(in,pos);
+  if (pos >= 0)
+    diagnostics.read_state(in);
+  if ((pos >= 0) && (optionsp != NULL))
+    {
+    if (optionsp->storedFC.size() <= unsigned(pos))
+      optionsp->storedFC.resize(pos+1,NULL);
+    optionsp->storedFC[pos] = this;
+    }
+
+  // enlarge storage for samples if the chain is extended
+
+  if ((optionsp != NULL) && (nosamplessave == false) &&
+      (optionsp->samplesize > 0) &&
+      (sampled_beta.rows() > 0))
+    {
+    unsigned ssize = optionsp->compute_samplesize();
+    if (sampled_beta.rows() < ssize)
+      {
+      datamatrix h(ssize,sampled_beta.cols(),0);
+      double * hp = h.getV();
+      double * sp = sampled_beta.getV();
+      unsigned k;
+      unsigned n = sampled_beta.rows()*sampled_beta.cols();
+      for (k=0;k<n;k++,hp++,sp++)
+        *hp = *sp;
+      sampled_beta = h;
+      }
+    }
+  }
+
+
 void FC::reset(void)
   {
 
   setbeta(beta.rows(),beta.cols(),0);
   acceptance = 0;
   nrtrials = 0;
+  propscale = 1;
+  acceptanceburnin = 0;
+  nrtrialsburnin = 0;
   }
 
 
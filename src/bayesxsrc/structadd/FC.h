@@ -33,6 +33,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include<vector>
 #include<bitset>
 #include"GENERAL_OPTIONS.h"
+#include"convergence_diagnostics.h"
+#include"checkpoint.h"
 #include"clstring.h"
 #include<cmath>
 
@@ -111,6 +113,14 @@ class __EXPORT_TYPE FC
   unsigned long outsidelinpredlimits;  // number of iterations outside
                                        // linpredlimits
 
+  double propscale;                    // scale factor of IWLS proposals,
+                                       // adapted during the burnin if
+                                       // adaptiwls is specified
+                                       // DEFAULT: propscale = 1
+  bool adaptive;                       // propscale is adapted
+  unsigned long acceptanceburnin;      // accepted iterations in the burnin
+  unsigned long nrtrialsburnin;        // number of trials in the burnin
+
 
 
   unsigned column;               // the response category the fc belongs to
@@ -119,6 +129,13 @@ class __EXPORT_TYPE FC
   double meaneffect;            // for results in original scale
 
 
+  bool monitor;                  // parameters are monitored by the online
+                                 // convergence diagnostics (if enabled),
+                                 // full conditionals without title or with
+                                 // nosamples = true are never monitored
+  convergence_diagnostics diagnostics;
+
+
   //----------------------------------------------------------------------------
   //------------------------------ ERRORS --------------------------------------
   //----------------------------------------------------------------------------
@@ -266,6 +283,20 @@ class __EXPORT_TYPE FC
 
   double simconfBand(bool l1);
 
+  // FUNCTION: compute_quantiles
+  // TASK: computes the posterior quantiles (betaqu50, betaqu_l1_lower etc.)
+  //       from the stored samples
+
+  void compute_quantiles(void);
+
+  // FUNCTION: column_quantiles
+  // TASK: computes the 'percent[l]' percent quantiles (l=0,...,nrq-1) of
+  //       x[0],...,x[n-1] and stores them in q, x is partially reordered
+
+  static void column_quantiles(double * x,const unsigned & n,
+                               const double * percent,const unsigned & nrq,
+                               double * q);
+
   // FUNCTION: outresults
   // TASK: writes estimation results to logout or into a file
 
@@ -280,6 +311,16 @@ class __EXPORT_TYPE FC
                     const vector<ST::string> & datanames,
                     unsigned col=0);
 
+  // FUNCTION: outresults_binary
+  // TASK: writes posterior means, standard deviations and quantiles of
+  //       column 'col' of beta to the binary file 'path' (see
+  //       binary_output). If 'vnames' is not empty, it is stored as an
+  //       additional column 'varname'.
+
+  void outresults_binary(const ST::string & path,const ST::string & varname,
+                         const vector<ST::string> & vnames,
+                         unsigned col=0) const;
+
 
   // FUNCTION: outresults_singleparam
   // TASK: writes results for FC's ewith just one parameter
@@ -290,6 +331,49 @@ class __EXPORT_TYPE FC
 
   void outresults_acceptance(void);
 
+  // FUNCTION: adapt_propscale
+  // TASK: Robbins-Monro update of the scale factor of IWLS proposals during
+  //       the burnin, acc is the proportion of accepted proposals in the
+  //       current iteration. The scale factor is restricted to (0,1], i.e.
+  //       propscale = 1 corresponds to the usual IWLS proposal
+
+  void adapt_propscale(double acc);
+
+  // FUNCTION: shrink_proposalmean
+  // TASK: moves the mean of an IWLS proposal towards the current value
+  //       'current' if propscale < 1, i.e.
+  //       mean = mean + sqrt(1-propscale^2)*(current-mean). Together with the
+  //       proposal covariance scaled by propscale^2 this is a Crank-Nicolson
+  //       type proposal that is local for small propscale and still exact
+  //       for gaussian full conditionals
+
+  void shrink_proposalmean(datamatrix & mean,const datamatrix & current);
+
+  // FUNCTION: outresults_diagnostics
+  // TASK: writes online convergence diagnostics of all parameters to 'out'
+
+  void outresults_diagnostics(ofstream & out);
+
+  // FUNCTION: truncate_samples
+  // TASK: removes storage for samples that have not been drawn (after the
+  //       simulation has been stopped early)
+
+  void truncate_samples(void);
+
+  // FUNCTION: write_state
+  // TASK: writes the current state of the full conditional (parameters,
+  //       running summaries, stored samples, counters) to a binary snapshot
+  //       derived classes with additional state must call FC::write_state
+  //       first
+
+  virtual void write_state(ofstream & out);
+
+  // FUNCTION: read_state
+  // TASK: restores the state written by write_state, errors are reported
+  //       via the state of 'in' (in.fail() == true)
+
+  virtual void read_state(ifstream & in);
+
   // FUNCTION: reset
   // TASK: resets all parameters
 
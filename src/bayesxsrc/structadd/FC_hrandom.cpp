@@ -211,6 +211,14 @@ void FC_hrandom::update_IWLS(void)
   double u;
   double xwres;
 
+  // proposals are shrunken towards the current value if the scale factor
+  // propscale is adapted (propscale = 1: IWLS proposal),
+  // see FC::shrink_proposalmean
+
+  double propvar = propscale*propscale;
+  double shrink = sqrt(1-propvar);
+  unsigned long acceptanceold = acceptance;
+
 
   likep->compute_iwls(true,likelihoodc,designp->ind);
 
@@ -234,15 +242,14 @@ void FC_hrandom::update_IWLS(void)
 
       var = 1/(*workWsum+lambda);
       postmode =  var * xwres;
-      *betap = postmode + sqrt(var)*rand_normal();
+      postmode += shrink*(*betap - postmode);
+      *betap = postmode + propscale*sqrt(var)*rand_normal();
       diff = *betap - postmode;
-      *worklikelihoodc += -1.0/(2*var)* pow(diff,2)-0.5*log(var);
+      *worklikelihoodc += -1.0/(2*propvar*var)* pow(diff,2)-0.5*log(var);
       }
     }
   else
     {
-    datamatrix pmodemat(beta.rows(),1,0);
-    datamatrix varmat(beta.rows(),1,0);
     double * pmodematp = pmodemat.getV();
     double * varp = varmat.getV();
 
@@ -256,8 +263,9 @@ void FC_hrandom::update_IWLS(void)
       xwres =  lambda*(*linpredREp)+ (*workpartres);
       *varp = 1/(*workWsum+lambda);
       *pmodematp =  *varp * xwres;
+      *pmodematp += shrink*(*betap - *pmodematp);
 
-      *betap = *pmodematp + sqrt(*varp)*rand_normal();
+      *betap = *pmodematp + propscale*sqrt(*varp)*rand_normal();
 
       }
 
@@ -287,7 +295,7 @@ void FC_hrandom::update_IWLS(void)
     for (i=0;i<beta.rows();i++,betap++,worklikelihoodc++,pmodematp++,varp++)
       {
       diff = *betap - *pmodematp;
-      *worklikelihoodc += -1.0/(2*(*varp))* pow(diff,2)-0.5*log((*varp));
+      *worklikelihoodc += -1.0/(2*propvar*(*varp))* pow(diff,2)-0.5*log((*varp));
       }
 
     }
@@ -348,9 +356,11 @@ void FC_hrandom::update_IWLS(void)
 
 
       var = 1/(*workWsum+lambda);
-      diff = *betaoldp - var * xwres;
+      postmode = var * xwres;
+      postmode += shrink*(*betap - postmode);
+      diff = *betaoldp - postmode;
 
-      *worklikelihoodn += -1.0/(2*var)* pow(diff,2)-0.5*log(var);
+      *worklikelihoodn += -1.0/(2*propvar*var)* pow(diff,2)-0.5*log(var);
 
 
       nrtrials++;
@@ -375,6 +385,8 @@ void FC_hrandom::update_IWLS(void)
 
   designp->update_linpred(betadiff);
 
+  adapt_propscale(double(acceptance-acceptanceold)/double(beta.rows()));
+
   FC::update();
 
   }
@@ -748,6 +760,28 @@ void FC_hrandom::outgraphs(ofstream & out_stata, ofstream & out_R, ofstream & ou
   }
 
 
+void FC_hrandom::write_state(ofstream & out)
+  {
+  FC_nonp::write_state(out);
+  save_value(out,simplerandom_linpred);
+  save_value(out,beta_prior);
+  save_value(out,response_o);
+  save_value(out,linpred_o);
+  FCrcoeff.write_state(out);
+  }
+
+
+void FC_hrandom::read_state(ifstream & in)
+  {
+  FC_nonp::read_state(in);
+  load_value(in,simplerandom_linpred);
+  load_value(in,beta_prior);
+  load_value(in,response_o);
+  load_value(in,linpred_o);
+  FCrcoeff.read_state(in);
+  }
+
+
 void FC_hrandom::outresults(ofstream & out_stata,ofstream & out_R, ofstream & out_R2BayesX,
                             const ST::string & pathresults)
   {
@@ -856,6 +890,18 @@ void FC_hrandom::outresults(ofstream & out_stata,ofstream & out_R, ofstream & ou
       optionsp->out("\n");
       }
 
+    // binary files: total effects and random coefficients
+
+    if (optionsp->binaryoutput)
+      {
+      ST::string effname = designp->datanames[designp->datanames.size()-1];
+      outresults_binary(pathresults.substr(0,pathresults.length()-4) +
+                        ".bin",effname,designp->effectvalues);
+      FCrcoeff.outresults_binary(pathresults.substr(0,
+                                 pathresults.length()-4) + "_rcoeff.bin",
+                                 effname,designp->effectvalues);
+      }
+
 
     ofstream outres(pathresults.strtochar());
 
@@ -1263,6 +1309,22 @@ void FC_hrandom_distributional::outgraphs(ofstream & out_stata, ofstream & out_R
   FC_hrandom::outgraphs(out_stata, out_R, out_R2BayesX, path);
   }
 
+void FC_hrandom_distributional::write_state(ofstream & out)
+  {
+  FC_hrandom::write_state(out);
+  save_value(out,offset_RE);
+  save_value(out,offsetold_RE);
+  }
+
+
+void FC_hrandom_distributional::read_state(ifstream & in)
+  {
+  FC_hrandom::read_state(in);
+  load_value(in,offset_RE);
+  load_value(in,offsetold_RE);
+  }
+
+
 void FC_hrandom_distributional::outresults(ofstream & out_stata,ofstream & out_R, ofstream & out_R2BayesX,
                             const ST::string & pathresults)
   {
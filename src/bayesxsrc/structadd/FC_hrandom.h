@@ -157,6 +157,13 @@ class __EXPORT_TYPE FC_hrandom  : public FC_nonp
   //-------------------- End: For Cross Validation stuff -----------------------
   //----------------------------------------------------------------------------
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 // -----------------------------------------------------------------//
@@ -227,6 +234,13 @@ class __EXPORT_TYPE FC_hrandom_distributional  : public FC_hrandom
 
   void read_options(vector<ST::string> & op,vector<ST::string> & vn);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 } // end: namespace MCMC
@@ -202,6 +202,20 @@ bool FC_hrandom_variance::posteriormode(void)
   }
 
 
+void FC_hrandom_variance::write_state(ofstream & out)
+  {
+  FC_nonp_variance::write_state(out);
+  save_value(out,simplerandom_linpred);
+  }
+
+
+void FC_hrandom_variance::read_state(ifstream & in)
+  {
+  FC_nonp_variance::read_state(in);
+  load_value(in,simplerandom_linpred);
+  }
+
+
 void FC_hrandom_variance::outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                          const ST::string & pathresults)
   {
@@ -381,6 +395,24 @@ void FC_hrandom_variance_ssvs::update(void)
   }
 
 
+void FC_hrandom_variance_ssvs::write_state(ofstream & out)
+  {
+  FC_hrandom_variance::write_state(out);
+  save_value(out,pen);
+  FC_delta.write_state(out);
+  FC_omega.write_state(out);
+  }
+
+
+void FC_hrandom_variance_ssvs::read_state(ifstream & in)
+  {
+  FC_hrandom_variance::read_state(in);
+  load_value(in,pen);
+  FC_delta.read_state(in);
+  FC_omega.read_state(in);
+  }
+
+
 void FC_hrandom_variance_ssvs::outoptions(void)
   {
 
@@ -111,6 +111,12 @@ class __EXPORT_TYPE FC_hrandom_variance  : public FC_nonp_variance
   void outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                          const ST::string & pathresults);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
 
   };
 
@@ -194,6 +200,12 @@ class __EXPORT_TYPE FC_hrandom_variance_ssvs
   void compute_autocorr_all(const ST::string & path,
                                       unsigned lag, ofstream & outg) const;
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
 
   };
 
@@ -168,6 +168,20 @@ bool FC_hrandom_variance_vec::posteriormode(void)
   }
 
 
+void FC_hrandom_variance_vec::write_state(ofstream & out)
+  {
+  FC_nonp_variance_vec::write_state(out);
+  save_value(out,hyperLambda);
+  }
+
+
+void FC_hrandom_variance_vec::read_state(ifstream & in)
+  {
+  FC_nonp_variance_vec::read_state(in);
+  load_value(in,hyperLambda);
+  }
+
+
 
 
 
@@ -96,6 +96,13 @@ class __EXPORT_TYPE FC_hrandom_variance_vec  : public FC_nonp_variance_vec
 
   bool posteriormode(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   // void transform_beta(void);
 
   void read_options(vector<ST::string> & op,vector<ST::string> & vn);
@@ -208,6 +208,24 @@ void FC_hrandom_variance_vec_nmig::update(void)
   }
 
 
+void FC_hrandom_variance_vec_nmig::write_state(ofstream & out)
+  {
+  FC_hrandom_variance_vec::write_state(out);
+  FC_delta.write_state(out);
+  FC_omega.write_state(out);
+  FC_Q.write_state(out);
+  }
+
+
+void FC_hrandom_variance_vec_nmig::read_state(ifstream & in)
+  {
+  FC_hrandom_variance_vec::read_state(in);
+  FC_delta.read_state(in);
+  FC_omega.read_state(in);
+  FC_Q.read_state(in);
+  }
+
+
 void FC_hrandom_variance_vec_nmig::outresults(ofstream & out_stata,
                                               ofstream & out_R, ofstream & out_R2BayesX,
                                               const ST::string & pathresults)
@@ -108,6 +108,12 @@ class __EXPORT_TYPE FC_hrandom_variance_vec_nmig
   void compute_autocorr_all(const ST::string & path,
                                       unsigned lag, ofstream & outg) const;
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
 
   };
 
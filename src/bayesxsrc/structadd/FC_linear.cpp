@@ -60,6 +60,9 @@ FC_linear::FC_linear(void)
 
 int FC_linear::add_variable(const datamatrix & d,ST::string & name)
   {
+  // columns added later may be changed during estimation (change_variable)
+  sparseallowed = false;
+  sparse_to_dense();
   datanames.push_back(name);
   designhelp.push_back(d);
   return designhelp.size()-1;
@@ -69,7 +72,8 @@ int FC_linear::add_variable(const datamatrix & d,ST::string & name)
 FC_linear::FC_linear(MASTER_OBJ * mp,unsigned & enr,GENERAL_OPTIONS * o,DISTR * lp,
                     datamatrix & d,
                  vector<ST::string> & vn, const ST::string & t,
-                 const ST::string & fp,bool cent, bool IWLSle)
+                 const ST::string & fp,bool cent, bool IWLSle,
+                 bool XWXs)
      : FC(o,t,1,1,fp)
   {
 
@@ -78,11 +82,6 @@ FC_linear::FC_linear(MASTER_OBJ * mp,unsigned & enr,GENERAL_OPTIONS * o,DISTR *
   likep = lp;
   unsigned i;
   datanames = vn;
-  if (datanames.size() > 0)
-    {
-    for (i=0;i<d.cols();i++)
-      designhelp.push_back(d.getCol(i));
-    }
   initialize = false;
   IWLS = likep->updateIWLS;
   IWLSmode = !IWLSle;
@@ -90,6 +89,24 @@ FC_linear::FC_linear(MASTER_OBJ * mp,unsigned & enr,GENERAL_OPTIONS * o,DISTR *
   center = cent;
   rankXWX_ok = true;
   constwarning=false;
+  XWXsingle = XWXs;
+  sparseallowed = true;
+  sparsedesign = false;
+  XWXenv_ok = false;
+  XWXincremental = true;
+  XWXw_target = 0;
+  XWXw_nrupdates = 0;
+
+  // the sparse representation is created directly from d, i.e. no dense
+  // copy of the design is kept
+  if (datanames.size() > 0)
+    {
+    if (sparseallowed && !center)
+      sparsedesign = create_sparse(d);
+    if (!sparsedesign)
+      for (i=0;i<d.cols();i++)
+        designhelp.push_back(d.getCol(i));
+    }
   }
 
 
@@ -106,6 +123,27 @@ FC_linear::FC_linear(const FC_linear & m)
   designhelp = m.designhelp;
   meaneffectdesign = m.meaneffectdesign;
   XWX = m.XWX;
+  XWXsingle = m.XWXsingle;
+  Xtf = m.Xtf;
+  sparseallowed = m.sparseallowed;
+  sparsedesign = m.sparsedesign;
+  sparseperm = m.sparseperm;
+  Xcolstart = m.Xcolstart;
+  Xrowind = m.Xrowind;
+  Xval = m.Xval;
+  Xrowstart = m.Xrowstart;
+  Xcolind = m.Xcolind;
+  Xrowval = m.Xrowval;
+  XWXenv = m.XWXenv;
+  XWXenv_ok = m.XWXenv_ok;
+  sparsehelp = m.sparsehelp;
+  sparselinhelp = m.sparselinhelp;
+  XWXincremental = m.XWXincremental;
+  XWXw = m.XWXw;
+  XWXw_changed = m.XWXw_changed;
+  XWXw_dw = m.XWXw_dw;
+  XWXw_target = m.XWXw_target;
+  XWXw_nrupdates = m.XWXw_nrupdates;
   rankXWX_ok = m.rankXWX_ok;
   XWXold = m.XWXold;
   XWXroot = m.XWXroot;
@@ -148,6 +186,27 @@ const FC_linear & FC_linear::operator=(const FC_linear & m)
   designhelp = m.designhelp;
   meaneffectdesign = m.meaneffectdesign;
   XWX = m.XWX;
+  XWXsingle = m.XWXsingle;
+  Xtf = m.Xtf;
+  sparseallowed = m.sparseallowed;
+  sparsedesign = m.sparsedesign;
+  sparseperm = m.sparseperm;
+  Xcolstart = m.Xcolstart;
+  Xrowind = m.Xrowind;
+  Xval = m.Xval;
+  Xrowstart = m.Xrowstart;
+  Xcolind = m.Xcolind;
+  Xrowval = m.Xrowval;
+  XWXenv = m.XWXenv;
+  XWXenv_ok = m.XWXenv_ok;
+  sparsehelp = m.sparsehelp;
+  sparselinhelp = m.sparselinhelp;
+  XWXincremental = m.XWXincremental;
+  XWXw = m.XWXw;
+  XWXw_changed = m.XWXw_changed;
+  XWXw_dw = m.XWXw_dw;
+  XWXw_target = m.XWXw_target;
+  XWXw_nrupdates = m.XWXw_nrupdates;
   rankXWX_ok = m.rankXWX_ok;
   XWXold = m.XWXold;
   XWXroot = m.XWXroot;
@@ -201,7 +260,7 @@ void FC_linear::update_IWLS(void)
 
   if (optionsp->nriter == 1)
     {
-    linold.mult(design,beta);
+    mult_design(linold,beta);
     mode.assign(beta);
     }
   double logold = 0.0;
@@ -212,7 +271,7 @@ void FC_linear::update_IWLS(void)
     {
     logold = likep->loglikelihood(true);
 
-    linmode.mult(design,mode);
+    mult_design(linmode,mode);
     diff.minus(linmode,*linoldp);
     add_linpred(diff);
 
@@ -222,24 +281,30 @@ void FC_linear::update_IWLS(void)
     compute_XWXroot(XWXold);
 
     compute_Wpartres(linmode);
-    Xtresidual.mult(Xt,residual);
-    XWXroot.solveroot(Xtresidual,help,mode);
-
-    help.minus(beta,mode);
-    qoldbeta = -0.5*XWXold.compute_quadform(help);
+    compute_Xtresidual();
+    solve_XWXroot(Xtresidual,mode);
 
     unsigned i;
     double * workh = help.getV();
     for(i=0;i<help.rows();i++,workh++)
-      *workh = rand_normal();
+      *workh = propscale*rand_normal();
+
+    betam.assign(mode);
+    shrink_proposalmean(betam,beta);
+
+    solve_XWXroot_t(help,proposal);
+    proposal.plus(betam);
+    help.minus(proposal,betam);
 
-    XWXroot.solveroot_t(help,proposal);
-    proposal.plus(mode);
-    help.minus(proposal,mode);
+    qnewbeta = -0.5*quadform_XWX(XWXold,help)/(propscale*propscale);
 
-    qnewbeta = -0.5*XWXold.compute_quadform(help);
+    betam.assign(mode);
+    shrink_proposalmean(betam,proposal);
 
-    linnewp->mult(design,proposal);
+    help.minus(beta,betam);
+    qoldbeta = -0.5*quadform_XWX(XWXold,help)/(propscale*propscale);
+
+    mult_design(*linnewp,proposal);
 
     diff.minus(*linnewp,linmode);
 
@@ -279,25 +344,23 @@ void FC_linear::update_IWLS(void)
     compute_XWXroot(XWX); // Assumption: Matrix::root calculates Cholesky decomposition such that A = L' L
                           // second assumption: calling compute_XWXroot always updates this->XWXroot
     compute_Wpartres(*linoldp);
-    Xtresidual.mult(Xt,residual);
-    XWXroot.solveroot(Xtresidual,help,mode);
+    compute_Xtresidual();
+    solve_XWXroot(Xtresidual,mode);
+    shrink_proposalmean(mode,beta);
 
-    double log_det_XWX_half = 0.0;
-    for (unsigned i = 0; i < XWXroot.rows(); i++)
-      {
-      log_det_XWX_half += log(XWXroot(i,i));
-      }
+    double log_det_XWX_half = logdet_XWXroot();
     double* help_p = help.getV();
     for (unsigned i = 0; i < help.rows(); i++, help_p++)
       {
-      *help_p = rand_normal();
+      *help_p = propscale*rand_normal();
       }
-    XWXroot.solveroot_t(help,proposal);
-    qnewbeta = -0.5*XWX.compute_quadform(proposal) - log_det_XWX_half; // log q(proposal | current)
+    solve_XWXroot_t(help,proposal);
+    qnewbeta = -0.5*quadform_XWX(XWX,proposal)/(propscale*propscale)
+               - log_det_XWX_half; // log q(proposal | current)
     proposal.plus(mode); // add location to proposal after calculating qnewbeta!
 
     // update lin pred to use proposed value
-    linnewp->mult(design,proposal);
+    mult_design(*linnewp,proposal);
     diff.minus(*linnewp,*linoldp);
     add_linpred(diff);
 
@@ -331,19 +394,18 @@ void FC_linear::update_IWLS(void)
       likep->compute_iwls(true, false);
       compute_XWXroot(XWX);
       compute_Wpartres(*linnewp);
-      Xtresidual.mult(Xt,residual);
-      XWXroot.solveroot(Xtresidual,help,mode);
-      log_det_XWX_half = 0.0;
-      for (unsigned i = 0; i < XWXroot.rows(); i++)
-        {
-        log_det_XWX_half += log(XWXroot(i,i));
-        }
+      compute_Xtresidual();
+      solve_XWXroot(Xtresidual,mode);
+      shrink_proposalmean(mode,proposal);
+      log_det_XWX_half = logdet_XWXroot();
       help.minus(mode, beta);
-      qoldbeta = -0.5*XWX.compute_quadform(help) - log_det_XWX_half;
+      qoldbeta = -0.5*quadform_XWX(XWX,help)/(propscale*propscale)
+                 - log_det_XWX_half;
       }
     }
   double u = log(uniform());
-  if (ok && (u <= (logprop + qoldbeta - logold - qnewbeta)))
+  bool accepted = ok && (u <= (logprop + qoldbeta - logold - qnewbeta));
+  if (accepted)
     {
     datamatrix * mp = linoldp;
     linoldp = linnewp;
@@ -358,9 +420,28 @@ void FC_linear::update_IWLS(void)
     add_linpred(diff);
     }
 
+  adapt_propscale(accepted ? 1.0 : 0.0);
+
   FC::update();
   }
 
+// FUNCTION: rowproduct
+// TASK: returns r*b for a row vector r and a column vector b without a
+//       temporary matrix, summation order as in the matrix product
+
+static double rowproduct(const datamatrix & r,const datamatrix & b)
+  {
+  unsigned j;
+  double sum = 0;
+  const double * rp = r.getV();
+  const double * bp = b.getV();
+  for (j=0;j<r.cols();j++,rp++,bp++)
+    if (*rp != 0)
+      sum += *rp * *bp;
+  return sum;
+  }
+
+
 void FC_linear::update(void)
   {
   if ((datanames.size() > 0) && (rankXWX_ok==true))
@@ -379,7 +460,7 @@ void FC_linear::update(void)
       }
 
     masterp->level1_likep[equationnr]->meaneffect -= meaneffect;
-    meaneffect = (meaneffectdesign*beta)(0,0);
+    meaneffect = rowproduct(meaneffectdesign,beta);
     masterp->level1_likep[equationnr]->meaneffect += meaneffect;
 
     }
@@ -398,11 +479,11 @@ void FC_linear::update_gaussian(void)
 
     compute_XWXroot(XWX);
 
-    linold.mult(design,beta);
+    mult_design(linold,beta);
     compute_Wpartres(linold);
-    Xtresidual.mult(Xt,residual);
+    compute_Xtresidual();
 
-    XWXroot.solveroot(Xtresidual,help,betam);
+    solve_XWXroot(Xtresidual,betam);
 
     double sigmaresp = sqrt(likep->get_scale());
     unsigned i;
@@ -410,15 +491,12 @@ void FC_linear::update_gaussian(void)
     for(i=0;i<help.rows();i++,workh++)
       *workh = sigmaresp*rand_normal();
 
-    XWXroot.solveroot_t(help,beta);
+    solve_XWXroot_t(help,beta);
     beta.plus(betam);
 
     betadiff.minus(beta,betaold);
 
-    if (likep->linpred_current==1)
-      likep->linearpred1.addmult(design,betadiff);
-    else
-      likep->linearpred2.addmult(design,betadiff);
+    addmult_linpred(betadiff);
 
     bool ok;
     if (optionsp->saveestimation)
@@ -440,10 +518,7 @@ void FC_linear::update_gaussian(void)
       {
       betadiff.minus(betaold,beta);
 
-      if (likep->linpred_current==1)
-        likep->linearpred1.addmult(design,betadiff);
-      else
-        likep->linearpred2.addmult(design,betadiff);
+      addmult_linpred(betadiff);
 
       beta.assign(betaold);
       }
@@ -458,11 +533,17 @@ void FC_linear::compute_XWXroot(datamatrix & r)
 
   compute_XWX(r);
 
+  if (sparsedesign)
+    {
+    XWXenv.decomp();
+    return;
+    }
+
   if ((likep->wtype==wweightschange_weightsneqone) ||
       (likep->wtype==wweightschange_weightsone) ||
       (optionsp->nriter<=1))
     {
-    XWXroot = r.root();
+    XWXroot.assignroot(r);
     }
 
   }
@@ -473,58 +554,612 @@ void FC_linear::compute_XWX(datamatrix & r)
 
   if ((likep->wtype==wweightschange_weightsneqone) ||
       (likep->wtype==wweightschange_weightsone) ||
-      (optionsp->nriter<=1))
+      (optionsp->nriter<=1) || (sparsedesign && !XWXenv_ok))
     {
 
-    unsigned i,j,k;
-    unsigned nrconst = beta.rows();
-    unsigned nrobs = Xt.cols();
-    double * Xt_ip;
-    double * Xt_jp;
-    double * workingweightp;
-    double help;
+    // at most XWXincrement_maxfrac*nrobs changed weights are added to the
+    // previous X'WX, after XWXincrement_maxupdates such updates X'WX is
+    // recomputed to avoid the accumulation of rounding errors
+
+    const double XWXincrement_maxfrac = 0.2;
+    const unsigned XWXincrement_maxupdates = 50;
 
-    if (likep->wtype==wweightsnochange_one)
+    const double * w = 0;
+    if (likep->wtype!=wweightsnochange_one)
+      w = likep->workingweight.getV();
+
+    int target;
+    if (sparsedesign)
+      target = 3;
+    else if (&r == &XWX)
+      target = 1;
+    else
+      target = 2;
+
+    bool incremental = false;
+    if (XWXincremental && (w != 0))
       {
-      for (i=0;i<nrconst;i++)
-        for (j=i;j<nrconst;j++)
-          {
-          help = 0;
-          Xt_ip = Xt.getV()+i*nrobs;
-          Xt_jp = Xt.getV()+j*nrobs;
+      incremental = likep->changed_workingweights(XWXw,XWXw_changed,XWXw_dw,
+                                                  XWXincrement_maxfrac);
+      incremental = incremental && (XWXw_target == target) &&
+                    (XWXw_nrupdates < XWXincrement_maxupdates) &&
+                    (!sparsedesign || XWXenv_ok);
+      }
+
+    if (incremental)
+      {
+      update_XWX_changed(r);
+      XWXw_nrupdates++;
+      }
+    else
+      {
+      if (sparsedesign)
+        compute_XWX_sparse(w);
+      else
+        compute_XWX_blocked(r,w);
+
+      XWXw_target = (XWXincremental && (w != 0)) ? target : 0;
+      XWXw_nrupdates = 0;
+      }
+
+    }
+
+  }
+
+
+void FC_linear::update_XWX_changed(datamatrix & r)
+  {
+
+  unsigned k,ka,kb,i,a,b;
+  double dw,xa;
+
+  if (sparsedesign)
+    {
+    if (XWXw_changed.size() == 0)
+      return;
 
-          for (k=0;k<nrobs;k++,Xt_ip++,Xt_jp++)
-            help += (*Xt_ip)*(*Xt_jp);
+    vector<unsigned> xenv = XWXenv.getXenv();
+    vector<double>::iterator diag = XWXenv.getDiagIterator();
+    vector<double>::iterator env = XWXenv.getEnvIterator();
 
-          r(i,j) = help;
-          if (i!=j)
-            r(j,i) = help;
+    for (k=0;k<XWXw_changed.size();k++)
+      {
+      i = XWXw_changed[k];
+      dw = XWXw_dw[k];
+      for (ka=Xrowstart[i];ka<Xrowstart[i+1];ka++)
+        {
+        a = Xcolind[ka];
+        xa = dw*Xrowval[ka];
+        for (kb=Xrowstart[i];kb<ka;kb++)
+          env[xenv[a+1]-(a-Xcolind[kb])] += xa*Xrowval[kb];
+        diag[a] += xa*Xrowval[ka];
+        }
+      }
+
+    XWXenv.setDecomposed(false);
+    }
+  else
+    {
+    unsigned nrpar = design.cols();
+    double * xi;
+    double * ra;
+
+    if (XWXsingle)
+      {
+      // same precision as compute_XWX_blocked, i.e. products of the single
+      // precision copy of the design, summed in double precision
+
+      unsigned nrobs = Xt.cols();
+      const float * xf;
+      float xaf;
+
+      for (k=0;k<XWXw_changed.size();k++)
+        {
+        i = XWXw_changed[k];
+        xf = &Xtf[0]+i;
+        for (a=0;a<nrpar;a++)
+          {
+          xaf = float(XWXw_dw[k])*xf[a*nrobs];
+          if (xaf != 0)
+            {
+            ra = r.getV()+a*nrpar;
+            for (b=0;b<=a;b++)
+              ra[b] += double(xaf*xf[b*nrobs]);
+            }
           }
+        }
       }
     else
       {
-/*      ofstream out1("c://temp//weights.raw");
-      (likep->workingweight).prettyPrint(out1);
-      out1.close();*/
-      for (i=0;i<nrconst;i++)
-        for (j=i;j<nrconst;j++)
+      for (k=0;k<XWXw_changed.size();k++)
+        {
+        i = XWXw_changed[k];
+        dw = XWXw_dw[k];
+        xi = design.getV()+i*nrpar;
+        for (a=0;a<nrpar;a++)
           {
-          help = 0;
-          Xt_ip = Xt.getV()+i*nrobs;
-          Xt_jp = Xt.getV()+j*nrobs;
-          workingweightp = likep->workingweight.getV();
-
-          for (k=0;k<nrobs;k++,Xt_ip++,Xt_jp++,workingweightp++)
+          xa = dw*xi[a];
+          if (xa != 0)
             {
-            help += (*workingweightp) * (*Xt_ip)*(*Xt_jp);
+            ra = r.getV()+a*nrpar;
+            for (b=0;b<=a;b++)
+              ra[b] += xa*xi[b];
             }
+          }
+        }
+      }
+
+    // upper triangle
+
+    for (a=0;a<nrpar;a++)
+      for (b=a+1;b<nrpar;b++)
+        r(a,b) = r(b,a);
+    }
+
+  }
+
+
+bool FC_linear::create_sparse(const datamatrix & d)
+  {
+
+  // a column is sparse if at most sparsemaxfrac*nrobs of its elements are
+  // nonzero, the sparse representation is used if at least sparsemincols
+  // columns are sparse
+
+  const unsigned sparsemincols = 50;
+  const double sparsemaxfrac = 0.1;
+
+  unsigned nrobs = d.rows();
+  unsigned nrpar = d.cols();
+  unsigned i,j,k,q;
+  double * workd;
+
+  vector<unsigned> nnz(nrpar,0);
+  vector<bool> sparsecol(nrpar,false);
+  unsigned nrsparse = 0;
+  for (j=0;j<nrpar;j++)
+    {
+    workd = d.getV()+j;
+    for (i=0;i<nrobs;i++,workd+=nrpar)
+      if (*workd != 0)
+        nnz[j]++;
+    if (nnz[j] <= sparsemaxfrac*nrobs)
+      {
+      sparsecol[j] = true;
+      nrsparse++;
+      }
+    }
+
+  if (nrsparse < sparsemincols)
+    return false;
+
+  // sparse columns first, dense columns (intercept, continuous covariates)
+  // last, this keeps the envelope of X'WX small
+
+  sparseperm = vector<unsigned>();
+  for (j=0;j<nrpar;j++)
+    if (sparsecol[j])
+      sparseperm.push_back(j);
+  for (j=0;j<nrpar;j++)
+    if (!sparsecol[j])
+      sparseperm.push_back(j);
+
+  // intercept
+
+  constposition = -1;
+  for (j=0;j<nrpar && constposition==-1;j++)
+    {
+    if (nnz[j]==nrobs)
+      {
+      workd = d.getV()+j;
+      for (i=0;i<nrobs && *workd==1;i++,workd+=nrpar)
+        ;
+      if (i==nrobs)
+        constposition = j;
+      }
+    }
+
+  if (constposition==-1)
+    {
+    optionsp->out("\n");
+    optionsp->out("WARNING: AT LEAST ONE EQUATION CONTAINS NO INTERCEPT\n");
+    optionsp->out("         Intercept may be specified using const in linear effects term\n");
+    optionsp->out("\n");
+    }
+
+  // meaneffectdesign (see compute_meaneffect_design)
 
-          r(i,j) = help;
-          if (i!=j)
-            r(j,i) = help;
+  meaneffectdesign = datamatrix(1,nrpar,0);
+  double mhelp,bestdiff,currentdiff;
+  for (j=0;j<nrpar;j++)
+    {
+    mhelp = d.mean(j);
+    workd = d.getV()+j;
+    bestdiff = fabs(*workd - mhelp);
+    meaneffectdesign(0,j) = *workd;
+    for (i=1,workd+=nrpar;i<nrobs;i++,workd+=nrpar)
+      {
+      currentdiff = fabs(*workd - mhelp);
+      if (currentdiff < bestdiff)
+        {
+        bestdiff = currentdiff;
+        meaneffectdesign(0,j) = *workd;
+        }
+      }
+    }
+
+  // column wise storage
+
+  Xcolstart = vector<unsigned>(nrpar+1,0);
+  for (q=0;q<nrpar;q++)
+    Xcolstart[q+1] = Xcolstart[q]+nnz[sparseperm[q]];
+
+  Xrowind = vector<unsigned>(Xcolstart[nrpar]);
+  Xval = vector<double>(Xcolstart[nrpar]);
+  vector<unsigned> rownnz(nrobs+1,0);
+  for (q=0;q<nrpar;q++)
+    {
+    workd = d.getV()+sparseperm[q];
+    k = Xcolstart[q];
+    for (i=0;i<nrobs;i++,workd+=nrpar)
+      if (*workd != 0)
+        {
+        Xrowind[k] = i;
+        Xval[k] = *workd;
+        rownnz[i]++;
+        k++;
+        }
+    }
+
+  // row wise storage, column indices within a row are increasing
+
+  Xrowstart = vector<unsigned>(nrobs+1,0);
+  for (i=0;i<nrobs;i++)
+    Xrowstart[i+1] = Xrowstart[i]+rownnz[i];
+
+  Xcolind = vector<unsigned>(Xcolstart[nrpar]);
+  Xrowval = vector<double>(Xcolstart[nrpar]);
+  vector<unsigned> rowpos(Xrowstart.begin(),Xrowstart.end()-1);
+  for (q=0;q<nrpar;q++)
+    for (k=Xcolstart[q];k<Xcolstart[q+1];k++)
+      {
+      i = Xrowind[k];
+      Xcolind[rowpos[i]] = q;
+      Xrowval[rowpos[i]] = Xval[k];
+      rowpos[i]++;
+      }
+
+  // envelope of X'WX: row q starts at the smallest column sharing an
+  // observation with column q
+
+  vector<unsigned> first(nrpar);
+  for (q=0;q<nrpar;q++)
+    first[q] = q;
+  for (i=0;i<nrobs;i++)
+    if (Xrowstart[i+1] > Xrowstart[i])
+      for (k=Xrowstart[i];k<Xrowstart[i+1];k++)
+        if (Xcolind[Xrowstart[i]] < first[Xcolind[k]])
+          first[Xcolind[k]] = Xcolind[Xrowstart[i]];
+
+  vector<unsigned> xenv(nrpar+1,0);
+  for (q=0;q<nrpar;q++)
+    xenv[q+1] = xenv[q]+q-first[q];
+
+  XWXenv = envmatrix<double>(xenv,0,nrpar);
+  XWXenv_ok = false;
+  sparsehelp = datamatrix(nrpar,1,0);
+  sparselinhelp = datamatrix(nrobs,1,0);
+
+  optionsp->out("  NOTE: " + ST::inttostring(nrsparse) + " of " +
+                ST::inttostring(nrpar) + " columns of the design for " +
+                "linear effects are sparse,\n");
+  optionsp->out("        sparse matrix storage is used\n");
+
+  return true;
+  }
+
+
+void FC_linear::sparse_to_dense(void)
+  {
+  if (!sparsedesign)
+    return;
+
+  unsigned nrobs = Xrowstart.size()-1;
+  unsigned nrpar = sparseperm.size();
+  unsigned q,k;
+
+  designhelp = vector<datamatrix>(nrpar);
+  for (q=0;q<nrpar;q++)
+    {
+    datamatrix & col = designhelp[sparseperm[q]];
+    col = datamatrix(nrobs,1,0);
+    for (k=Xcolstart[q];k<Xcolstart[q+1];k++)
+      col(Xrowind[k],0) = Xval[k];
+    }
+
+  sparsedesign = false;
+  sparseperm = vector<unsigned>();
+  Xcolstart = vector<unsigned>();
+  Xrowind = vector<unsigned>();
+  Xval = vector<double>();
+  Xrowstart = vector<unsigned>();
+  Xcolind = vector<unsigned>();
+  Xrowval = vector<double>();
+  XWXenv = envmatrix<double>();
+  XWXenv_ok = false;
+  sparsehelp = datamatrix(1,1,0);
+  sparselinhelp = datamatrix(1,1,0);
+  }
+
+
+void FC_linear::compute_XWX_sparse(const double * w)
+  {
+
+  unsigned nrobs = Xrowstart.size()-1;
+  unsigned nrpar = sparseperm.size();
+  unsigned i,ka,kb,qa;
+  double wa;
+
+  vector<unsigned> xenv = XWXenv.getXenv();
+  vector<double>::iterator diag = XWXenv.getDiagIterator();
+  vector<double>::iterator env = XWXenv.getEnvIterator();
+
+  for (qa=0;qa<nrpar;qa++)
+    diag[qa] = 0;
+  for (ka=0;ka<xenv[nrpar];ka++)
+    env[ka] = 0;
+
+  for (i=0;i<nrobs;i++)
+    {
+    if (w==0 || w[i] != 0)
+      {
+      for (ka=Xrowstart[i];ka<Xrowstart[i+1];ka++)
+        {
+        qa = Xcolind[ka];
+        wa = (w==0) ? Xrowval[ka] : w[i]*Xrowval[ka];
+        for (kb=Xrowstart[i];kb<ka;kb++)
+          env[xenv[qa+1]-(qa-Xcolind[kb])] += wa*Xrowval[kb];
+        diag[qa] += wa*Xrowval[ka];
+        }
+      }
+    }
+
+  XWXenv.setDecomposed(false);
+  XWXenv_ok = true;
+  }
+
+
+void FC_linear::mult_design(datamatrix & res,const datamatrix & b)
+  {
+  if (sparsedesign)
+    {
+    unsigned i,q,k;
+    double bq;
+    double * workres = res.getV();
+    for (i=0;i<res.rows();i++)
+      workres[i] = 0;
+    for (q=0;q<sparseperm.size();q++)
+      {
+      bq = b(sparseperm[q],0);
+      if (bq != 0)
+        for (k=Xcolstart[q];k<Xcolstart[q+1];k++)
+          workres[Xrowind[k]] += Xval[k]*bq;
+      }
+    }
+  else
+    res.mult(design,b);
+  }
+
+
+void FC_linear::addmult_design(datamatrix & res,const datamatrix & b)
+  {
+  if (sparsedesign)
+    {
+    unsigned q,k;
+    double bq;
+    double * workres = res.getV();
+    for (q=0;q<sparseperm.size();q++)
+      {
+      bq = b(sparseperm[q],0);
+      if (bq != 0)
+        for (k=Xcolstart[q];k<Xcolstart[q+1];k++)
+          workres[Xrowind[k]] += Xval[k]*bq;
+      }
+    }
+  else
+    res.addmult(design,b);
+  }
+
+
+void FC_linear::addmult_linpred(datamatrix & b)
+  {
+  if (sparsedesign)
+    {
+    mult_design(sparselinhelp,b);
+    likep->add_linpred(sparselinhelp);
+    }
+  else
+    likep->addmult(design,b);
+  }
+
+
+void FC_linear::compute_Xtresidual(void)
+  {
+  if (sparsedesign)
+    {
+    unsigned q,k;
+    double sum;
+    double * workres = residual.getV();
+    for (q=0;q<sparseperm.size();q++)
+      {
+      sum = 0;
+      for (k=Xcolstart[q];k<Xcolstart[q+1];k++)
+        sum += Xval[k]*workres[Xrowind[k]];
+      Xtresidual(sparseperm[q],0) = sum;
+      }
+    }
+  else
+    Xtresidual.mult(Xt,residual);
+  }
+
+
+void FC_linear::solve_XWXroot(const datamatrix & b,datamatrix & x)
+  {
+  if (sparsedesign)
+    {
+    unsigned q;
+    for (q=0;q<sparseperm.size();q++)
+      sparsehelp(q,0) = b(sparseperm[q],0);
+    XWXenv.solve(sparsehelp);
+    for (q=0;q<sparseperm.size();q++)
+      x(sparseperm[q],0) = sparsehelp(q,0);
+    }
+  else
+    XWXroot.solveroot(b,help,x);
+  }
+
+
+void FC_linear::solve_XWXroot_t(const datamatrix & b,datamatrix & x)
+  {
+  if (sparsedesign)
+    {
+    unsigned q;
+    for (q=0;q<sparseperm.size();q++)
+      sparsehelp(q,0) = b(sparseperm[q],0);
+    XWXenv.solveU(sparsehelp);
+    for (q=0;q<sparseperm.size();q++)
+      x(sparseperm[q],0) = sparsehelp(q,0);
+    }
+  else
+    XWXroot.solveroot_t(b,x);
+  }
+
+
+double FC_linear::logdet_XWXroot(void)
+  {
+  if (sparsedesign)
+    return 0.5*XWXenv.getLogDet();
+
+  double logdet = 0.0;
+  for (unsigned i = 0; i < XWXroot.rows(); i++)
+    {
+    logdet += log(XWXroot(i,i));
+    }
+  return logdet;
+  }
+
+
+double FC_linear::quadform_XWX(datamatrix & r,const datamatrix & x)
+  {
+  if (sparsedesign)
+    {
+    unsigned q;
+    for (q=0;q<sparseperm.size();q++)
+      sparsehelp(q,0) = x(sparseperm[q],0);
+    return XWXenv.compute_quadform(sparsehelp,0);
+    }
+  else
+    return r.compute_quadform(x);
+  }
+
+
+void FC_linear::compute_XWX_blocked(datamatrix & r,const double * w)
+  {
+
+  // tiles of tilesize x tilesize elements of X'WX, observations are
+  // processed in panels of panelsize, so that the rows of Xt belonging to a
+  // tile stay in cache while the panel is processed
+
+  const int tilesize = 32;
+  const int panelsize = 256;
+
+  int nrconst = beta.rows();
+  int nrobs = Xt.cols();
+  int nrtiles = (nrconst+tilesize-1)/tilesize;
+
+  vector<int> tilei;
+  vector<int> tilej;
+  int ti,tj;
+  for (ti=0;ti<nrtiles;ti++)
+    for (tj=ti;tj<nrtiles;tj++)
+      {
+      tilei.push_back(ti*tilesize);
+      tilej.push_back(tj*tilesize);
+      }
+
+  int nrpairs = tilei.size();
+  int p;
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if(nrconst >= 2*tilesize)
+#endif
+  for (p=0;p<nrpairs;p++)
+    {
+    int i,j,k,k0,kend;
+    int i0 = tilei[p];
+    int j0 = tilej[p];
+    int iend = (i0+tilesize < nrconst) ? i0+tilesize : nrconst;
+    int jend = (j0+tilesize < nrconst) ? j0+tilesize : nrconst;
+    double acc[tilesize*tilesize];
+    double * accp;
+
+    for (k=0;k<tilesize*tilesize;k++)
+      acc[k] = 0;
+
+    for (k0=0;k0<nrobs;k0+=panelsize)
+      {
+      kend = (k0+panelsize < nrobs) ? k0+panelsize : nrobs;
+      for (i=i0;i<iend;i++)
+        {
+        accp = acc+(i-i0)*tilesize;
+        for (j=(j0 > i ? j0 : i);j<jend;j++)
+          {
+          if (XWXsingle)
+            {
+            const float * Xt_ip = &Xtf[0]+i*nrobs;
+            const float * Xt_jp = &Xtf[0]+j*nrobs;
+            float help = 0;
+            if (w==0)
+              {
+              for (k=k0;k<kend;k++)
+                help += Xt_ip[k]*Xt_jp[k];
+              }
+            else
+              {
+              for (k=k0;k<kend;k++)
+                help += float(w[k])*Xt_ip[k]*Xt_jp[k];
+              }
+            accp[j-j0] += double(help);
+            }
+          else
+            {
+            const double * Xt_ip = Xt.getV()+i*nrobs;
+            const double * Xt_jp = Xt.getV()+j*nrobs;
+            double help = accp[j-j0];
+            if (w==0)
+              {
+              for (k=k0;k<kend;k++)
+                help += Xt_ip[k]*Xt_jp[k];
+              }
+            else
+              {
+              for (k=k0;k<kend;k++)
+                help += w[k]*Xt_ip[k]*Xt_jp[k];
+              }
+            accp[j-j0] = help;
+            }
           }
+        }
       }
 
+    for (i=i0;i<iend;i++)
+      for (j=(j0 > i ? j0 : i);j<jend;j++)
+        {
+        r(i,j) = acc[(i-i0)*tilesize+j-j0];
+        if (i!=j)
+          r(j,i) = r(i,j);
+        }
+
     }
 
   }
@@ -601,7 +1236,29 @@ void FC_linear::create_matrices(void)
   {
 
   unsigned i,j;
-  design = datamatrix(designhelp[0].rows(),designhelp.size());
+  unsigned nrobs,nrpar;
+
+  if (sparsedesign)
+    {
+    nrobs = Xrowstart.size()-1;
+    nrpar = sparseperm.size();
+    }
+  else
+    {
+    nrobs = designhelp[0].rows();
+    nrpar = designhelp.size();
+    }
+
+  if (sparsedesign)
+    {
+    design = datamatrix(1,1,0);
+    Xt = datamatrix(1,1,0);
+    XWX = datamatrix(1,1,0);
+    }
+  else
+    {
+
+  design = datamatrix(nrobs,nrpar);
   for(i=0;i<designhelp.size();i++)
     design.putCol(i,designhelp[i]);
 
@@ -640,11 +1297,22 @@ void FC_linear::create_matrices(void)
   Xt = design.transposed();
   XWX = datamatrix(design.cols(),design.cols(),0);
 
+  if (XWXsingle)
+    {
+    unsigned i;
+    unsigned size = Xt.rows()*Xt.cols();
+    double * Xtp = Xt.getV();
+    Xtf = vector<float>(size);
+    for (i=0;i<size;i++,Xtp++)
+      Xtf[i] = float(*Xtp);
+    }
 
-  residual = datamatrix(design.rows(),1,0);
-  Xtresidual = datamatrix(design.cols(),1,0);
+    } // end: dense design
 
-  setbeta(design.cols(),1,0);
+  residual = datamatrix(nrobs,1,0);
+  Xtresidual = datamatrix(nrpar,1,0);
+
+  setbeta(nrpar,1,0);
   betaold=datamatrix(beta.rows(),1,0);
 
   /*
@@ -667,18 +1335,21 @@ void FC_linear::create_matrices(void)
   betadiff = betaold;
   betam = beta;
   help = beta;
-  linold = datamatrix(design.rows(),1,0);
+  linold = datamatrix(nrobs,1,0);
   initialize=true;
 
 
-  linnew = datamatrix(design.rows(),1,0);
-  linmode = datamatrix(design.rows(),1,0);
-  diff = datamatrix(design.rows(),1,0);
+  linnew = datamatrix(nrobs,1,0);
+  linmode = datamatrix(nrobs,1,0);
+  diff = datamatrix(nrobs,1,0);
   linnewp = &linnew;
   linoldp = &linold;
   mode = beta;
   proposal = beta;
-  XWXold = datamatrix(design.cols(),design.cols(),0);
+  if (sparsedesign)
+    XWXold = datamatrix(1,1,0);
+  else
+    XWXold = datamatrix(nrpar,nrpar,0);
 
   }
 
@@ -806,9 +1477,16 @@ bool FC_linear::posteriormode(void)
 
 
       compute_XWX(XWX);
-      datamatrix test = XWX.cinverse();
+      bool rankdeficient;
+      if (sparsedesign)
+        rankdeficient = XWXenv.decomp_save();
+      else
+        {
+        datamatrix test = XWX.cinverse();
+        rankdeficient = (test.rows() < XWX.rows());
+        }
 
-      if (test.rows() < XWX.rows())
+      if (rankdeficient)
         {
         rankXWX_ok = false;
         optionsp->out("    WARNING: Cross product matrix for linear effects is rank deficient\n");
@@ -819,19 +1497,22 @@ bool FC_linear::posteriormode(void)
 
     if (rankXWX_ok == true)
       {
-      linold.mult(design,beta);
+      mult_design(linold,beta);
 //      if(likep->dgexists)
 //        compute_Wpartres_multiplicative(linold);
 //      else
       compute_Wpartres(linold);
 
-      Xtresidual.mult(Xt,residual);
+      compute_Xtresidual();
 
-      beta = XWX.solve(Xtresidual);
+      if (sparsedesign)
+        solve_XWXroot(Xtresidual,beta);
+      else
+        beta = XWX.solve(Xtresidual);
 
       betadiff.minus(beta,betaold);
 
-      likep->addmult(design, betadiff);
+      addmult_linpred(betadiff);
 
       bool ok;
       if (optionsp->saveestimation)
@@ -844,13 +1525,13 @@ bool FC_linear::posteriormode(void)
         betaold.assign(beta);
 
         masterp->level1_likep[equationnr]->meaneffect -= meaneffect;
-        meaneffect = (meaneffectdesign*beta)(0,0);
+        meaneffect = rowproduct(meaneffectdesign,beta);
         masterp->level1_likep[equationnr]->meaneffect += meaneffect;
         }
       else
         {
         betadiff.minus(betaold,beta);
-        likep->addmult(design, betadiff);
+        addmult_linpred(betadiff);
 
         beta.assign(betaold);
         }
@@ -885,6 +1566,56 @@ void FC_linear::compute_autocorr_all(const ST::string & path,
 
 
 
+void FC_linear::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,XWX);
+  save_value(out,XWXold);
+  save_value(out,XWXroot);
+  save_value(out,rankXWX_ok);
+  save_value(out,betaold);
+  save_value(out,mode);
+  save_value(out,linold);
+  save_value(out,linnew);
+  save_value(out,linmode);
+  bool linswapped = (linoldp == &linnew);
+  save_value(out,linswapped);
+  }
+
+
+void FC_linear::read_state(ifstream & in)
+  {
+  // design matrices are created in the first update or posteriormode
+  if ((!initialize) && (datanames.size() > 0))
+    create_matrices();
+  FC::read_state(in);
+  load_value(in,XWX);
+  load_value(in,XWXold);
+  load_value(in,XWXroot);
+  load_value(in,rankXWX_ok);
+  load_value(in,betaold);
+  load_value(in,mode);
+  load_value(in,linold);
+  load_value(in,linnew);
+  load_value(in,linmode);
+  bool linswapped;
+  load_value(in,linswapped);
+  if (linswapped)
+    {
+    linoldp = &linnew;
+    linnewp = &linold;
+    }
+  else
+    {
+    linoldp = &linold;
+    linnewp = &linnew;
+    }
+  // X'WX of a sparse design is recomputed in the next update
+  XWXenv_ok = false;
+  XWXw_target = 0;
+  }
+
+
 void FC_linear::outoptions(void)
   {
 //  optionsp->out("  OPTIONS FOR TERM: " + title + "\n",true);
@@ -959,6 +1690,17 @@ void FC_linear::change_variable(datamatrix & x, unsigned & col)
     create_matrices();
   design.putCol(col, x);
   Xt.putRow(col, x.transposed());
+  if (XWXsingle)
+    {
+    unsigned i;
+    unsigned nrobs = Xt.cols();
+    float * Xtfp = &Xtf[0]+col*nrobs;
+    double * xp = x.getV();
+    for (i=0;i<nrobs;i++,Xtfp++,xp++)
+      *Xtfp = float(*xp);
+    }
+  // X'WX must be recomputed completely
+  XWXw_target = 0;
 
 /*  if((optionsp->nriter % 500) == 0)
   {
@@ -977,7 +1719,7 @@ void FC_linear::change_variable(datamatrix & x, unsigned & col)
 
 void FC_linear::compute_linold(void)
   {
-  linoldp->mult(design,beta);
+  mult_design(*linoldp,beta);
   }
 
 
@@ -996,11 +1738,15 @@ FC_linear_pen::FC_linear_pen(void)
 FC_linear_pen::FC_linear_pen(MASTER_OBJ * mp,unsigned & enr,
                             GENERAL_OPTIONS * o,DISTR * lp, datamatrix & d,
                  vector<ST::string> & vn, const ST::string & t,
-                 const ST::string & fp,bool cent, bool IWLSle)
-     : FC_linear(mp,enr,o,lp,d,vn,t,fp,cent,IWLSle)
+                 const ST::string & fp,bool cent, bool IWLSle,
+                 bool XWXs)
+     : FC_linear(mp,enr,o,lp,d,vn,t,fp,cent,IWLSle,XWXs)
   {
-
-
+  // the penalized updates work on the dense X'WX, which also contains the
+  // penalty
+  sparseallowed = false;
+  sparse_to_dense();
+  XWXincremental = false;
   }
 
 
@@ -1045,6 +1791,22 @@ bool FC_linear_pen::posteriormode(void)
 
 
 
+void FC_linear_pen::write_state(ofstream & out)
+  {
+  FC_linear::write_state(out);
+  save_value(out,tau2);
+  save_value(out,tau2oldinv);
+  }
+
+
+void FC_linear_pen::read_state(ifstream & in)
+  {
+  FC_linear::read_state(in);
+  load_value(in,tau2);
+  load_value(in,tau2oldinv);
+  }
+
+
 void FC_linear_pen::outoptions(void)
   {
 //  optionsp->out("  OPTIONS FOR TERM: " + title + "\n",true);
@@ -1061,7 +1823,7 @@ void FC_linear_pen::outresults(ofstream & out_stata,ofstream & out_R, ofstream &
 void FC_linear_pen::compute_XWXroot(datamatrix & r)
   {
   compute_XWX(r);
-  XWXroot = r.root();
+  XWXroot.assignroot(r);
   }
 
 
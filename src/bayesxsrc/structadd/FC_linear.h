@@ -31,6 +31,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include"clstring.h"
 #include"FC.h"
 #include"MASTER_obj.h"
+#include"envmatrix.h"
 #include<cmath>
 
 namespace MCMC
@@ -68,6 +69,46 @@ class __EXPORT_TYPE FC_linear  : public FC
 
   datamatrix Xt;                             // transposed designmatrix
   datamatrix XWX;
+  bool XWXsingle;                            // accumulate X'WX in single
+                                             // precision
+  vector<float> Xtf;                         // single precision copy of Xt
+
+  // sparse representation of the design matrix, used if the design contains
+  // many sparse columns (e.g. dummy coded factors with many categories).
+  // Columns are reordered such that the sparse columns come first,
+  // sparseperm[q] is the original column of column q. The design is stored
+  // column wise (Xcolstart, Xrowind, Xval) and row wise (Xrowstart,
+  // Xcolind, Xrowval), X'WX is stored and decomposed as an envelope matrix
+  // in XWXenv, design, Xt, XWX, XWXold and XWXroot are not used.
+
+  bool sparseallowed;
+  bool sparsedesign;
+  vector<unsigned> sparseperm;
+  vector<unsigned> Xcolstart;
+  vector<unsigned> Xrowind;
+  vector<double> Xval;
+  vector<unsigned> Xrowstart;
+  vector<unsigned> Xcolind;
+  vector<double> Xrowval;
+  envmatrix<double> XWXenv;
+  bool XWXenv_ok;                            // XWXenv is up to date
+  datamatrix sparsehelp;
+  datamatrix sparselinhelp;
+
+  // incremental X'WX: if only a few working weights change, X'WX is updated
+  // by the changed observations only (see compute_XWX)
+
+  bool XWXincremental;                       // incremental updates allowed
+  vector<double> XWXw;                       // working weights of X'WX
+  vector<unsigned> XWXw_changed;             // observations with changed
+                                             // working weights
+  vector<double> XWXw_dw;                    // changes of these weights
+  int XWXw_target;                           // matrix XWXw belongs to,
+                                             // 0 = none, 1 = XWX,
+                                             // 2 = XWXold, 3 = XWXenv
+  unsigned XWXw_nrupdates;                   // incremental updates since the
+                                             // last full computation
+
   bool rankXWX_ok;
   datamatrix XWXold;
   datamatrix XWXroot;
@@ -98,6 +139,79 @@ class __EXPORT_TYPE FC_linear  : public FC
 
   virtual void compute_XWX(datamatrix & r);
   virtual void compute_XWXroot(datamatrix & r);
+
+  // FUNCTION: compute_XWX_blocked
+  // TASK: computes X'WX (W = diag(w), w=0 means unit weights) on tiles of
+  //       the result and panels of observations, tiles are distributed over
+  //       threads. Each element is summed over the observations in the same
+  //       order as the unblocked loop.
+  //       If XWXsingle is true products are accumulated in single precision
+  //       within each panel and the panel sums are added in double precision
+
+  void compute_XWX_blocked(datamatrix & r,const double * w);
+
+  // FUNCTION: create_sparse
+  // TASK: checks whether enough columns of the design d are sparse and
+  //       creates the sparse representation if so.
+  //       Returns true if the sparse representation is used
+
+  bool create_sparse(const datamatrix & d);
+
+  // FUNCTION: sparse_to_dense
+  // TASK: replaces the sparse representation (if used) by the dense
+  //       columns in designhelp
+
+  void sparse_to_dense(void);
+
+  // FUNCTION: compute_XWX_sparse
+  // TASK: assembles X'WX in XWXenv (w=0 means unit weights)
+
+  void compute_XWX_sparse(const double * w);
+
+  // FUNCTION: update_XWX_changed
+  // TASK: adds (w_new-w_old) x_i x_i' to r (XWXenv for a sparse design) for
+  //       the observations i in XWXw_changed, w_new-w_old is stored in
+  //       XWXw_dw. If XWXsingle is true the products are computed in single
+  //       precision from Xtf (as in compute_XWX_blocked)
+
+  void update_XWX_changed(datamatrix & r);
+
+  // FUNCTION: mult_design, addmult_design
+  // TASK: res = X*b, res += X*b
+
+  void mult_design(datamatrix & res,const datamatrix & b);
+  void addmult_design(datamatrix & res,const datamatrix & b);
+
+  // FUNCTION: addmult_linpred
+  // TASK: adds X*b to the current predictor
+
+  void addmult_linpred(datamatrix & b);
+
+  // FUNCTION: compute_Xtresidual
+  // TASK: Xtresidual = X'*residual
+
+  void compute_Xtresidual(void);
+
+  // FUNCTION: solve_XWXroot
+  // TASK: computes x = (X'WX)^-1 b using the current Cholesky root
+
+  void solve_XWXroot(const datamatrix & b,datamatrix & x);
+
+  // FUNCTION: solve_XWXroot_t
+  // TASK: solves L'x = b, where L is the current Cholesky root of X'WX
+
+  void solve_XWXroot_t(const datamatrix & b,datamatrix & x);
+
+  // FUNCTION: logdet_XWXroot
+  // TASK: returns the log determinant of the current Cholesky root
+
+  double logdet_XWXroot(void);
+
+  // FUNCTION: quadform_XWX
+  // TASK: returns x'rx, in sparse mode r is replaced by XWXenv
+
+  double quadform_XWX(datamatrix & r,const datamatrix & x);
+
   void compute_Wpartres(datamatrix & linpred);
 //  void compute_Wpartres_multiplicative(datamatrix & linpred);
 //  double compute_XtWpartres(double & mo);
@@ -120,7 +234,8 @@ class __EXPORT_TYPE FC_linear  : public FC
 
   FC_linear(MASTER_OBJ * mp, unsigned & enr, GENERAL_OPTIONS * o,DISTR * lp,
             datamatrix & d, vector<ST::string> & vn, const ST::string & t,
-            const ST::string & fp,bool cent, bool IWLSle);
+            const ST::string & fp,bool cent, bool IWLSle,
+            bool XWXs=false);
 
   // COPY CONSTRUCTOR
 
@@ -177,6 +292,13 @@ class __EXPORT_TYPE FC_linear  : public FC
 
   void compute_linold(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -206,7 +328,8 @@ class __EXPORT_TYPE FC_linear_pen  : public FC_linear
   FC_linear_pen(MASTER_OBJ * mp,unsigned & enr,
                 GENERAL_OPTIONS * o,DISTR * lp, datamatrix & d,
                 vector<ST::string> & vn, const ST::string & t,
-                const ST::string & fp,bool cent,bool IWLSle);
+                const ST::string & fp,bool cent,bool IWLSle,
+                bool XWXs=false);
 
   // COPY CONSTRUCTOR
 
@@ -251,6 +374,13 @@ class __EXPORT_TYPE FC_linear_pen  : public FC_linear
 
   void reset(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 
 #include "FC_merror.h"
+#include "arena.h"
 
 
 //------------------------------------------------------------------------------
@@ -263,6 +264,41 @@ const FC_merror & FC_merror::operator=(const FC_merror & m)
   return *this;
   }
 
+
+// FUNCTION: quadform
+// TASK: returns h'*M*h, 'tmp' is used for h'*M. The products are summed up
+//       in the same order as in the corresponding matrix products.
+
+static double quadform(const double * h,const datamatrix & M,double * tmp)
+  {
+  unsigned k = M.rows();
+  unsigned l,j;
+  double * t = tmp;
+  for (j=0;j<k;j++,t++)
+    *t = 0;
+
+  const double * Mp = M.getV();
+  for (l=0;l<k;l++)
+    {
+    if (h[l] == 0)
+      {
+      Mp += k;
+      continue;
+      }
+    t = tmp;
+    for (j=0;j<k;j++,t++,Mp++)
+      *t += h[l] * *Mp;
+    }
+
+  double sum = 0;
+  for (j=0;j<k;j++)
+    if (tmp[j] != 0)
+      sum += tmp[j]*h[j];
+
+  return sum;
+  }
+
+
 void FC_merror::update(void)
   {
   unsigned i,j;
@@ -312,8 +348,11 @@ void FC_merror::update(void)
   double * mesdp = mesd.getV();
   double * mevarp = mevar.getV();
   double * xobsp = xobs.getV();
-  datamatrix help1(xobs.cols(), 1, 0.0);
-  datamatrix help2(xobs.cols(), 1, 0.0);
+  // scratch memory for the differences and the quadratic forms
+  scratch::arena & ar = scratch::iteration_arena();
+  double * help1 = ar.allocate(xobs.cols());
+  double * help2 = ar.allocate(xobs.cols());
+  double * helpq = ar.allocate(xobs.cols());
 
   for(i=0; i<beta.rows(); i++, linpredoldp++, resp++, wp++, betap++, indexpropp++, indexoldp++, mesdp++, mevarp++)
     {
@@ -397,11 +436,11 @@ void FC_merror::update(void)
       {
       for(j=0; j<merror; j++, xobsp++)
         {
-        help1(j,0) = *xobsp - *betap;
-        help2(j,0) = *xobsp - prop;
+        help1[j] = *xobsp - *betap;
+        help2[j] = *xobsp - prop;
         }
-      melikeold = -0.5*(help1.transposed() * mecovinv[i] * help1)(0,0);
-      melikenew = -0.5*(help2.transposed() * mecovinv[i] * help2)(0,0);
+      melikeold = -0.5*quadform(help1,mecovinv[i],helpq);
+      melikenew = -0.5*quadform(help2,mecovinv[i],helpq);
       }
 
     double logu = log(randnumbers::uniform());
@@ -510,6 +549,28 @@ void FC_merror::get_samples(const ST::string & filename, ofstream & outg) const
   FC_tau2_x.get_samples(filed, outg);
   }
 
+void FC_merror::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,indexold);
+  save_value(out,indexprop);
+  save_value(out,countmat);
+  FC_mu_x.write_state(out);
+  FC_tau2_x.write_state(out);
+  }
+
+
+void FC_merror::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,indexold);
+  load_value(in,indexprop);
+  load_value(in,countmat);
+  FC_mu_x.read_state(in);
+  FC_tau2_x.read_state(in);
+  }
+
+
 void FC_merror::outoptions(void)
   {
   optionsp->out("  " + title + "\n",true);
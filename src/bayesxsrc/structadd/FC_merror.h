@@ -129,6 +129,13 @@ class __EXPORT_TYPE FC_merror  : public FC
 
   void outoptions(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 } // end: namespace MCMC
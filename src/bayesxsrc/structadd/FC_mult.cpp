@@ -375,6 +375,24 @@ void FC_mult::outgraphs(ofstream & out_stata, ofstream & out_R, ofstream & out_R
 
 
 
+void FC_mult::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,effect);
+  FCmulteffect.write_state(out);
+  FCmulteffect_mean.write_state(out);
+  }
+
+
+void FC_mult::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,effect);
+  FCmulteffect.read_state(in);
+  FCmulteffect_mean.read_state(in);
+  }
+
+
 void FC_mult::outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                          const ST::string & pathresults)
   {
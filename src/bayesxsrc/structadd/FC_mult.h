@@ -116,6 +116,13 @@ class __EXPORT_TYPE FC_mult  : public FC
 
   void update_multeffect(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 //------------------------------------------------------------------------------
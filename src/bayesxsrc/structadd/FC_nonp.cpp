@@ -232,6 +232,7 @@ FC_nonp::FC_nonp(const FC_nonp & m)
   Vcenter = m.Vcenter;
   Vcentert = m.Vcentert;
   Wcenter = m.Wcenter;
+  Wcenterinv = m.Wcenterinv;
   Ucenter = m.Ucenter;
   Utc = m.Utc;
   ccenter = m.ccenter;
@@ -296,6 +297,7 @@ const FC_nonp & FC_nonp::operator=(const FC_nonp & m)
   Vcenter = m.Vcenter;
   Vcentert = m.Vcentert;
   Wcenter = m.Wcenter;
+  Wcenterinv = m.Wcenterinv;
   Ucenter = m.Ucenter;
   Utc = m.Utc;
   ccenter = m.ccenter;
@@ -387,6 +389,7 @@ void FC_nonp::update_IWLS(void)
 //  if (error == false)
 //    {
     designp->precision.solve(*(designp->XWres_p),paramhelp);
+    shrink_proposalmean(paramhelp,param);
 
     // TEST
     // ofstream out("c:\\bayesx\\testh\\results\\paramhelp_v.res");
@@ -396,7 +399,7 @@ void FC_nonp::update_IWLS(void)
     workparam = param.getV();
     unsigned nrpar = param.rows();
     for(i=0;i<nrpar;i++,workparam++)
-      *workparam = rand_normal();
+      *workparam = propscale*rand_normal();
 
     designp->precision.solveU(param,paramhelp); // param contains now the proposed
                                                 // new parametervector
@@ -406,7 +409,8 @@ void FC_nonp::update_IWLS(void)
     paramhelp.minus(param,paramhelp);
 
     double qold = 0.5*designp->precision.getLogDet()-
-                0.5*designp->precision.compute_quadform(paramhelp,0);
+                0.5*designp->precision.compute_quadform(paramhelp,0)/
+                (propscale*propscale);
 
     designp->compute_f(param,paramlin,beta,fsample.beta);
 
@@ -441,6 +445,7 @@ void FC_nonp::update_IWLS(void)
       designp->compute_precision(lambda);
 
       designp->precision.solve(*(designp->XWres_p),paramhelp);
+      shrink_proposalmean(paramhelp,param);
 
       // TEST
       // ofstream out2("c:\\bayesx\\testh\\results\\paramhelp_n.res");
@@ -450,12 +455,15 @@ void FC_nonp::update_IWLS(void)
 
       paramhelp.minus(paramold,paramhelp);
       qnew = 0.5*designp->precision.getLogDet() -
-             0.5*designp->precision.compute_quadform(paramhelp,0);
+             0.5*designp->precision.compute_quadform(paramhelp,0)/
+             (propscale*propscale);
       }
 
     double u = log(uniform());
 
-    if (ok && (u <= (lognew - logold  + qnew - qold)) )
+    bool accepted = ok && (u <= (lognew - logold  + qnew - qold));
+
+    if (accepted)
       {
 /*      if(likep->family == "Shared predictor")
         {
@@ -483,6 +491,8 @@ void FC_nonp::update_IWLS(void)
       beta.assign(betaold);
       }
 
+    adapt_propscale(accepted ? 1.0 : 0.0);
+
 //    } // end if (error==false)
 
   if (derivative)
@@ -1095,6 +1105,52 @@ bool FC_nonp::posteriormode(void)
   return FC::posteriormode();
   }
 
+void FC_nonp::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,param);
+  save_value(out,paramlin);
+  save_value(out,paramold);
+  save_value(out,parammode);
+  save_value(out,betaold);
+  save_value(out,paramKparam);
+  save_value(out,lambda);
+  save_value(out,tau2);
+  save_value(out,s2);
+  save_value(out,acuteparam);
+  save_value(out,expetatilde);
+  fsample.write_state(out);
+  paramsample.write_state(out);
+  derivativesample.write_state(out);
+  meaneffect_sample.write_state(out);
+  if (designp != NULL)
+    designp->write_state(out);
+  }
+
+
+void FC_nonp::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,param);
+  load_value(in,paramlin);
+  load_value(in,paramold);
+  load_value(in,parammode);
+  load_value(in,betaold);
+  load_value(in,paramKparam);
+  load_value(in,lambda);
+  load_value(in,tau2);
+  load_value(in,s2);
+  load_value(in,acuteparam);
+  load_value(in,expetatilde);
+  fsample.read_state(in);
+  paramsample.read_state(in);
+  derivativesample.read_state(in);
+  meaneffect_sample.read_state(in);
+  if (designp != NULL)
+    designp->read_state(in);
+  }
+
+
 void FC_nonp::outoptions(void)
   {
   optionsp->out("  " + title + "\n",true);
@@ -1663,6 +1719,17 @@ void FC_nonp::outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_
       }
 
 
+    if (optionsp->binaryoutput)
+      {
+      ST::string pathbin = pathresults.substr(0,pathresults.length()-4) +
+                           ".bin";
+      ST::string effname = designp->datanames[designp->datanames.size()-1];
+      if (designp->position_lin!=-1)
+        fsample.outresults_binary(pathbin,effname,designp->effectvalues);
+      else
+        outresults_binary(pathbin,effname,designp->effectvalues);
+      }
+
     ofstream outres(pathresults.strtochar());
 
     optionsp->out("\n");
@@ -2010,6 +2077,7 @@ void FC_nonp::initialize_center(void)
   Vcenter = datamatrix(nrpar,nrrest);
   Vcentert = datamatrix(nrrest,nrpar);
   Wcenter = datamatrix(nrrest,nrrest);
+  Wcenterinv = datamatrix(nrrest,nrrest);
   Ucenter = datamatrix(nrrest,nrpar);
   ccenter = datamatrix(nrrest,1);
   Utc = datamatrix(nrpar,1);
@@ -2068,9 +2136,24 @@ void FC_nonp::centerparam_sample(void)
     }
 
   Wcenter.mult(designp->basisNull,Vcenter);
-  Ucenter = Wcenter.inverse()*Vcentert;
+  Wcenterinv.assigninverse(Wcenter);
+  Ucenter.mult(Wcenterinv,Vcentert);
   ccenter.mult(designp->basisNull,param);
-  Utc = Ucenter.transposed()*ccenter;
+
+  // Utc = Ucenter'*ccenter without forming the transposed matrix
+
+  double * Utcp = Utc.getV();
+  double * Ucenterp;
+  double * ccenterp;
+  for (j=0;j<nrpar;j++,Utcp++)
+    {
+    *Utcp = 0;
+    Ucenterp = Ucenter.getV()+j;
+    ccenterp = ccenter.getV();
+    for (i=0;i<nrrest;i++,Ucenterp+=nrpar,ccenterp++)
+      if (*Ucenterp != 0)
+        *Utcp += *Ucenterp * (*ccenterp);
+    }
 
   param.minus(param,Utc);
   }
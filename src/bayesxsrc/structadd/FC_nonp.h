@@ -112,6 +112,7 @@ class __EXPORT_TYPE FC_nonp  : public FC
   datamatrix Vcenter;
   datamatrix Vcentert;
   datamatrix Wcenter;
+  datamatrix Wcenterinv;
   datamatrix Ucenter;
   datamatrix Utc;
   datamatrix ccenter;
@@ -238,6 +239,12 @@ class __EXPORT_TYPE FC_nonp  : public FC
   //return log-full conditional
   double compute_log_FC(void);*/
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
 
   };
 
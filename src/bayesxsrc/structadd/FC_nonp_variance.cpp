@@ -568,6 +568,10 @@ void FC_nonp_variance::outresults(ofstream & out_stata,ofstream & out_R, ofstrea
     optionsp->out("    " +  pathresults + "\n");
     optionsp->out("\n");
 
+    if (optionsp->binaryoutput)
+      outresults_binary(pathresults.substr(0,pathresults.length()-4) +
+                        ".bin","",vector<ST::string>());
+
     ST::string paths = pathresults.substr(0,pathresults.length()-4) +
                                  "_sample.raw";
 
@@ -606,6 +610,20 @@ void FC_nonp_variance::outresults(ofstream & out_stata,ofstream & out_R, ofstrea
   }
 
 
+void FC_nonp_variance::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,b_invgamma);
+  }
+
+
+void FC_nonp_variance::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,b_invgamma);
+  }
+
+
 void FC_nonp_variance::outoptions(void)
   {
   if (cauchy)
@@ -1269,6 +1287,30 @@ void FC_nonp_variance_varselection::get_samples(
   FC_psi2.get_samples(filename_psi2,outg);
   }
 
+void FC_nonp_variance_varselection::write_state(ofstream & out)
+  {
+  FC_nonp_variance::write_state(out);
+  save_value(out,tauold);
+  save_value(out,omega);
+  save_value(out,v2);
+  FC_psi2.write_state(out);
+  FC_omega.write_state(out);
+  FC_delta.write_state(out);
+  }
+
+
+void FC_nonp_variance_varselection::read_state(ifstream & in)
+  {
+  FC_nonp_variance::read_state(in);
+  load_value(in,tauold);
+  load_value(in,omega);
+  load_value(in,v2);
+  FC_psi2.read_state(in);
+  FC_omega.read_state(in);
+  FC_delta.read_state(in);
+  }
+
+
 void FC_nonp_variance_varselection::outoptions(void)
   {
 //  FC_nonp_variance::outoptions();
@@ -1614,6 +1656,20 @@ cout << "-0.5/(fcn->tau2)*(dut->penalty_compute_quadform(fcn->param)): " << -0.5
   // FUNCTION: outoptions
   // TASK: writes estimation options (hyperparameters, etc.) to outputstream
 
+void FC_tensor_omega::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,omegaindex);
+  }
+
+
+void FC_tensor_omega::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,omegaindex);
+  }
+
+
   void FC_tensor_omega::outoptions(void)
    {
 
@@ -152,6 +152,13 @@ class __EXPORT_TYPE FC_nonp_variance  : public FC
 
   // virtual void transform_beta(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -268,6 +275,13 @@ class __EXPORT_TYPE FC_nonp_variance_varselection  : public FC_nonp_variance
 
   // virtual void transform_beta(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -430,6 +444,14 @@ class __EXPORT_TYPE FC_tensor_omega : public FC
                const ST::string & pathresults);
 
   void read_options(vector<ST::string> & op,vector<ST::string> & vn);
+
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 } // end: namespace MCMC
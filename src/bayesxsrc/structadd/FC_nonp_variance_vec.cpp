@@ -199,6 +199,21 @@ void FC_nonp_variance_vec::reset(void)
   }
 
 
+void FC_nonp_variance_vec::write_state(ofstream & out)
+  {
+  FC_nonp_variance::write_state(out);
+  }
+
+
+void FC_nonp_variance_vec::read_state(ifstream & in)
+  {
+  FC_nonp_variance::read_state(in);
+  // the penalty matrix depends on the variances and is not part of the
+  // state of the design
+  designp->compute_penalty2(beta);
+  }
+
+
 } // end: namespace MCMC
 
 
@@ -71,6 +71,8 @@ FC_predict::FC_predict(GENERAL_OPTIONS * o,DISTR * lp,const ST::string & t,
   : FC(o,t,1,1,fp)
   {
   WAICoff=wa;
+  fused = false;
+  aggregated = false;
   nosamples = true;
   MSE = noMSE;
   MSEparam = 0.5;
@@ -92,14 +94,7 @@ FC_predict::FC_predict(GENERAL_OPTIONS * o,DISTR * lp,const ST::string & t,
 
     if (WAICoff ==false)
       {
-      FC_p = FC(o,"",lp->nrobs,1,"");
-      FC_p.nosamples = true;
-
-      FC_logp = FC(o,"",lp->nrobs,1,"");
-      FC_logp.nosamples = true;
-
-      FC_logp2 = FC(o,"",lp->nrobs,1,"");
-      FC_logp2.nosamples = true;
+      modelcomp = model_comparison(lp->nrobs,o->compute_samplesize());
       }
     }
 
@@ -113,12 +108,15 @@ FC_predict::FC_predict(const FC_predict & m)
   MSEparam = m.MSEparam;
   likep = m.likep;
   designmatrix = m.designmatrix;
+  aggregated = m.aggregated;
+  designexpanded = m.designexpanded;
+  aggregationindex = m.aggregationindex;
   varnames = m.varnames;
   FC_deviance = m.FC_deviance;
-  FC_p = m.FC_p;
-  FC_logp = m.FC_logp;
-  FC_logp2 = m.FC_logp2;
+  modelcomp = m.modelcomp;
   WAICoff = m.WAICoff;
+  fused = m.fused;
+  deviancecontrib = m.deviancecontrib;
   deviance = m.deviance;
   deviancesat = m.deviancesat;
   }
@@ -134,12 +132,15 @@ const FC_predict & FC_predict::operator=(const FC_predict & m)
   MSEparam = m.MSEparam;
   likep = m.likep;
   designmatrix = m.designmatrix;
+  aggregated = m.aggregated;
+  designexpanded = m.designexpanded;
+  aggregationindex = m.aggregationindex;
   varnames = m.varnames;
   FC_deviance = m.FC_deviance;
-  FC_p = m.FC_p;
-  FC_logp = m.FC_logp;
-  FC_logp2 = m.FC_logp2;
+  modelcomp = m.modelcomp;
   WAICoff = m.WAICoff;
+  fused = m.fused;
+  deviancecontrib = m.deviancecontrib;
   deviance = m.deviance;
   deviancesat = m.deviancesat;
   return *this;
@@ -157,7 +158,7 @@ void  FC_predict::update(void)
      &&
      ((optionsp->nriter-optionsp->burnin-1) % (optionsp->step) == 0)
     )
-    get_predictor();
+    get_predictor(true);
 
   acceptance++;
 
@@ -170,28 +171,40 @@ void  FC_predict::update(void)
     FC_deviance.beta(0,0) = deviance;
     FC_deviance.acceptance++;
     FC_deviance.update();
-
-    if (WAICoff==false)
-      {
-      FC_p.acceptance++;
-      FC_p.update();
-
-      FC_logp.acceptance++;
-      FC_logp.update();
-
-      FC_logp2.acceptance++;
-      FC_logp2.update();
-      }
-
     }
 
   }
 
 
-void FC_predict::get_predictor(void)
+void FC_predict::get_predictor(const bool & sample)
   {
 
   unsigned i;
+
+  if (fused)
+    {
+
+    if (likep->maindistribution == true)
+      {
+      if (deviancecontrib.rows() != likep->nrobs)
+        deviancecontrib = datamatrix(likep->nrobs,1,0);
+
+      deviance = likep->compute_predict(beta.getV(),deviancecontrib.getV());
+
+      if ((WAICoff==false) && sample)
+        {
+        double * workdev = deviancecontrib.getV();
+        for (i=0;i<likep->nrobs;i++,workdev++)
+          modelcomp.update(i,-0.5* *workdev);
+        modelcomp.next_draw();
+        }
+      }
+    else
+      likep->compute_predict(beta.getV(),NULL);
+
+    return;
+    }
+
   double * betap = beta.getV();
 
   double * worklinp;
@@ -229,12 +242,10 @@ void FC_predict::get_predictor(void)
 
       deviance+=deviancehelp;
 
-      if (WAICoff==false)
+      if ((WAICoff==false) && sample)
         {
         logp = -0.5*deviancehelp;
-        FC_logp.beta(i,0) = logp;
-        FC_p.beta(i,0) = exp(logp);
-        FC_logp2.beta(i,0) = pow(logp,2);
+        modelcomp.update(i,logp);
         }
 
       }
@@ -247,6 +258,9 @@ void FC_predict::get_predictor(void)
 
     }
 
+  if ((likep->maindistribution == true) && (WAICoff==false) && sample)
+    modelcomp.next_draw();
+
   }
 
 
@@ -261,6 +275,24 @@ bool FC_predict::posteriormode(void)
   }
 
 
+void FC_predict::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,deviance);
+  FC_deviance.write_state(out);
+  modelcomp.write_state(out);
+  }
+
+
+void FC_predict::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,deviance);
+  FC_deviance.read_state(in);
+  modelcomp.read_state(in);
+  }
+
+
 void FC_predict::outoptions(void)
   {
 
@@ -354,18 +386,9 @@ void FC_predict::outresults_WAIC(ofstream & out_stata, ofstream & out_R, ofstrea
   optionsp->out("    " +  pathresultswaic + "\n");
   optionsp->out("\n");
 
-  double l_pd=0;
-  double p_d=0;
-
-  double r = ((double)optionsp->samplesize)/((double)(optionsp->samplesize-1));
-
-  unsigned i;
-  for (i=0;i<likep->nrobs;i++)
-    {
-    l_pd += log(FC_p.betamean(i,0));
-    p_d += (FC_logp2.betamean(i,0) - FC_logp.betamean(i,0)*FC_logp.betamean(i,0))*r;
-    }
-  l_pd *= -2.0;
+  double l_pd;
+  double p_d;
+  modelcomp.compute_WAIC(l_pd,p_d);
 
   unsigned d;
   if (l_pd > 1000000000)
@@ -399,6 +422,76 @@ void FC_predict::outresults_WAIC(ofstream & out_stata, ofstream & out_R, ofstrea
 
 
 
+void FC_predict::outresults_LOO(const ST::string & pathresults)
+  {
+
+  ST::string pathresultsloo = pathresults.substr(0,pathresults.length()-4) + "_LOO.res";
+  ofstream out(pathresultsloo.strtochar());
+
+  optionsp->out("    Results for PSIS-LOO are stored in file\n");
+  optionsp->out("    " +  pathresultsloo + "\n");
+  optionsp->out("\n");
+
+  double elpd;
+  double p_loo;
+  datamatrix k;
+  modelcomp.compute_LOO(elpd,p_loo,k);
+
+  unsigned i;
+  unsigned nrhigh=0;
+  unsigned nrveryhigh=0;
+  for (i=0;i<k.rows();i++)
+    {
+    if (k(i,0) > 0.7)
+      nrhigh++;
+    if (k(i,0) > 1)
+      nrveryhigh++;
+    }
+
+  double looic = -2*elpd;
+
+  unsigned d;
+  if (fabs(looic) > 1000000000)
+    d = 14;
+  else if (fabs(looic) > 1000000)
+    d = 11;
+  else
+    d = 8;
+
+  out << "elpd_loo  p_loo  looic  k_high  k_veryhigh" << endl;
+
+  optionsp->out("  ESTIMATION RESULTS FOR PSIS-LOO: \n",true);
+  optionsp->out("\n");
+
+  optionsp->out("    elpd_loo:                   " +
+  ST::doubletostring(elpd,d) + "\n");
+  out << elpd << "   ";
+
+  optionsp->out("    p_loo:                      " +
+  ST::doubletostring(p_loo,d) + "\n");
+  out << p_loo << "   ";
+
+  optionsp->out("    LOOIC:                      " +
+  ST::doubletostring(looic,d) + "\n");
+  out << looic << "   ";
+
+  optionsp->out("    Pareto k > 0.7:             " +
+  ST::inttostring(nrhigh) + " observations\n");
+  out << nrhigh << "   " << nrveryhigh << endl;
+
+  if (nrhigh > 0)
+    {
+    optionsp->out("\n");
+    optionsp->out("    NOTE: Pareto k > 0.7 indicates unreliable importance sampling\n");
+    optionsp->out("          estimates for these observations\n");
+    }
+
+  optionsp->out("\n");
+
+  }
+
+
+
 void FC_predict::outresults_deviance(void)
     {
 
@@ -549,13 +642,6 @@ void FC_predict::outresults(ofstream & out_stata, ofstream & out_R, ofstream & o
     if (likep->maindistribution == true)
       {
       FC_deviance.outresults(out_stata,out_R,out_R2BayesX,"");
-
-      if (WAICoff==false)
-        {
-        FC_p.outresults(out_stata,out_R,out_R2BayesX,"");
-        FC_logp.outresults(out_stata,out_R,out_R2BayesX,"");
-        FC_logp2.outresults(out_stata,out_R,out_R2BayesX,"");
-        }
       }
 
     optionsp->out("  PREDICTED VALUES: \n",true);
@@ -631,136 +717,73 @@ void FC_predict::outresults(ofstream & out_stata, ofstream & out_R, ofstream & o
 
     outres << endl;
 
-    double * workmean = betamean.getV();
-    double * workbetaqu_l1_lower_p = betaqu_l1_lower.getV();
-    double * workbetaqu_l2_lower_p = betaqu_l2_lower.getV();
-    double * workbetaqu_l1_upper_p = betaqu_l1_upper.getV();
-    double * workbetaqu_l2_upper_p = betaqu_l2_upper.getV();
-    double * workbetaqu50 = betaqu50.getV();
+    double * workmean;
+    double * workbetaqu_l1_lower_p;
+    double * workbetaqu_l2_lower_p;
+    double * workbetaqu_l1_upper_p;
+    double * workbetaqu_l2_upper_p;
+    double * workbetaqu50;
 
-    double * responsep = likep->response.getV();
-    double * weightp = likep->weight.getV();
+    // grouped likelihood: one row per original observation
 
-    double scalehelp = 0.0;
-    scalehelp = likep->get_scalemean();
+    datamatrix & design = aggregated ? designexpanded : designmatrix;
+    unsigned k;
 
-    if (nosamplessave==false)
+    for(i=0;i<design.rows();i++)
       {
-      for(i=0;i<designmatrix.rows();i++,responsep++,weightp++,
-            workmean++,
-            workbetaqu_l1_lower_p++,
-            workbetaqu_l2_lower_p++,
-            workbetaqu50++,
-            workbetaqu_l1_upper_p++,
-            workbetaqu_l2_upper_p++)
-        {
 
-        outres << (i+1) << "   ";
+      if (aggregated)
+        k = 3*aggregationindex(i,0);
+      else
+        k = 3*i;
 
-        for (j=0;j<designmatrix.cols();j++)
-          outres << designmatrix(i,j) << "   ";
+      workmean = betamean.getV()+k;
 
-        outres << *workmean << "   ";
+      outres << (i+1) << "   ";
 
-        if (optionsp->samplesize > 1)
-          {
-          outres << *workbetaqu_l1_lower_p << "   ";
-          outres << *workbetaqu_l2_lower_p << "   ";
-          outres << *workbetaqu50 << "   ";
-          outres << *workbetaqu_l2_upper_p << "   ";
-          outres << *workbetaqu_l1_upper_p << "   ";
-          }
+      for (j=0;j<design.cols();j++)
+        outres << design(i,j) << "   ";
 
-        // mu
-        workmean++;
-        workbetaqu_l1_lower_p++;
-        workbetaqu_l2_lower_p++;
-        workbetaqu50++;
-        workbetaqu_l1_upper_p++;
-        workbetaqu_l2_upper_p++;
+      if (nosamplessave==false)
+        {
 
-        outres << *workmean << "   ";
+        workbetaqu_l1_lower_p = betaqu_l1_lower.getV()+k;
+        workbetaqu_l2_lower_p = betaqu_l2_lower.getV()+k;
+        workbetaqu50 = betaqu50.getV()+k;
+        workbetaqu_l1_upper_p = betaqu_l1_upper.getV()+k;
+        workbetaqu_l2_upper_p = betaqu_l2_upper.getV()+k;
+
+        // predictor, mu and parameter
 
-        if (optionsp->samplesize > 1)
+        for (unsigned l=0;l<3;l++,workmean++,workbetaqu_l1_lower_p++,
+             workbetaqu_l2_lower_p++,workbetaqu50++,workbetaqu_l1_upper_p++,
+             workbetaqu_l2_upper_p++)
           {
-          outres << *workbetaqu_l1_lower_p << "   ";
-          outres << *workbetaqu_l2_lower_p << "   ";
-          outres << *workbetaqu50 << "   ";
-          outres << *workbetaqu_l2_upper_p << "   ";
-          outres << *workbetaqu_l1_upper_p << "   ";
-          }
-        // end mu
 
+          outres << *workmean << "   ";
 
-        // parameter
-        workmean++;
-        workbetaqu_l1_lower_p++;
-        workbetaqu_l2_lower_p++;
-        workbetaqu50++;
-        workbetaqu_l1_upper_p++;
-        workbetaqu_l2_upper_p++;
+          if (optionsp->samplesize > 1)
+            {
+            outres << *workbetaqu_l1_lower_p << "   ";
+            outres << *workbetaqu_l2_lower_p << "   ";
+            outres << *workbetaqu50 << "   ";
+            outres << *workbetaqu_l2_upper_p << "   ";
+            outres << *workbetaqu_l1_upper_p << "   ";
+            }
 
-        outres << *workmean << "   ";
-
-        if (optionsp->samplesize > 1)
-          {
-          outres << *workbetaqu_l1_lower_p << "   ";
-          outres << *workbetaqu_l2_lower_p << "   ";
-          outres << *workbetaqu50 << "   ";
-          outres << *workbetaqu_l2_upper_p << "   ";
-          outres << *workbetaqu_l1_upper_p << "   ";
           }
-        // end parameter
-
-/*
-        outres << likep->compute_quantile_residual(responsep,workmean,weightp,&scalehelp) << "   ";
-        outres << likep->compute_quadr()    << "   ";
-        outres << likep->compute_log(responsep,workmean,weightp,&scalehelp)    << "   ";
-        outres << likep->compute_spherical()    << "   ";
-        outres << likep->compute_CRPS()    << "   ";
-*/
-        outres << endl;
-        }
-      }
-    else
-      {
 
-      for(i=0;i<designmatrix.rows();i++,responsep++,weightp++,
-            workmean++)
+        }
+      else
         {
-
-        outres << (i+1) << "   ";
-
-        for (j=0;j<designmatrix.cols();j++)
-          outres << designmatrix(i,j) << "   ";
-
         outres << *workmean << "   ";
-
         workmean++;
-
         outres << *workmean << "   ";
-
         workmean++;
-
         outres << *workmean << "   ";
-/*
-        outres << likep->compute_quantile_residual(responsep,workmean,weightp,&scalehelp) << "   ";
-        outres << likep->compute_quadr()    << "   ";
-        outres << likep->compute_log(responsep,workmean,weightp,&scalehelp)    << "   ";
-        outres << likep->compute_spherical()    << "   ";
-        outres << likep->compute_CRPS()    << "   ";
-*/
-        outres << endl;
-
-//            std::ofstream out;
-////  // helpmat1.prettyPrint(out);
-//    out.open ("C:\\tmp\\resp.raw", std::ofstream::out | std::ofstream::app);
-//    out << " " ;
-//    out << *responsep ;
-//    out << " " ;
-//    out << *workmean << endl;
         }
 
+      outres << endl;
       }
 
     if (likep->maindistribution == true)
@@ -768,7 +791,10 @@ void FC_predict::outresults(ofstream & out_stata, ofstream & out_R, ofstream & o
       outresults_deviance();
       outresults_DIC(out_stata,out_R,out_R2BayesX,pathresults);
       if (WAICoff==false)
+        {
         outresults_WAIC(out_stata,out_R,out_R2BayesX,pathresults);
+        outresults_LOO(pathresults);
+        }
       }
 
     }   // end if (pathresults.isvalidfile() != 1)
@@ -776,9 +802,18 @@ void FC_predict::outresults(ofstream & out_stata, ofstream & out_R, ofstream & o
   }
 
 
-void FC_predict::reset(void)
+void FC_predict::set_aggregation(const datamatrix & dm,
+                                 const statmatrix<int> & index)
   {
+  aggregated = true;
+  designexpanded = dm;
+  aggregationindex = index;
+  }
 
+
+void FC_predict::reset(void)
+  {
+  modelcomp.reset();
   }
 
 
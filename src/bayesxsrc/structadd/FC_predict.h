@@ -35,6 +35,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include"GENERAL_OPTIONS.h"
 #include"distr.h"
 #include"clstring.h"
+#include"model_comparison.h"
 #include<cmath>
 
 namespace MCMC
@@ -54,20 +55,35 @@ class __EXPORT_TYPE FC_predict   : public FC
   protected:
 
   FC FC_deviance;
-  FC FC_p;
-  FC FC_logp;
-  FC FC_logp2;
+
+  // streaming WAIC and PSIS-LOO
+
+  model_comparison modelcomp;
 
 
   DISTR * likep;
   datamatrix designmatrix;
   vector<ST::string> varnames;
 
+  // grouped likelihood: design matrix of the original observations and
+  // index of the grouped record of each observation
+
+  bool aggregated;
+  datamatrix designexpanded;
+  statmatrix<int> aggregationindex;
+
 
   double deviance;
   double deviancesat;
 
-  void get_predictor(void);
+  datamatrix deviancecontrib;      // deviance contributions, fused sweep
+
+  // FUNCTION: get_predictor
+  // TASK: computes predictor, mean and deviance for the current iteration,
+  //       if 'sample' is true the pointwise log-likelihoods are added to
+  //       'modelcomp'
+
+  void get_predictor(const bool & sample=false);
 
   void compute_MSE(const ST::string & pathresults);
 
@@ -78,6 +94,11 @@ class __EXPORT_TYPE FC_predict   : public FC
 
   bool WAICoff;
 
+  // if true, predictions and deviance are computed in a single sweep by
+  // DISTR::compute_predict
+
+  bool fused;
+
   ST::string getloss(void);
 
   // DEFAULT CONSTRUCTOR
@@ -104,6 +125,13 @@ class __EXPORT_TYPE FC_predict   : public FC
     {
     }
 
+  // FUNCTION: set_aggregation
+  // TASK: the likelihood is defined for grouped records, results are
+  //       expanded to the observations in dm, index(i,0) is the grouped
+  //       record of observation i
+
+  void set_aggregation(const datamatrix & dm,const statmatrix<int> & index);
+
 
   void update(void);
 
@@ -118,6 +146,11 @@ class __EXPORT_TYPE FC_predict   : public FC
   void outresults_WAIC(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                       const ST::string & pathresults);
 
+  // FUNCTION: outresults_LOO
+  // TASK: writes the PSIS-LOO results (file *_LOO.res)
+
+  void outresults_LOO(const ST::string & pathresults);
+
   void outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                   const ST::string & pathresults);
 
@@ -130,6 +163,13 @@ class __EXPORT_TYPE FC_predict   : public FC
 
   void read_options(vector<ST::string> & op,vector<ST::string> & vn);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
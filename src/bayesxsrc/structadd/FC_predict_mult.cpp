@@ -63,14 +63,7 @@ FC_predict_mult::FC_predict_mult(GENERAL_OPTIONS * o,vector<DISTR *> lp,
 
   if (WAICoff==false)
     {
-    FC_p = FC(o,"",(likep[0])->nrobs,1,"");
-    FC_p.nosamples = true;
-
-    FC_logp = FC(o,"",(likep[0])->nrobs,1,"");
-    FC_logp.nosamples = true;
-
-    FC_logp2 = FC(o,"",(likep[0])->nrobs,1,"");
-    FC_logp2.nosamples = true;
+    modelcomp = model_comparison((likep[0])->nrobs,o->compute_samplesize());
     }
 
   }
@@ -83,9 +76,7 @@ FC_predict_mult::FC_predict_mult(const FC_predict_mult & m)
   designmatrix = m.designmatrix;
   varnames = m.varnames;
   FC_deviance = m.FC_deviance;
-  FC_p = m.FC_p;
-  FC_logp = m.FC_logp;
-  FC_logp2 = m.FC_logp2;
+  modelcomp = m.modelcomp;
   WAICoff = m.WAICoff;
   deviance = m.deviance;
   }
@@ -100,9 +91,7 @@ const FC_predict_mult & FC_predict_mult::operator=(const FC_predict_mult & m)
   designmatrix = m.designmatrix;
   varnames = m.varnames;
   FC_deviance = m.FC_deviance;
-  FC_p = m.FC_p;
-  FC_logp = m.FC_logp;
-  FC_logp2 = m.FC_logp2;
+  modelcomp = m.modelcomp;
   WAICoff = m.WAICoff;
   deviance = m.deviance;
   return *this;
@@ -117,7 +106,7 @@ void  FC_predict_mult::update(void)
      &&
      ((optionsp->nriter-optionsp->burnin-1) % (optionsp->step) == 0)
     )
-    get_predictor();
+    get_predictor(true);
 
   acceptance++;
 
@@ -127,22 +116,10 @@ void  FC_predict_mult::update(void)
   FC_deviance.acceptance++;
   FC_deviance.update();
 
-  if (WAICoff==false)
-    {
-    FC_p.acceptance++;
-    FC_p.update();
-
-    FC_logp.acceptance++;
-    FC_logp.update();
-
-    FC_logp2.acceptance++;
-    FC_logp2.update();
-    }
-
   }
 
 
-void FC_predict_mult::get_predictor(void)
+void FC_predict_mult::get_predictor(const bool & sample)
   {
 
     unsigned i,j;
@@ -207,15 +184,16 @@ void FC_predict_mult::get_predictor(void)
 
       deviance+=deviancehelp;
 
-      if (WAICoff==false)
+      if ((WAICoff==false) && sample)
         {
         logp = -0.5*deviancehelp;
-        FC_logp.beta(i,0) = logp;
-        FC_p.beta(i,0) = exp(logp);
-        FC_logp2.beta(i,0) = pow(logp,2);
+        modelcomp.update(i,logp);
         }
       }
 
+    if ((WAICoff==false) && sample)
+      modelcomp.next_draw();
+
   // TEST
   // ofstream out("c:\\bayesx\\testh\\results\\beta.raw");
   // beta.prettyPrint(out);
@@ -236,6 +214,24 @@ bool FC_predict_mult::posteriormode(void)
   }
 
 
+void FC_predict_mult::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,deviance);
+  FC_deviance.write_state(out);
+  modelcomp.write_state(out);
+  }
+
+
+void FC_predict_mult::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,deviance);
+  FC_deviance.read_state(in);
+  modelcomp.read_state(in);
+  }
+
+
 void FC_predict_mult::outoptions(void)
   {
 
@@ -348,18 +344,9 @@ void FC_predict_mult::outresults_WAIC(ofstream & out_stata, ofstream & out_R, of
   optionsp->out("    " +  pathresultswaic + "\n");
   optionsp->out("\n");
 
-  double l_pd=0;
-  double p_d=0;
-
-  double r = ((double)optionsp->samplesize)/((double)(optionsp->samplesize-1));
-
-  unsigned i;
-  for (i=0;i<likep[0]->nrobs;i++)
-    {
-    l_pd += log(FC_p.betamean(i,0));
-    p_d += (FC_logp2.betamean(i,0) - FC_logp.betamean(i,0)*FC_logp.betamean(i,0))*r;
-    }
-  l_pd *= -2.0;
+  double l_pd;
+  double p_d;
+  modelcomp.compute_WAIC(l_pd,p_d);
 
   unsigned d;
   if (l_pd > 1000000000)
@@ -391,6 +378,76 @@ void FC_predict_mult::outresults_WAIC(ofstream & out_stata, ofstream & out_R, of
 
   }
 
+void FC_predict_mult::outresults_LOO(const ST::string & pathresults)
+  {
+
+  ST::string pathresultsloo = pathresults.substr(0,pathresults.length()-4) + "_LOO.res";
+  ofstream out(pathresultsloo.strtochar());
+
+  optionsp->out("    Results for PSIS-LOO are stored in file\n");
+  optionsp->out("    " +  pathresultsloo + "\n");
+  optionsp->out("\n");
+
+  double elpd;
+  double p_loo;
+  datamatrix k;
+  modelcomp.compute_LOO(elpd,p_loo,k);
+
+  unsigned i;
+  unsigned nrhigh=0;
+  unsigned nrveryhigh=0;
+  for (i=0;i<k.rows();i++)
+    {
+    if (k(i,0) > 0.7)
+      nrhigh++;
+    if (k(i,0) > 1)
+      nrveryhigh++;
+    }
+
+  double looic = -2*elpd;
+
+  unsigned d;
+  if (fabs(looic) > 1000000000)
+    d = 14;
+  else if (fabs(looic) > 1000000)
+    d = 11;
+  else
+    d = 8;
+
+  out << "elpd_loo  p_loo  looic  k_high  k_veryhigh" << endl;
+
+  optionsp->out("  ESTIMATION RESULTS FOR PSIS-LOO: \n",true);
+  optionsp->out("\n");
+
+  optionsp->out("    elpd_loo:                   " +
+  ST::doubletostring(elpd,d) + "\n");
+  out << elpd << "   ";
+
+  optionsp->out("    p_loo:                      " +
+  ST::doubletostring(p_loo,d) + "\n");
+  out << p_loo << "   ";
+
+  optionsp->out("    LOOIC:                      " +
+  ST::doubletostring(looic,d) + "\n");
+  out << looic << "   ";
+
+  optionsp->out("    Pareto k > 0.7:             " +
+  ST::inttostring(nrhigh) + " observations\n");
+  out << nrhigh << "   " << nrveryhigh << endl;
+
+  if (nrhigh > 0)
+    {
+    optionsp->out("\n");
+    optionsp->out("    NOTE: Pareto k > 0.7 indicates unreliable importance sampling\n");
+    optionsp->out("          estimates for these observations\n");
+    }
+
+  optionsp->out("\n");
+
+  }
+
+
+
 void FC_predict_mult::outresults_deviance(void)
     {
 
@@ -488,12 +545,6 @@ void FC_predict_mult::outresults(ofstream & out_stata, ofstream & out_R, ofstrea
 
     FC_deviance.outresults(out_stata,out_R,out_R2BayesX,"");
 
-    if (WAICoff==false)
-      {
-      FC_p.outresults(out_stata,out_R,out_R2BayesX,"");
-      FC_logp.outresults(out_stata,out_R,out_R2BayesX,"");
-      FC_logp2.outresults(out_stata,out_R,out_R2BayesX,"");
-      }
 
     optionsp->out("  PREDICTED VALUES: \n",true);
     optionsp->out("\n");
@@ -817,7 +868,10 @@ void FC_predict_mult::outresults(ofstream & out_stata, ofstream & out_R, ofstrea
      outresults_DIC(out_stata,out_R,out_R2BayesX,pathresults);
 
      if (WAICoff==false)
+       {
        outresults_WAIC(out_stata,out_R,out_R2BayesX,pathresults);
+       outresults_LOO(pathresults);
+       }
 
     }   // end if (pathresults.isvalidfile() != 1)
 
@@ -826,7 +880,7 @@ void FC_predict_mult::outresults(ofstream & out_stata, ofstream & out_R, ofstrea
 
 void FC_predict_mult::reset(void)
   {
-
+  modelcomp.reset();
   }
 
 } // end: namespace MCMC
@@ -35,6 +35,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include"GENERAL_OPTIONS.h"
 #include"distr.h"
 #include"clstring.h"
+#include"model_comparison.h"
 #include<cmath>
 
 namespace MCMC
@@ -54,9 +55,10 @@ class __EXPORT_TYPE FC_predict_mult   : public FC
   protected:
 
   FC FC_deviance;
-  FC FC_p;
-  FC FC_logp;
-  FC FC_logp2;
+
+  // streaming WAIC and PSIS-LOO
+
+  model_comparison modelcomp;
   bool WAICoff;
 
   vector<DISTR *> likep;
@@ -65,7 +67,12 @@ class __EXPORT_TYPE FC_predict_mult   : public FC
 
   double deviance;
 
-  void get_predictor(void);
+  // FUNCTION: get_predictor
+  // TASK: computes predictor, mean and deviance for the current iteration,
+  //       if 'sample' is true the pointwise log-likelihoods are added to
+  //       'modelcomp'
+
+  void get_predictor(const bool & sample=false);
 
   public:
 
@@ -105,6 +112,11 @@ class __EXPORT_TYPE FC_predict_mult   : public FC
                       const ST::string & pathresults);
   void outresults_WAIC(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                       const ST::string & pathresults);
+
+  // FUNCTION: outresults_LOO
+  // TASK: writes the PSIS-LOO results (file *_LOO.res)
+
+  void outresults_LOO(const ST::string & pathresults);
   void outresults(ofstream & out_stata, ofstream & out_R, ofstream & out_R2BayesX,
                   const ST::string & pathresults);
 
@@ -113,6 +125,13 @@ class __EXPORT_TYPE FC_predict_mult   : public FC
 
   void reset(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -244,6 +244,19 @@ void FC_predict_predictor::reset(void)
   }
 
 
+void FC_predict_predictor::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  }
+
+
+void FC_predict_predictor::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  likep->FCpredict_betamean = &betamean;
+  }
+
+
 
 } // end: namespace MCMC
 
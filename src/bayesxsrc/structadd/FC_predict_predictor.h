@@ -98,6 +98,13 @@ class __EXPORT_TYPE FC_predict_predictor   : public FC
 
   void reset(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   void read_options(vector<ST::string> & op,vector<ST::string> & vn);
 
   };
@@ -62,6 +62,16 @@ void FC_shared::reset(void)
   {
   }
 
+void FC_shared::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  }
+
+void FC_shared::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  }
+
 } // end: namespace MCMC
 
 
@@ -74,6 +74,14 @@ class __EXPORT_TYPE FC_shared  : public FC
   bool posteriormode(void);
 
   void reset(void);
+
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -543,6 +543,26 @@ void FC_variance_pen_vector::outresults_shrinkage(const ST::string & pathresults
 // TASK: - write options to output window
 //______________________________________________________________________________
 
+void FC_variance_pen_vector::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  save_value(out,pensum);
+  FC_shrinkage.write_state(out);
+  }
+
+
+void FC_variance_pen_vector::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  load_value(in,pensum);
+  // FC_shrinkage is created in the first iteration
+  if (FC_shrinkage.beta.rows() != shrinkagefix.size())
+    FC_shrinkage = FC(optionsp,"",shrinkagefix.size(),1,
+                      samplepath + ".shrinkage");
+  FC_shrinkage.read_state(in);
+  }
+
+
 void FC_variance_pen_vector::outoptions(void)
   {
 
@@ -1069,6 +1089,28 @@ void FC_variance_pen_vector_ssvs::outresults(ofstream & out_stata, ofstream & ou
   }
 
 
+void FC_variance_pen_vector_ssvs::write_state(ofstream & out)
+  {
+  FC::write_state(out);
+  delta.write_state(out);
+  theta.write_state(out);
+  FC_psi2.write_state(out);
+  FC_omega.write_state(out);
+  FC_delta.write_state(out);
+  }
+
+
+void FC_variance_pen_vector_ssvs::read_state(ifstream & in)
+  {
+  FC::read_state(in);
+  delta.read_state(in);
+  theta.read_state(in);
+  FC_psi2.read_state(in);
+  FC_omega.read_state(in);
+  FC_delta.read_state(in);
+  }
+
+
 void FC_variance_pen_vector_ssvs::outoptions(void)
   {
   FC::outoptions();
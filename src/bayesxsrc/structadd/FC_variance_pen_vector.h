@@ -176,6 +176,13 @@ class __EXPORT_TYPE FC_variance_pen_vector : public FC
 
   ~FC_variance_pen_vector() {}
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   }; // end: class FC_variance_pen_vector
 
 
@@ -243,6 +250,13 @@ class __EXPORT_TYPE FC_variance_pen_vector_ssvs : public FC
 
   void outoptions(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   }; // end: class FC_variance_pen_vector
 
 
@@ -18,6 +18,7 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
 
 #include "GENERAL_OPTIONS.h"
+#include "checkpoint.h"
 
 using std::flush;
 
@@ -49,6 +50,13 @@ GENERAL_OPTIONS::GENERAL_OPTIONS(void)
   IWLSlineff=false;
   forceIWLS=false;
   highspeedon=false;
+  set_convdiag(false,10,0,0,1000);
+  set_checkpoint(0,false);
+  set_adaptiwls(false,0.5);
+  set_fastprobit(false);
+  set_aggregate(false);
+  set_inmemory(false);
+  set_binaryoutput(false);
   }
 
 
@@ -81,6 +89,13 @@ const unsigned & it,const unsigned & bu,
   sampleselval = samselval;
   forceIWLS = fiwls;
   highspeedon = hso;
+  set_convdiag(false,10,0,0,1000);
+  set_checkpoint(0,false);
+  set_adaptiwls(false,0.5);
+  set_fastprobit(false);
+  set_aggregate(false);
+  set_inmemory(false);
+  set_binaryoutput(false);
 
   (*logout) << flush;
   }
@@ -110,6 +125,20 @@ GENERAL_OPTIONS::GENERAL_OPTIONS(const GENERAL_OPTIONS & o)
   IWLSlineff = o.IWLSlineff;
   forceIWLS = o.forceIWLS;
   highspeedon = o.highspeedon;
+  convdiag = o.convdiag;
+  diaglag = o.diaglag;
+  essstop = o.essstop;
+  rhatstop = o.rhatstop;
+  stopcheck = o.stopcheck;
+  storedFC = o.storedFC;
+  checkpoint = o.checkpoint;
+  resume = o.resume;
+  adaptiwls = o.adaptiwls;
+  targetacceptance = o.targetacceptance;
+  fastprobit = o.fastprobit;
+  aggregate = o.aggregate;
+  inmemory = o.inmemory;
+  binaryoutput = o.binaryoutput;
   }
 
 
@@ -139,6 +168,20 @@ const GENERAL_OPTIONS & GENERAL_OPTIONS::operator=(const GENERAL_OPTIONS & o)
   IWLSlineff = o.IWLSlineff;
   forceIWLS = o.forceIWLS;
   highspeedon = o.highspeedon;
+  convdiag = o.convdiag;
+  diaglag = o.diaglag;
+  essstop = o.essstop;
+  rhatstop = o.rhatstop;
+  stopcheck = o.stopcheck;
+  storedFC = o.storedFC;
+  checkpoint = o.checkpoint;
+  resume = o.resume;
+  adaptiwls = o.adaptiwls;
+  targetacceptance = o.targetacceptance;
+  fastprobit = o.fastprobit;
+  aggregate = o.aggregate;
+  inmemory = o.inmemory;
+  binaryoutput = o.binaryoutput;
   return *this;
   }
 
@@ -164,6 +207,30 @@ void GENERAL_OPTIONS::outoptions(void)
     out("  Saveestimation:        enabled\n");
   else
     out("  Saveestimation:        disabled\n");
+  if (convdiag)
+    {
+    out("  Online diagnostics:    enabled\n");
+    if (essstop > 0)
+      out("  Stopping rule ESS:     " + ST::doubletostring(essstop,6) + "\n");
+    if (rhatstop > 0)
+      out("  Stopping rule R-hat:   " + ST::doubletostring(rhatstop,6) + "\n");
+    }
+  if (checkpoint > 0)
+    out("  Checkpoint every:      " + ST::inttostring(checkpoint) +
+        " iterations\n");
+  if (resume)
+    out("  Resume from snapshot:  enabled\n");
+  if (adaptiwls)
+    out("  Adaptive IWLS:         target acceptance " +
+        ST::doubletostring(targetacceptance,4) + "\n");
+  if (fastprobit)
+    out("  Probit latent variables: blocked exact sampler\n");
+  if (aggregate)
+    out("  Likelihood:            grouped by covariate pattern\n");
+  if (inmemory)
+    out("  Results:               kept in memory\n");
+  if (binaryoutput)
+    out("  Output format:         ASCII and binary\n");
   out("\n");
   if (copula)
     {
@@ -205,6 +272,19 @@ void GENERAL_OPTIONS::reset(void)
   {
   nriter = 0;
   samplesize = 0;
+  storedFC.erase(storedFC.begin(),storedFC.end());
+  }
+
+
+void GENERAL_OPTIONS::set_convdiag(const bool & cd,const unsigned & lag,
+                                   const double & ess,const double & rh,
+                                   const unsigned & check)
+  {
+  essstop = ess;
+  rhatstop = rh;
+  convdiag = cd || essstop > 0 || rhatstop > 0;
+  diaglag = lag < 1 ? 1 : lag;
+  stopcheck = check < 1 ? 1 : check;
   }
 
 
@@ -224,6 +304,70 @@ void GENERAL_OPTIONS::set_level2(double l2)
   }
 
 
+void GENERAL_OPTIONS::set_checkpoint(const unsigned & cp,const bool & res)
+  {
+  checkpoint = cp;
+  resume = res;
+  }
+
+
+void GENERAL_OPTIONS::set_adaptiwls(const bool & ad,const double & target)
+  {
+  adaptiwls = ad;
+  targetacceptance = target;
+  }
+
+
+void GENERAL_OPTIONS::set_fastprobit(const bool & fp)
+  {
+  fastprobit = fp;
+  }
+
+
+void GENERAL_OPTIONS::set_aggregate(const bool & ag)
+  {
+  aggregate = ag;
+  }
+
+
+void GENERAL_OPTIONS::set_inmemory(const bool & im)
+  {
+  inmemory = im;
+  }
+
+
+void GENERAL_OPTIONS::set_binaryoutput(const bool & bo)
+  {
+  binaryoutput = bo;
+  }
+
+
+void GENERAL_OPTIONS::write_state(std::ofstream & out) const
+  {
+  save_value(out,iterations);
+  save_value(out,burnin);
+  save_value(out,step);
+  save_value(out,nriter);
+  save_value(out,samplesize);
+  }
+
+
+bool GENERAL_OPTIONS::read_state(std::ifstream & in)
+  {
+  unsigned it,bu,st,nr,ss;
+  load_value(in,it);
+  load_value(in,bu);
+  load_value(in,st);
+  load_value(in,nr);
+  load_value(in,ss);
+  if (in.fail() || (bu != burnin) || (st != step) || (nr > iterations))
+    return false;
+  nriter = nr;
+  samplesize = ss;
+  return true;
+  }
+
+
 } // end: namespace MCMC
 
 
@@ -29,10 +29,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include"clstring.h"
 
 using std::cout;
+using std::vector;
 
 namespace MCMC
 {
 
+class FC;
+
 
 //------------------------------------------------------------------------------
 //--------------------------- CLASS: GENERAL_OPTIONS ---------------------------
@@ -90,6 +93,48 @@ class __EXPORT_TYPE GENERAL_OPTIONS
   bool forceIWLS;
   bool highspeedon;
 
+  // online convergence diagnostics
+
+  bool convdiag;                  // compute diagnostics while sampling
+  unsigned diaglag;               // maximum lag of running autocorrelations
+  double essstop;                 // stop if effective sample sizes of all
+                                  // monitored parameters exceed essstop
+                                  // (essstop = 0: criterion not used)
+  double rhatstop;                // stop if all R-hats are below rhatstop
+                                  // (rhatstop = 0: criterion not used)
+  unsigned stopcheck;             // stopping rule is checked every stopcheck
+                                  // iterations
+
+  vector<FC*> storedFC;           // full conditionals storing samples in the
+                                  // current run (registered in FC::update)
+
+  // checkpoints
+
+  unsigned checkpoint;            // a snapshot of the MCMC state is written
+                                  // every checkpoint iterations and at the
+                                  // end of the simulation
+                                  // (checkpoint = 0: no snapshots)
+  bool resume;                    // continue the simulation from the last
+                                  // snapshot
+
+  // adaptive IWLS proposals
+
+  bool adaptiwls;                 // scale IWLS proposals during the burnin
+                                  // to reach targetacceptance
+  double targetacceptance;        // target acceptance rate of the adaptation
+
+  bool fastprobit;                // exact blocked sampler for the latent
+                                  // variables of probit models
+
+  bool aggregate;                 // identical covariate patterns are
+                                  // collapsed into weighted records
+
+  bool inmemory;                  // results are kept in memory (in-process
+                                  // runs), no result files are written
+
+  bool binaryoutput;              // results and samples are additionally
+                                  // stored in binary files (*.bin)
+
   // DEFAULT CONSTRUCTOR
   // Defines:
   // iterations = 22000
@@ -156,6 +201,67 @@ class __EXPORT_TYPE GENERAL_OPTIONS
 
   void set_level2(double l2);
 
+  // FUNCTION: set_convdiag
+  // TASK: enables online convergence diagnostics and the stopping rule
+
+  void set_convdiag(const bool & cd,const unsigned & lag,const double & ess,
+                    const double & rh,const unsigned & check);
+
+  // FUNCTION: earlystopping
+  // TASK: returns true if the stopping rule is active
+
+  bool earlystopping(void) const
+    {
+    return convdiag && (essstop > 0 || rhatstop > 0);
+    }
+
+  // FUNCTION: set_checkpoint
+  // TASK: defines the number of iterations between snapshots of the MCMC
+  //       state and whether the simulation is resumed from a snapshot
+
+  void set_checkpoint(const unsigned & cp,const bool & res);
+
+  // FUNCTION: set_adaptiwls
+  // TASK: enables the adaptive scaling of IWLS proposals during the burnin
+
+  void set_adaptiwls(const bool & ad,const double & target);
+
+  // FUNCTION: set_fastprobit
+  // TASK: enables the blocked truncated normal sampler for the latent
+  //       variables of probit models
+
+  void set_fastprobit(const bool & fp);
+
+  // FUNCTION: set_aggregate
+  // TASK: enables the grouped likelihood, i.e. observations with identical
+  //       covariates are collapsed into sufficient statistics
+
+  void set_aggregate(const bool & ag);
+
+  // FUNCTION: set_inmemory
+  // TASK: results are kept in memory, i.e. all full conditionals are
+  //       registered in storedFC and no result files are written
+
+  void set_inmemory(const bool & im);
+
+  // FUNCTION: set_binaryoutput
+  // TASK: results are additionally written to binary files, samples are
+  //       written to binary instead of ASCII files (see binary_output)
+
+  void set_binaryoutput(const bool & bo);
+
+  // FUNCTION: write_state
+  // TASK: writes iteration counters to a binary snapshot
+
+  void write_state(std::ofstream & out) const;
+
+  // FUNCTION: read_state
+  // TASK: reads iteration counters from a binary snapshot, returns false if
+  //       the snapshot is incompatible with the current options (different
+  //       burnin or thinning parameter, more iterations than requested)
+
+  bool read_state(std::ifstream & in);
+
   // DESTRUCTOR
 
   ~GENERAL_OPTIONS() {}
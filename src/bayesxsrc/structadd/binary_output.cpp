@@ -0,0 +1,158 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+#include"binary_output.h"
+#include<fstream>
+
+namespace MCMC
+{
+
+using std::ofstream;
+using std::ios;
+
+
+binary_output::binary_output(const ST::string & p,const unsigned & r)
+  {
+  path = p;
+  nrrows = r;
+  }
+
+
+void binary_output::add_column(const ST::string & name,const double * v,
+                               const unsigned & stride)
+  {
+  names.push_back(name);
+  types.push_back(2);
+  doublecols.push_back(v);
+  strides.push_back(stride);
+  intstarts.push_back(0);
+  stringcols.push_back(vector<ST::string>());
+  }
+
+
+void binary_output::add_column(const ST::string & name,
+                               const vector<ST::string> & v)
+  {
+  names.push_back(name);
+  types.push_back(3);
+  doublecols.push_back(NULL);
+  strides.push_back(0);
+  intstarts.push_back(0);
+  stringcols.push_back(v);
+  }
+
+
+void binary_output::add_index(const ST::string & name,const int & start)
+  {
+  names.push_back(name);
+  types.push_back(1);
+  doublecols.push_back(NULL);
+  strides.push_back(0);
+  intstarts.push_back(start);
+  stringcols.push_back(vector<ST::string>());
+  }
+
+
+bool binary_output::write(void) const
+  {
+
+  // large stream buffer, values are copied into 'block' and written with
+  // one call per block
+
+  const unsigned blocksize = 1 << 16;
+  vector<char> streambuffer(1 << 20);
+  vector<double> block(blocksize);
+
+  ofstream out;
+  out.rdbuf()->pubsetbuf(&streambuffer[0],streambuffer.size());
+  out.open(path.strtochar(),ios::binary);
+  if (out.fail())
+    return true;
+
+  unsigned u;
+  unsigned j,k,i;
+
+  out.write("BAYESXB1",8);
+  u = names.size();
+  out.write((const char *) &u,sizeof(unsigned));
+  out.write((const char *) &nrrows,sizeof(unsigned));
+  for (j=0;j<names.size();j++)
+    {
+    out.write((const char *) &types[j],sizeof(unsigned));
+    u = names[j].length();
+    out.write((const char *) &u,sizeof(unsigned));
+    out.write(names[j].strtochar(),u);
+    }
+
+  for (j=0;j<names.size();j++)
+    {
+    if (types[j] == 1)
+      {
+      vector<int> index(nrrows);
+      for (i=0;i<nrrows;i++)
+        index[i] = intstarts[j]+int(i);
+      if (nrrows > 0)
+        out.write((const char *) &index[0],nrrows*sizeof(int));
+      }
+    else if (types[j] == 2)
+      {
+      const double * v = doublecols[j];
+      if (strides[j] == 1)
+        out.write((const char *) v,nrrows*sizeof(double));
+      else
+        {
+        for (i=0;i<nrrows;i+=blocksize)
+          {
+          unsigned n = (nrrows-i < blocksize) ? nrrows-i : blocksize;
+          double * b = &block[0];
+          for (k=0;k<n;k++,b++,v+=strides[j])
+            *b = *v;
+          out.write((const char *) &block[0],n*sizeof(double));
+          }
+        }
+      }
+    else
+      {
+      for (i=0;i<nrrows;i++)
+        {
+        if (i < stringcols[j].size())
+          {
+          u = stringcols[j][i].length();
+          out.write((const char *) &u,sizeof(unsigned));
+          out.write(stringcols[j][i].strtochar(),u);
+          }
+        else
+          {
+          u = 0;
+          out.write((const char *) &u,sizeof(unsigned));
+          }
+        }
+      }
+    }
+
+  out.close();
+
+  return out.fail();
+  }
+
+
+} // end: namespace MCMC
+
@@ -0,0 +1,106 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+#if !defined (BINARYOUTPUT_INCLUDED)
+
+#define BINARYOUTPUT_INCLUDED
+
+#include"../export_type.h"
+#include"clstring.h"
+#include<vector>
+
+namespace MCMC
+{
+
+using std::vector;
+
+//------------------------------------------------------------------------------
+//------------------------- CLASS: binary_output -------------------------------
+//------------------------------------------------------------------------------
+
+// Writes a table (results or samples) as a typed columnar binary file
+// (*.bin). Layout (native byte order, i.e. little endian on all supported
+// platforms):
+//
+//   char[8]  "BAYESXB1"
+//   uint32   number of columns
+//   uint32   number of rows
+//   for each column:
+//     uint32 type (1 = int32, 2 = float64, 3 = string)
+//     uint32 length of the column name, followed by the name
+//   for each column: the values of all rows, strings as uint32 length
+//   followed by the characters
+//
+// In R, a column of type float64 can be read with
+// readBin(con,"double",n=rows,size=8), in Python with
+// numpy.fromfile(f,dtype="<f8",count=rows). Columns are only referenced
+// when added and copied to the file in large blocks by 'write'.
+
+class __EXPORT_TYPE binary_output
+  {
+
+  protected:
+
+  ST::string path;
+  unsigned nrrows;
+
+  vector<ST::string> names;
+  vector<unsigned> types;
+  vector<const double *> doublecols;     // first element of float64 columns
+  vector<unsigned> strides;              // distance between two rows
+  vector<int> intstarts;                 // int32 columns: start,start+1,...
+  vector< vector<ST::string> > stringcols;
+
+  public:
+
+  // CONSTRUCTOR
+  // p : path of the file
+  // r : number of rows
+
+  binary_output(const ST::string & p,const unsigned & r);
+
+  // FUNCTION: add_column
+  // TASK: adds a float64 column with values v[0],v[stride],... The values
+  //       must not be changed or freed before 'write' is called.
+
+  void add_column(const ST::string & name,const double * v,
+                  const unsigned & stride=1);
+
+  // FUNCTION: add_column
+  // TASK: adds a string column (copied)
+
+  void add_column(const ST::string & name,const vector<ST::string> & v);
+
+  // FUNCTION: add_index
+  // TASK: adds an int32 column start,start+1,...
+
+  void add_index(const ST::string & name,const int & start=1);
+
+  // FUNCTION: write
+  // TASK: writes the file, returns true if an error occured
+
+  bool write(void) const;
+
+  };
+
+
+} // end: namespace MCMC
+
+#endif
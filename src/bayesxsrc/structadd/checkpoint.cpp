@@ -0,0 +1,347 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+
+#include"checkpoint.h"
+
+#if defined(__GLIBC__)
+#include<stdlib.h>
+#include<string.h>
+#endif
+
+namespace MCMC
+{
+
+
+template<class T>
+void save_pod(ofstream & out,const T & v)
+  {
+  out.write((const char *) &v,sizeof(T));
+  }
+
+
+template<class T>
+void load_pod(ifstream & in,T & v)
+  {
+  in.read((char *) &v,sizeof(T));
+  }
+
+
+void save_value(ofstream & out,const double & v)
+  {
+  save_pod(out,v);
+  }
+
+
+void save_value(ofstream & out,const int & v)
+  {
+  save_pod(out,v);
+  }
+
+
+void save_value(ofstream & out,const unsigned & v)
+  {
+  save_pod(out,v);
+  }
+
+
+void save_value(ofstream & out,const long & v)
+  {
+  save_pod(out,v);
+  }
+
+
+void save_value(ofstream & out,const unsigned long & v)
+  {
+  save_pod(out,v);
+  }
+
+
+void save_value(ofstream & out,const bool & v)
+  {
+  char c = v ? 1 : 0;
+  save_pod(out,c);
+  }
+
+
+void save_value(ofstream & out,const ST::string & v)
+  {
+  unsigned l = v.length();
+  save_pod(out,l);
+  if (l > 0)
+    out.write(v.strtochar(),l);
+  }
+
+
+template<class T>
+void save_vector(ofstream & out,const vector<T> & v)
+  {
+  unsigned n = v.size();
+  save_pod(out,n);
+  if (n > 0)
+    out.write((const char *) &v[0],sizeof(T)*n);
+  }
+
+
+void save_value(ofstream & out,const vector<double> & v)
+  {
+  save_vector(out,v);
+  }
+
+
+void save_value(ofstream & out,const vector<int> & v)
+  {
+  save_vector(out,v);
+  }
+
+
+template<class T>
+void save_matrix(ofstream & out,const statmatrix<T> & v)
+  {
+  unsigned r = v.rows();
+  unsigned c = v.cols();
+  save_pod(out,r);
+  save_pod(out,c);
+  if (r*c > 0)
+    out.write((const char *) v.getV(),sizeof(T)*r*c);
+  }
+
+
+void save_value(ofstream & out,const datamatrix & v)
+  {
+  save_matrix(out,v);
+  }
+
+
+void save_value(ofstream & out,const statmatrix<unsigned> & v)
+  {
+  save_matrix(out,v);
+  }
+
+
+void save_value(ofstream & out,const statmatrix<int> & v)
+  {
+  save_matrix(out,v);
+  }
+
+
+void load_value(ifstream & in,double & v)
+  {
+  load_pod(in,v);
+  }
+
+
+void load_value(ifstream & in,int & v)
+  {
+  load_pod(in,v);
+  }
+
+
+void load_value(ifstream & in,unsigned & v)
+  {
+  load_pod(in,v);
+  }
+
+
+void load_value(ifstream & in,long & v)
+  {
+  load_pod(in,v);
+  }
+
+
+void load_value(ifstream & in,unsigned long & v)
+  {
+  load_pod(in,v);
+  }
+
+
+void load_value(ifstream & in,bool & v)
+  {
+  char c = 0;
+  load_pod(in,c);
+  v = (c != 0);
+  }
+
+
+void load_value(ifstream & in,ST::string & v)
+  {
+  unsigned l = 0;
+  load_pod(in,l);
+  if (in.fail() || l > 100000)
+    {
+    in.setstate(std::ios::failbit);
+    return;
+    }
+  vector<char> h(l+1,0);
+  if (l > 0)
+    in.read(&h[0],l);
+  v = ST::string(&h[0]);
+  }
+
+
+template<class T>
+void load_vector(ifstream & in,vector<T> & v)
+  {
+  unsigned n = 0;
+  load_pod(in,n);
+  if (in.fail())
+    return;
+  v.resize(n);
+  if (n > 0)
+    in.read((char *) &v[0],sizeof(T)*n);
+  }
+
+
+void load_value(ifstream & in,vector<double> & v)
+  {
+  load_vector(in,v);
+  }
+
+
+void load_value(ifstream & in,vector<int> & v)
+  {
+  load_vector(in,v);
+  }
+
+
+template<class T>
+void load_matrix(ifstream & in,statmatrix<T> & v)
+  {
+  unsigned r = 0;
+  unsigned c = 0;
+  load_pod(in,r);
+  load_pod(in,c);
+  if (in.fail())
+    return;
+  if ((r != v.rows()) || (c != v.cols()))
+    {
+    if (r*c == 0)
+      v = statmatrix<T>();
+    else
+      v = statmatrix<T>(r,c);
+    }
+  if (r*c > 0)
+    in.read((char *) v.getV(),sizeof(T)*r*c);
+  }
+
+
+void load_value(ifstream & in,datamatrix & v)
+  {
+  load_matrix(in,v);
+  }
+
+
+void load_value(ifstream & in,statmatrix<unsigned> & v)
+  {
+  load_matrix(in,v);
+  }
+
+
+void load_value(ifstream & in,statmatrix<int> & v)
+  {
+  load_matrix(in,v);
+  }
+
+
+//------------------------------------------------------------------------------
+//------------------- state of the random number generator ---------------------
+//------------------------------------------------------------------------------
+
+#if defined(__GLIBC__)
+
+// rand() of the GNU C library draws from the state of random(), which is
+// accessible via initstate/setstate. The default state (TYPE_3) consists of
+// 32 words, the first word encodes the type and the current position.
+// setstate stores the current position in the first word of the state it
+// switches from. The generator is moved to randomstate on first use, which
+// does not change the sequence of random numbers.
+
+static const unsigned randomstatesize = 32;
+static const int randomstatetype = 3;
+static const int randommaxtypes = 5;
+static int randomstate[randomstatesize];
+static bool randomstate_used = false;
+
+
+static bool use_randomstate(void)
+  {
+  if (!randomstate_used)
+    {
+    int help[randomstatesize];
+    char * old = initstate(1,(char *) help,sizeof(help));
+    if (((int *) old)[0] % randommaxtypes != randomstatetype)
+      {
+      setstate(old);
+      return false;
+      }
+    memcpy(randomstate,old,sizeof(randomstate));
+    setstate((char *) randomstate);
+    randomstate_used = true;
+    }
+  return true;
+  }
+
+
+bool get_randomstate(vector<int> & s)
+  {
+  if (!use_randomstate())
+    return false;
+  // stores the current position in randomstate[0]
+  setstate((char *) randomstate);
+  s = vector<int>(randomstate,randomstate+randomstatesize);
+  return true;
+  }
+
+
+bool set_randomstate(const vector<int> & s)
+  {
+  if ((s.size() != randomstatesize) ||
+      (s[0] % randommaxtypes != randomstatetype) || !use_randomstate())
+    return false;
+  // the state is installed via help, since setstate overwrites the first
+  // word of the current state (randomstate)
+  int help[randomstatesize];
+  unsigned i;
+  for (i=0;i<randomstatesize;i++)
+    help[i] = s[i];
+  setstate((char *) help);
+  memcpy(randomstate,help,sizeof(randomstate));
+  setstate((char *) randomstate);
+  return true;
+  }
+
+#else
+
+bool get_randomstate(vector<int> & s)
+  {
+  return false;
+  }
+
+
+bool set_randomstate(const vector<int> & s)
+  {
+  return false;
+  }
+
+#endif
+
+
+} // end: namespace MCMC
@@ -0,0 +1,123 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+
+#if !defined (CHECKPOINT_INCLUDED)
+
+#define CHECKPOINT_INCLUDED
+
+#include"../export_type.h"
+#include"statmat.h"
+#include"clstring.h"
+#include<fstream>
+
+namespace MCMC
+{
+
+using std::ofstream;
+using std::ifstream;
+
+//------------------------------------------------------------------------------
+//----------------- binary snapshots of the MCMC state -------------------------
+//------------------------------------------------------------------------------
+
+// Helper functions for writing the current state of an MCMC simulation
+// (parameters, running means, stored samples, counters) to a binary
+// snapshot and for reading it back. Values are stored in the native binary
+// representation, i.e. a snapshot can only be read on the platform it was
+// written on. Reading functions never throw, errors must be checked via
+// the state of the stream (in.fail()).
+
+// FUNCTION: save_value
+// TASK: writes 'v' in binary format to 'out'
+
+void save_value(ofstream & out,const double & v);
+
+void save_value(ofstream & out,const int & v);
+
+void save_value(ofstream & out,const unsigned & v);
+
+void save_value(ofstream & out,const long & v);
+
+void save_value(ofstream & out,const unsigned long & v);
+
+void save_value(ofstream & out,const bool & v);
+
+void save_value(ofstream & out,const ST::string & v);
+
+void save_value(ofstream & out,const vector<double> & v);
+
+void save_value(ofstream & out,const vector<int> & v);
+
+// stores the dimension followed by the elements (row major)
+
+void save_value(ofstream & out,const datamatrix & v);
+
+void save_value(ofstream & out,const statmatrix<unsigned> & v);
+
+void save_value(ofstream & out,const statmatrix<int> & v);
+
+// FUNCTION: load_value
+// TASK: reads a value written with save_value from 'in'
+//       vectors and matrices are resized if the stored dimension differs
+
+void load_value(ifstream & in,double & v);
+
+void load_value(ifstream & in,int & v);
+
+void load_value(ifstream & in,unsigned & v);
+
+void load_value(ifstream & in,long & v);
+
+void load_value(ifstream & in,unsigned long & v);
+
+void load_value(ifstream & in,bool & v);
+
+void load_value(ifstream & in,ST::string & v);
+
+void load_value(ifstream & in,vector<double> & v);
+
+void load_value(ifstream & in,vector<int> & v);
+
+void load_value(ifstream & in,datamatrix & v);
+
+void load_value(ifstream & in,statmatrix<unsigned> & v);
+
+void load_value(ifstream & in,statmatrix<int> & v);
+
+// FUNCTION: get_randomstate
+// TASK: stores the state of the random number generator used by rand()
+//       (and therefore by uniform(), rand_normal(), etc.) in 's'.
+//       Returns false if the state is not accessible on this platform
+
+bool get_randomstate(vector<int> & s);
+
+// FUNCTION: set_randomstate
+// TASK: restores a state obtained with get_randomstate, i.e. rand() continues
+//       with the same random numbers as after the call of get_randomstate.
+//       Returns false if 's' is not a valid state
+
+bool set_randomstate(const vector<int> & s);
+
+
+} // end: namespace MCMC
+
+#endif
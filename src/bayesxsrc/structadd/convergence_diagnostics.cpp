@@ -0,0 +1,473 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+#include "convergence_diagnostics.h"
+
+namespace MCMC
+{
+
+//------------------------------------------------------------------------------
+//------------------- CLASS: convergence_diagnostics ---------------------------
+//------------------------------------------------------------------------------
+
+
+convergence_diagnostics::convergence_diagnostics(void)
+  {
+  nrpar = 0;
+  nrlags = 0;
+  maxbatches = 0;
+  batchsize = 1;
+  nrbatches = 0;
+  currentcount = 0;
+  nrdraws = 0;
+  bufferpos = 0;
+  }
+
+
+convergence_diagnostics::convergence_diagnostics(const unsigned & np,
+                                const unsigned & nl, const unsigned & mb)
+  {
+  nrpar = np;
+  nrlags = nl;
+  if (nrlags < 1)
+    nrlags = 1;
+  maxbatches = mb;
+  if (maxbatches < 4)
+    maxbatches = 4;
+  if (maxbatches % 2 == 1)
+    maxbatches++;
+
+  batchsize = 1;
+  nrbatches = 0;
+  currentcount = 0;
+  nrdraws = 0;
+
+  shift = datamatrix(1,nrpar,0);
+  batchsum = datamatrix(maxbatches,nrpar,0);
+  batchsum2 = datamatrix(maxbatches,nrpar,0);
+  currentsum = datamatrix(1,nrpar,0);
+  currentsum2 = datamatrix(1,nrpar,0);
+  sum = datamatrix(1,nrpar,0);
+  sum2 = datamatrix(1,nrpar,0);
+  lagsum = datamatrix(nrlags,nrpar,0);
+  lagbuffer = datamatrix(nrlags,nrpar,0);
+  bufferpos = nrlags-1;
+  }
+
+
+convergence_diagnostics::convergence_diagnostics(
+                                      const convergence_diagnostics & d)
+  {
+  nrpar = d.nrpar;
+  nrlags = d.nrlags;
+  maxbatches = d.maxbatches;
+  batchsize = d.batchsize;
+  nrbatches = d.nrbatches;
+  currentcount = d.currentcount;
+  nrdraws = d.nrdraws;
+  shift = d.shift;
+  batchsum = d.batchsum;
+  batchsum2 = d.batchsum2;
+  currentsum = d.currentsum;
+  currentsum2 = d.currentsum2;
+  sum = d.sum;
+  sum2 = d.sum2;
+  lagsum = d.lagsum;
+  lagbuffer = d.lagbuffer;
+  bufferpos = d.bufferpos;
+  }
+
+
+const convergence_diagnostics & convergence_diagnostics::operator=(
+                                      const convergence_diagnostics & d)
+  {
+  if (this == &d)
+    return *this;
+  nrpar = d.nrpar;
+  nrlags = d.nrlags;
+  maxbatches = d.maxbatches;
+  batchsize = d.batchsize;
+  nrbatches = d.nrbatches;
+  currentcount = d.currentcount;
+  nrdraws = d.nrdraws;
+  shift = d.shift;
+  batchsum = d.batchsum;
+  batchsum2 = d.batchsum2;
+  currentsum = d.currentsum;
+  currentsum2 = d.currentsum2;
+  sum = d.sum;
+  sum2 = d.sum2;
+  lagsum = d.lagsum;
+  lagbuffer = d.lagbuffer;
+  bufferpos = d.bufferpos;
+  return *this;
+  }
+
+
+void convergence_diagnostics::update(const double * draw,
+                                     const double & addon)
+  {
+  if (nrpar == 0)
+    return;
+
+  unsigned j,k;
+  double x;
+
+  if (nrdraws == 0)
+    {
+    double * shiftp = shift.getV();
+    for (j=0;j<nrpar;j++,shiftp++)
+      *shiftp = draw[j]+addon;
+    }
+
+  // running autocorrelations, lagged draws are taken from the ring buffer
+
+  unsigned nrlagsav = nrdraws < nrlags ? nrdraws : nrlags;
+  unsigned row;
+  double * lagsump;
+  double * bufferp;
+  double * shiftp;
+  for (k=1;k<=nrlagsav;k++)
+    {
+    row = (bufferpos+nrlags+1-k) % nrlags;
+    lagsump = lagsum.getV()+(k-1)*nrpar;
+    bufferp = lagbuffer.getV()+row*nrpar;
+    shiftp = shift.getV();
+    for (j=0;j<nrpar;j++,lagsump++,bufferp++,shiftp++)
+      *lagsump += (draw[j]+addon-*shiftp) * (*bufferp);
+    }
+
+  bufferpos = (bufferpos+1) % nrlags;
+  bufferp = lagbuffer.getV()+bufferpos*nrpar;
+  shiftp = shift.getV();
+  double * currentsump = currentsum.getV();
+  double * currentsum2p = currentsum2.getV();
+  double * sump = sum.getV();
+  double * sum2p = sum2.getV();
+  for (j=0;j<nrpar;j++,bufferp++,shiftp++,currentsump++,currentsum2p++,
+       sump++,sum2p++)
+    {
+    x = draw[j]+addon-*shiftp;
+    *bufferp = x;
+    *currentsump += x;
+    *currentsum2p += x*x;
+    *sump += x;
+    *sum2p += x*x;
+    }
+
+  nrdraws++;
+  currentcount++;
+
+  if (currentcount == batchsize)
+    {
+    double * batchsump = batchsum.getV()+nrbatches*nrpar;
+    double * batchsum2p = batchsum2.getV()+nrbatches*nrpar;
+    currentsump = currentsum.getV();
+    currentsum2p = currentsum2.getV();
+    for (j=0;j<nrpar;j++,batchsump++,batchsum2p++,currentsump++,
+         currentsum2p++)
+      {
+      *batchsump = *currentsump;
+      *batchsum2p = *currentsum2p;
+      *currentsump = 0;
+      *currentsum2p = 0;
+      }
+    nrbatches++;
+    currentcount = 0;
+    if (nrbatches == maxbatches)
+      merge_batches();
+    }
+
+  }
+
+
+void convergence_diagnostics::merge_batches(void)
+  {
+  unsigned i,j;
+  unsigned half = maxbatches/2;
+  for (i=0;i<half;i++)
+    {
+    double * to = batchsum.getV()+i*nrpar;
+    double * from = batchsum.getV()+2*i*nrpar;
+    double * to2 = batchsum2.getV()+i*nrpar;
+    double * from2 = batchsum2.getV()+2*i*nrpar;
+    for (j=0;j<nrpar;j++,to++,from++,to2++,from2++)
+      {
+      *to = *from + from[nrpar];
+      *to2 = *from2 + from2[nrpar];
+      }
+    }
+  nrbatches = half;
+  batchsize *= 2;
+  }
+
+
+bool convergence_diagnostics::ready(void) const
+  {
+  return (nrpar > 0) && (nrbatches >= maxbatches/2) &&
+         (batchsize >= maxbatches/2);
+  }
+
+
+double convergence_diagnostics::batchmeans_variance(const unsigned & j,
+                                                    double & var) const
+  {
+  if (nrbatches < 2)
+    {
+    var = 0;
+    return 0;
+    }
+
+  unsigned i;
+  double n = double(nrbatches)*double(batchsize);
+  double s = 0;
+  double s2 = 0;
+  for (i=0;i<nrbatches;i++)
+    {
+    s += batchsum(i,j);
+    s2 += batchsum2(i,j);
+    }
+  double mean = s/n;
+  var = (s2-n*mean*mean)/(n-1);
+
+  double bm;
+  double ssq = 0;
+  for (i=0;i<nrbatches;i++)
+    {
+    bm = batchsum(i,j)/double(batchsize)-mean;
+    ssq += bm*bm;
+    }
+
+  return double(batchsize)*ssq/double(nrbatches-1);
+  }
+
+
+double convergence_diagnostics::ess(const unsigned & j) const
+  {
+  double var;
+  double sigma2 = batchmeans_variance(j,var);
+  double n = double(nrbatches)*double(batchsize);
+  if (sigma2 <= 0 || var <= 0)
+    return n;
+  return n*var/sigma2;
+  }
+
+
+double convergence_diagnostics::rhat(const unsigned & j) const
+  {
+  unsigned h = nrbatches/2;
+  if (h < 1)
+    return 1;
+
+  unsigned i,s;
+  double ns = double(h)*double(batchsize);
+  double m[2];
+  double v[2];
+  double sum1,sum2h;
+  for (s=0;s<2;s++)
+    {
+    sum1 = 0;
+    sum2h = 0;
+    for (i=s*h;i<(s+1)*h;i++)
+      {
+      sum1 += batchsum(i,j);
+      sum2h += batchsum2(i,j);
+      }
+    m[s] = sum1/ns;
+    v[s] = ns > 1 ? (sum2h-ns*m[s]*m[s])/(ns-1) : 0;
+    }
+
+  double W = 0.5*(v[0]+v[1]);
+  if (W <= 0)
+    return 1;
+  double mall = 0.5*(m[0]+m[1]);
+  double B = ns*((m[0]-mall)*(m[0]-mall)+(m[1]-mall)*(m[1]-mall));
+  double varplus = (ns-1)/ns*W + B/ns;
+  return sqrt(varplus/W);
+  }
+
+
+double convergence_diagnostics::geweke(const unsigned & j) const
+  {
+  if (nrbatches < 4)
+    return 0;
+
+  unsigned i;
+  unsigned nA = nrbatches/10;
+  if (nA < 1)
+    nA = 1;
+  unsigned nB = nrbatches/2;
+
+  double sA = 0;
+  for (i=0;i<nA;i++)
+    sA += batchsum(i,j);
+  double sB = 0;
+  for (i=nrbatches-nB;i<nrbatches;i++)
+    sB += batchsum(i,j);
+
+  double drawsA = double(nA)*double(batchsize);
+  double drawsB = double(nB)*double(batchsize);
+
+  double var;
+  double sigma2 = batchmeans_variance(j,var);
+  if (sigma2 <= 0)
+    return 0;
+
+  return (sA/drawsA-sB/drawsB)/sqrt(sigma2/drawsA+sigma2/drawsB);
+  }
+
+
+double convergence_diagnostics::autocorr(const unsigned & j,
+                                         const unsigned & lag) const
+  {
+  if (lag < 1 || lag > nrlags || nrdraws <= lag)
+    return 0;
+  double n = nrdraws;
+  double mean = sum(0,j)/n;
+  double var = sum2(0,j)/n-mean*mean;
+  if (var <= 0)
+    return 0;
+  return (lagsum(lag-1,j)/(n-lag)-mean*mean)/var;
+  }
+
+
+double convergence_diagnostics::min_ess(void) const
+  {
+  unsigned j;
+  double e;
+  double m = 0;
+  for (j=0;j<nrpar;j++)
+    {
+    e = ess(j);
+    if (j==0 || e < m)
+      m = e;
+    }
+  return m;
+  }
+
+
+double convergence_diagnostics::max_rhat(void) const
+  {
+  unsigned j;
+  double r;
+  double m = 1;
+  for (j=0;j<nrpar;j++)
+    {
+    r = rhat(j);
+    if (r > m)
+      m = r;
+    }
+  return m;
+  }
+
+
+double convergence_diagnostics::max_geweke(void) const
+  {
+  unsigned j;
+  double z;
+  double m = 0;
+  for (j=0;j<nrpar;j++)
+    {
+    z = fabs(geweke(j));
+    if (z > m)
+      m = z;
+    }
+  return m;
+  }
+
+
+double convergence_diagnostics::max_autocorr(const unsigned & lag) const
+  {
+  unsigned j;
+  double a;
+  double m = 0;
+  for (j=0;j<nrpar;j++)
+    {
+    a = fabs(autocorr(j,lag));
+    if (a > m)
+      m = a;
+    }
+  return m;
+  }
+
+
+bool convergence_diagnostics::converged(const double & essmin,
+                                        const double & rhatmax) const
+  {
+  if (!ready())
+    return false;
+
+  unsigned j;
+  for (j=0;j<nrpar;j++)
+    {
+    if (essmin > 0 && ess(j) < essmin)
+      return false;
+    if (rhatmax > 0 && rhat(j) > rhatmax)
+      return false;
+    }
+  return true;
+  }
+
+
+void convergence_diagnostics::write_state(ofstream & out) const
+  {
+  save_value(out,nrpar);
+  save_value(out,nrlags);
+  save_value(out,maxbatches);
+  save_value(out,batchsize);
+  save_value(out,nrbatches);
+  save_value(out,currentcount);
+  save_value(out,nrdraws);
+  save_value(out,bufferpos);
+  save_value(out,shift);
+  save_value(out,batchsum);
+  save_value(out,batchsum2);
+  save_value(out,currentsum);
+  save_value(out,currentsum2);
+  save_value(out,sum);
+  save_value(out,sum2);
+  save_value(out,lagsum);
+  save_value(out,lagbuffer);
+  }
+
+
+void convergence_diagnostics::read_state(ifstream & in)
+  {
+  load_value(in,nrpar);
+  load_value(in,nrlags);
+  load_value(in,maxbatches);
+  load_value(in,batchsize);
+  load_value(in,nrbatches);
+  load_value(in,currentcount);
+  load_value(in,nrdraws);
+  load_value(in,bufferpos);
+  load_value(in,shift);
+  load_value(in,batchsum);
+  load_value(in,batchsum2);
+  load_value(in,currentsum);
+  load_value(in,currentsum2);
+  load_value(in,sum);
+  load_value(in,sum2);
+  load_value(in,lagsum);
+  load_value(in,lagbuffer);
+  }
+
+
+} // end: namespace MCMC
@@ -0,0 +1,199 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+
+#if !defined (CONVDIAG_INCLUDED)
+
+#define CONVDIAG_INCLUDED
+
+#include"../export_type.h"
+#include"statmat.h"
+#include"checkpoint.h"
+
+namespace MCMC
+{
+
+//------------------------------------------------------------------------------
+//------------------- CLASS: convergence_diagnostics ---------------------------
+//------------------------------------------------------------------------------
+
+// Online convergence diagnostics for the retained draws of one full
+// conditional. All quantities are updated incrementally from each stored
+// draw, i.e. no access to the matrix of sampled parameters is required.
+//
+// - batch means: the retained draws are collected in at most 'maxbatches'
+//   batches. If all batches are filled, neighbouring batches are merged and
+//   the batch size is doubled, i.e. memory is constant in the chain length.
+// - effective sample size: batch means estimate of the asymptotic variance
+// - R-hat: potential scale reduction factor for the two halves of the
+//   completed batches (split R-hat, BayesX runs a single chain)
+// - Geweke z-score: first 10% versus last 50% of the completed batches,
+//   standardized with the batch means estimate of the asymptotic variance
+// - running autocorrelations for lags 1 - 'nrlags'
+//
+// All sums are computed for draws shifted by the first draw to avoid
+// cancellation for parameters with large means relative to their variance.
+
+class __EXPORT_TYPE convergence_diagnostics
+  {
+
+  protected:
+
+  unsigned nrpar;                  // number of monitored parameters
+  unsigned nrlags;                 // maximum lag of autocorrelations
+  unsigned maxbatches;             // maximum number of batches (even)
+
+  unsigned batchsize;              // current size of a batch
+  unsigned nrbatches;              // number of completed batches
+  unsigned currentcount;           // number of draws in the current batch
+  unsigned nrdraws;                // total number of processed draws
+
+  datamatrix shift;                // 1 x nrpar, first draw
+  datamatrix batchsum;             // maxbatches x nrpar, sums of batches
+  datamatrix batchsum2;            // maxbatches x nrpar, sums of squares
+  datamatrix currentsum;           // 1 x nrpar, sum of current batch
+  datamatrix currentsum2;          // 1 x nrpar, sum of squares of current
+                                   // batch
+  datamatrix sum;                  // 1 x nrpar, sum of all draws
+  datamatrix sum2;                 // 1 x nrpar, sum of squares of all draws
+  datamatrix lagsum;               // nrlags x nrpar, sum of x_t*x_(t-k)
+  datamatrix lagbuffer;            // nrlags x nrpar, ring buffer of the
+                                   // last nrlags draws
+  unsigned bufferpos;              // position of the last draw in lagbuffer
+
+  // FUNCTION: merge_batches
+  // TASK: merges neighbouring batches and doubles the batch size
+
+  void merge_batches(void);
+
+  // FUNCTION: batchmeans_variance
+  // TASK: returns the batch means estimate of the asymptotic variance
+  //       of parameter j (based on the completed batches), 'var' returns
+  //       the sample variance of the draws in the completed batches
+
+  double batchmeans_variance(const unsigned & j,double & var) const;
+
+  public:
+
+  // DEFAULT CONSTRUCTOR
+
+  convergence_diagnostics(void);
+
+  // CONSTRUCTOR
+  // np : number of parameters
+  // nl : maximum lag for running autocorrelations
+  // mb : maximum number of batches
+
+  convergence_diagnostics(const unsigned & np,const unsigned & nl,
+                          const unsigned & mb=40);
+
+  // COPY CONSTRUCTOR
+
+  convergence_diagnostics(const convergence_diagnostics & d);
+
+  // OVERLOADED ASSIGNMENT OPERATOR
+
+  const convergence_diagnostics & operator=(
+                                       const convergence_diagnostics & d);
+
+  // DESTRUCTOR
+
+  ~convergence_diagnostics() {}
+
+  // FUNCTION: update
+  // TASK: adds a new draw (nrpar consecutive values starting at 'draw',
+  //       each shifted by 'addon')
+
+  void update(const double * draw,const double & addon=0);
+
+  // FUNCTION: get_nrpar, get_nrdraws
+
+  unsigned get_nrpar(void) const
+    {
+    return nrpar;
+    }
+
+  unsigned get_nrdraws(void) const
+    {
+    return nrdraws;
+    }
+
+  unsigned get_nrlags(void) const
+    {
+    return nrlags;
+    }
+
+  // FUNCTION: ready
+  // TASK: returns true if enough batches are available to compute
+  //       the diagnostics
+
+  bool ready(void) const;
+
+  // FUNCTION: ess
+  // TASK: batch means effective sample size of parameter j
+
+  double ess(const unsigned & j) const;
+
+  // FUNCTION: rhat
+  // TASK: split R-hat of parameter j
+
+  double rhat(const unsigned & j) const;
+
+  // FUNCTION: geweke
+  // TASK: Geweke z-score of parameter j
+
+  double geweke(const unsigned & j) const;
+
+  // FUNCTION: autocorr
+  // TASK: running autocorrelation of parameter j at lag 'lag'
+  //       (1 <= lag <= nrlags)
+
+  double autocorr(const unsigned & j,const unsigned & lag) const;
+
+  // FUNCTION: min_ess, max_rhat, max_geweke, max_autocorr
+  // TASK: summaries over all parameters
+
+  double min_ess(void) const;
+
+  double max_rhat(void) const;
+
+  double max_geweke(void) const;
+
+  double max_autocorr(const unsigned & lag) const;
+
+  // FUNCTION: converged
+  // TASK: returns true if ess >= essmin and rhat <= rhatmax for all
+  //       parameters. Criteria with essmin <= 0 or rhatmax <= 0 are ignored.
+
+  bool converged(const double & essmin,const double & rhatmax) const;
+
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the complete state to/from a binary snapshot
+
+  void write_state(ofstream & out) const;
+
+  void read_state(ifstream & in);
+
+  };
+
+
+} // end: namespace MCMC
+
+#endif
@@ -37,7 +37,15 @@ void DESIGN::compute_orthogonaldecomp(void)
   datamatrix R = XWX.getL();
   datamatrix Rt = R.transposed();
   datamatrix Kd = K.get();
-  datamatrix RinvKRtinv = R.inverse()*Kd*Rt.inverse();
+
+  // the inverses of R and R' are computed once and reused, products are
+  // formed in place
+  datamatrix Rinv = R.inverse();
+  datamatrix Rtinv = Rt.inverse();
+  datamatrix help(nrpar,nrpar);
+  datamatrix RinvKRtinv(nrpar,nrpar);
+  help.mult(Rinv,Kd);
+  RinvKRtinv.mult(help,Rtinv);
 
   s = datamatrix(nrpar,1,0);
 
@@ -50,8 +58,10 @@ void DESIGN::compute_orthogonaldecomp(void)
   // s.prettyPrint(out);
   // TEST
 
-  QtRinv = RinvKRtinv.transposed()*R.inverse();
-  RtinvQ = Rt.inverse()*RinvKRtinv;
+  QtRinv = datamatrix(nrpar,nrpar);
+  QtRinv.mult(RinvKRtinv.transposed(),Rinv);
+  RtinvQ = datamatrix(nrpar,nrpar);
+  RtinvQ.mult(Rtinv,RinvKRtinv);
 
   u = datamatrix(nrpar,1,0);
 
@@ -331,6 +341,8 @@ DESIGN::DESIGN(GENERAL_OPTIONS * o,DISTR * lp,FC_linear * fcp)
 
   position_lin = -1;
 
+  XWX_nrupdates = 0;
+
   errors=false;
   }
 
@@ -394,6 +406,9 @@ DESIGN::DESIGN(const DESIGN & m)
   precision = m.precision;
   precisiondeclared = m.precisiondeclared;
   Wsum = m.Wsum;
+  WsumXWX = m.WsumXWX;
+  Wsum_changed = m.Wsum_changed;
+  XWX_nrupdates = m.XWX_nrupdates;
 
   XWres = m.XWres;
   XWres_p = m.XWres_p;
@@ -476,6 +491,9 @@ const DESIGN & DESIGN::operator=(const DESIGN & m)
   precision = m.precision;
   precisiondeclared = m.precisiondeclared;
   Wsum = m.Wsum;
+  WsumXWX = m.WsumXWX;
+  Wsum_changed = m.Wsum_changed;
+  XWX_nrupdates = m.XWX_nrupdates;
 
   XWres = m.XWres;
   XWres_p = m.XWres_p;
@@ -601,6 +619,65 @@ void DESIGN::compute_XtransposedWX(void)
     {
     int i;
 
+    // at most XWXincrement_maxfrac*Wsum.rows() changed sums of weights are
+    // added to the previous X'WX, after XWXincrement_maxupdates such updates
+    // X'WX is recomputed to avoid the accumulation of rounding errors
+
+    const double XWXincrement_maxfrac = 0.2;
+    const unsigned XWXincrement_maxupdates = 50;
+
+    unsigned nrcat = Wsum.rows();
+
+    if ((changingdesign==false) && (WsumXWX.size()==nrcat) &&
+        (XWX_nrupdates < XWXincrement_maxupdates))
+      {
+      unsigned g;
+      unsigned maxchanged = unsigned(XWXincrement_maxfrac*nrcat);
+      bool ok = true;
+      double * Wsump = Wsum.getV();
+      Wsum_changed.erase(Wsum_changed.begin(),Wsum_changed.end());
+      for (g=0;g<nrcat && ok;g++,Wsump++)
+        {
+        if (*Wsump != WsumXWX[g])
+          {
+          if (Wsum_changed.size() < maxchanged)
+            Wsum_changed.push_back(g);
+          else
+            ok = false;
+          }
+        }
+
+      if (ok)
+        {
+        vector<double>::iterator diag = XWX.getDiagIterator();
+        vector<double>::iterator env = XWX.getEnvIterator();
+        vector<unsigned>::iterator xenv = XWX.getXenvIterator();
+        unsigned k,ka,kb;
+        int a,b;
+        double dW,za;
+        for (k=0;k<Wsum_changed.size();k++)
+          {
+          g = Wsum_changed[k];
+          dW = Wsum(g,0)-WsumXWX[g];
+          for (ka=0;ka<Zout.cols();ka++)
+            {
+            a = index_Zout(g,ka);
+            za = dW*Zout(g,ka);
+            diag[a] += za*Zout(g,ka);
+            for (kb=0;kb<Zout.cols();kb++)
+              {
+              b = index_Zout(g,kb);
+              if ((b < a) && (unsigned(a-b) <= xenv[a+1]-xenv[a]))
+                env[xenv[a+1]-(a-b)] += za*Zout(g,kb);
+              }
+            }
+          WsumXWX[g] = Wsum(g,0);
+          }
+        XWX_nrupdates++;
+        return;
+        }
+      }
+
     if (ZoutTZout_d.size() <= 1)
       {
 
@@ -648,7 +725,7 @@ void DESIGN::compute_XtransposedWX(void)
     vector<int>::iterator Wsumpp = Wsump.begin();
     unsigned  nr=0;
 
-    unsigned k;
+    int k;                 // signed: end = beg-1 for pairs without overlap
     int beg, end;
 
     for(i=0;i<int(nrpar);i++,++xenv)
@@ -682,6 +759,9 @@ void DESIGN::compute_XtransposedWX(void)
       start = *xenv;
       }
 
+    WsumXWX = vector<double>(Wsum.getV(),Wsum.getV()+nrcat);
+    XWX_nrupdates = 0;
+
     }
 
   // TEST
@@ -1655,6 +1735,47 @@ void DESIGN::outbasis_R(ofstream & out)
 
   }
 
+
+void DESIGN::write_state(ofstream & out)
+  {
+  save_value(out,intvar);
+  save_value(out,intvar2);
+  save_value(out,meaneffectintvar);
+  save_value(out,Wsum);
+  if (changingdesign)
+    {
+    save_value(out,data);
+    save_value(out,ind);
+    save_value(out,index_data);
+    save_value(out,posbeg);
+    save_value(out,posend);
+    }
+  }
+
+
+void DESIGN::read_state(ifstream & in)
+  {
+  load_value(in,intvar);
+  load_value(in,intvar2);
+  load_value(in,meaneffectintvar);
+  load_value(in,Wsum);
+  if (changingdesign)
+    {
+    load_value(in,data);
+    load_value(in,ind);
+    load_value(in,index_data);
+    load_value(in,posbeg);
+    load_value(in,posend);
+    }
+
+  // Wsum and X'WX are recomputed only if the weights change, i.e. X'WX must
+  // be based on the restored sums of weights and not on those of the
+  // posterior mode
+
+  WsumXWX = vector<double>();
+  compute_XtransposedWX();
+  }
+
 void DESIGN::test(ST::string path)
   {
   ST::string pathposbeg = path + "_posbeg.res";
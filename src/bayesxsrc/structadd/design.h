@@ -209,8 +209,8 @@ class __EXPORT_TYPE DESIGN
 
   // --------------------------- for center ------------------------------------
 
-  double compute_sumBk(unsigned & k);
-  double compute_sumBk_different(unsigned & k);
+  virtual double compute_sumBk(unsigned & k);
+  virtual double compute_sumBk_different(unsigned & k);
 
   bool center;
   centerm centermethod;
@@ -251,6 +251,12 @@ class __EXPORT_TYPE DESIGN
 
   datamatrix Wsum;
 
+  vector<double> WsumXWX;                    // Wsum used for the current XWX
+  vector<unsigned> Wsum_changed;             // categories with changed Wsum
+  unsigned XWX_nrupdates;                    // incremental updates of XWX
+                                             // since the last full
+                                             // computation
+
   envmatdouble XWX;                          // X'WX
   envmatdouble * XWX_p;                      // Pointer to the current
                                              // XWX object
@@ -370,6 +376,8 @@ class __EXPORT_TYPE DESIGN
 
   // FUNCTION: compute_XtransposedWX_XtransposedWres
   // TASK: computes XWX and XWres, res is the partial residual
+  //       if only a few sums of weights Wsum changed since the last
+  //       computation, XWX is updated by the changed categories only
 
   virtual void compute_XtransposedWX(void);
 
@@ -394,6 +402,18 @@ class __EXPORT_TYPE DESIGN
 
   virtual void compute_orthogonaldecomp(void);
 
+  // FUNCTION: write_state
+  // TASK: writes quantities that are modified during the simulation
+  //       (e.g. interaction variables of multiplicative effects) to a
+  //       binary snapshot
+
+  virtual void write_state(ofstream & out);
+
+  // FUNCTION: read_state
+  // TASK: restores the state written by write_state
+
+  virtual void read_state(ifstream & in);
+
   // --------------------- END: VIRTUAL FUNCTIONS ------------------------------
 
   // DESTRUCTOR
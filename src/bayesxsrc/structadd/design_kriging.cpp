@@ -133,6 +133,13 @@ DESIGN_kriging::DESIGN_kriging(void) : DESIGN()
   }
 
 
+DESIGN_kriging::DESIGN_kriging(GENERAL_OPTIONS * o,DISTR * dp,FC_linear * fcl)
+  : DESIGN(o,dp,fcl)
+  {
+  mapexisting = false;
+  }
+
+
 void DESIGN_kriging::read_knots_from_data(void)
   {
   if (knotdatapath!="")
@@ -46,13 +46,18 @@ namespace MCMC
 class __EXPORT_TYPE DESIGN_kriging : public DESIGN
   {
 
+  void compute_tildeZ(void);
+
+  protected:
+
   void read_options(vector<ST::string> & op,vector<ST::string> & vn);
 
   double compute_matern(double & nu,double & r);
 
-  void compute_tildeZ(void);
+  // CONSTRUCTOR (for derived classes)
+  // only the general part of the design is initialized
 
-  protected:
+  DESIGN_kriging(GENERAL_OPTIONS * o,DISTR * dp,FC_linear * fcl);
 
   double rho;
   double maxdist;
@@ -152,8 +152,10 @@ DESIGN_pspline::DESIGN_pspline(datamatrix & dm,datamatrix & iv,
   if (round != -1)
     {
     unsigned i;
+    double r = pow(10,round);
+    double rinv = pow(10,-round);
     for(i=0;i<dmr.rows();i++)
-      dmr(i,0) =  floor(dm(i,0) * pow( 10, round) + 0.5) * pow(10, -round);
+      dmr(i,0) =  floor(dm(i,0) * r + 0.5) * rinv;
 
     // TEST
     // ofstream out("c:\\bayesx\\test\\results\\dmr.res");
@@ -310,7 +312,7 @@ void DESIGN_pspline::make_Bspline(void)
   unsigned i,j,k;
   double value;
 
-  datamatrix help;
+  vector<double> help(degree+2,0.0);
 
 // berechne x_min, x_max
 
@@ -338,20 +340,17 @@ void DESIGN_pspline::make_Bspline(void)
   double * work = Zout.getV();
   int * work_index = index_Zout.getV();
 
-  help = datamatrix(nrpar,1,0.0);
-
-
+  // data is sorted, i.e. the search for the knot interval continues at the
+  // interval of the previous value
 
+  j=0;
   for (i=0;i<posbeg.size();i++)
     {
     value = data(posbeg[i],0);
-    j=0;
-    while(knot[degree+j+1] <= value)
-      j++;
-    help.assign(bspline(value));
+    bspline_nonnull(value,j,&help[0]);
     for (k=0;k<Zout.cols();k++,work++,work_index++)
       {
-      *work = help(k+j,0);
+      *work = help[k];
       *work_index = j+k;
       }
 
@@ -421,41 +420,53 @@ void DESIGN_pspline::make_Bspline(void)
   }
 
 
-datamatrix DESIGN_pspline::bspline(const double & x)
+void DESIGN_pspline::bspline_nonnull(const double & x,unsigned & j,
+                                     double * b,bool deriv)
   {
-// nach Haemmerlin/Hoffmann
-  datamatrix b(nrpar,1,0.0);
-  datamatrix help(nrpar+degree,1,0.0);
-  unsigned j;
-  double * bwork;
-  double * helpwork;
+// nach Haemmerlin/Hoffmann, only the non null B-splines
+// j+0,...,j+degree are computed, b[k] corresponds to B-spline j+k
+
+  int d = degree;
+  int jmax = int(nrpar)-1-d;
+  int l,k;
+  unsigned idx;
+
+// knot interval: knot[degree+j] <= x < knot[degree+j+1]
+
+  if ((int(j) > jmax) || (knot[d+j] > x))
+    j = 0;
+  while((int(j) < jmax) && (knot[d+j+1] <= x))
+    j++;
 
 // Grad 0
 
-  for(j=0;j<nrpar;j++)
-    if( knot[j]<=x && x<knot[j+1])
-      b(j,0) = 1.0;
+  for(k=0;k<=d+1;k++)
+    b[k] = 0.0;
+  b[d] = 1.0;
 
-  for(int l=1;l<=degree;l++)
+  int lmax = deriv ? d-1 : d;
+
+  for(l=1;l<=lmax;l++)
     {
-    bwork = b.getV();
-    helpwork = help.getV();
-    for(j=0;j<nrpar;j++,++helpwork,++bwork)
-//      help(j,0) = b(j,0);
-      *helpwork = *bwork;
-    bwork = b.getV();
-    helpwork = help.getV();
-    for(j=0;j<nrpar;j++,++helpwork,++bwork)
+    for(k=d-l;k<=d;k++)
       {
-//      b(j,0) = (x-knot[j])*help(j,0)/(knot[j+l]-knot[j])
-//                  + (knot[j+l+1]-x)*help(j+1,0)/(knot[j+l+1]-knot[j+1]);
-      *bwork = (x-knot[j])**helpwork/(knot[j+l]-knot[j])
-                  + (knot[j+l+1]-x)**(helpwork+1)/(knot[j+l+1]-knot[j+1]);
-
+      idx = j+k;
+      b[k] = (x-knot[idx])*b[k]/(knot[idx+l]-knot[idx])
+             + (knot[idx+l+1]-x)*b[k+1]/(knot[idx+l+1]-knot[idx+1]);
       }
     }
 
-  return b;
+// Haemmerlin/Hoffmann Seite 263
+
+  if (deriv)
+    {
+    for(k=0;k<=d;k++)
+      {
+      idx = j+k;
+      b[k] = degree*( b[k]/(knot[idx+degree]-knot[idx]) -
+                      b[k+1]/(knot[idx+degree+1]-knot[idx+1]) );
+      }
+    }
 
   }
 
@@ -466,25 +477,21 @@ void DESIGN_pspline::make_Bspline_derivative(void)
   unsigned i,j,k;
   double value;
 
-  datamatrix help;
+  vector<double> help(degree+2,0.0);
 
 
   Zout_derivative = datamatrix(posbeg.size(),degree+1,0.0);
   double * work = Zout_derivative.getV();
 
-  help = datamatrix(nrpar,1,0.0);
-
+  j=0;
   for (i=0;i<posbeg.size();i++)
     {
     value = data(posbeg[i],0);
-    j=0;
-    while(knot[degree+j+1] <= value)
-      j++;
-    help.assign(bspline_derivative(value));
+    bspline_nonnull(value,j,&help[0],true);
 
     for (k=0;k<Zout_derivative.cols();k++,work++)
       {
-      *work = help(k+j,0);
+      *work = help[k];
       }
 
     }
@@ -525,58 +532,6 @@ void DESIGN_pspline::make_Bspline_derivative(void)
 
 
 
-datamatrix DESIGN_pspline::bspline_derivative(const double & x)
-  {
-
-
-// nach Haemmerlin/Hoffmann
-  datamatrix b(nrpar,1,0.0);
-  datamatrix help(nrpar+degree,1,0.0);
-  unsigned j;
-  double * bwork;
-  double * helpwork;
-
-// Grad 0
-
-  for(j=0;j<nrpar;j++)
-    if( knot[j]<=x && x<knot[j+1])
-      b(j,0) = 1.0;
-
-  for(int l=1;l<=degree-1;l++)
-    {
-    bwork = b.getV();
-    helpwork = help.getV();
-    for(j=0;j<nrpar;j++,++helpwork,++bwork)
-//      help(j,0) = b(j,0);
-      *helpwork = *bwork;
-    bwork = b.getV();
-    helpwork = help.getV();
-    for(j=0;j<nrpar;j++,++helpwork,++bwork)
-      {
-//      b(j,0) = (x-knot[j])*help(j,0)/(knot[j+l]-knot[j])
-//                  + (knot[j+l+1]-x)*help(j+1,0)/(knot[j+l+1]-knot[j+1]);
-      *bwork = (x-knot[j])**helpwork/(knot[j+l]-knot[j])
-                  + (knot[j+l+1]-x)**(helpwork+1)/(knot[j+l+1]-knot[j+1]);
-
-      }
-    }
-
-// Haemmerlin/Hoffmann Seite 263
-
-  bwork = b.getV();
-  helpwork = help.getV();
-  for(j=0;j<nrpar;j++,++helpwork,++bwork)
-    *helpwork = *bwork;
-  bwork = b.getV();
-  helpwork = help.getV();
-  for(j=0;j<nrpar;j++,++helpwork,++bwork)
-    *bwork = degree*( *helpwork/(knot[j+degree]-knot[j]) - *(helpwork+1)/(knot[j+degree+1]-knot[j+1]) );
-
-  return b;
-
-  }
-
-
 void DESIGN_pspline::compute_penalty2(const datamatrix & pen)
   {
   if (type==Rw1)
@@ -50,15 +50,16 @@ class __EXPORT_TYPE DESIGN_pspline : public DESIGN
 
   vector<double> weightK;      // weights to compute penalty matrix K
 
-  // FUNCTION: bspline
-  // TASK: computes B-splines at position x
-
-  datamatrix bspline(const double & x);
-
-  // FUNCTION: bspline
-  // TASK: computes B-splines first derivative at position x
-
-  datamatrix bspline_derivative(const double & x);
+  // FUNCTION: bspline_nonnull
+  // TASK: computes the degree+1 non null B-splines (or their first
+  //       derivatives if deriv = true) at position x and stores them in b.
+  //       j returns the index of the first non null B-spline. The search for
+  //       j starts at the value passed, i.e. j should be reused for
+  //       increasing values of x. b must provide degree+2 elements, no
+  //       memory is allocated
+
+  void bspline_nonnull(const double & x,unsigned & j,double * b,
+                       bool deriv=false);
 
   // FUNCTION: make_Bspline
   // TASK: computes knot, Zout and index_Zout
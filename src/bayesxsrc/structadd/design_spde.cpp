@@ -0,0 +1,460 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+#include "design_spde.h"
+#include "clstring.h"
+
+namespace MCMC
+{
+
+//------------------------------------------------------------------------------
+//------------- CLASS: DESIGN_spde implementation of member functions ----------
+//------------------------------------------------------------------------------
+
+
+void DESIGN_spde::read_options(vector<ST::string> & op,
+                               vector<ST::string> & vn)
+  {
+
+  DESIGN_kriging::read_options(op,vn);
+
+  if (op[7] == "false")   //nocenter==false, i.e. center
+    center = true;
+  else
+    center = false;
+
+  if (op[16]=="meancoeff" || op[16] == "nullspace")
+    centermethod = meancoeff;
+  else if (op[16] == "meansimple")
+    centermethod = meansimple;
+  else if (op[16] == "meaninvvar")
+    centermethod = cmeaninvvar;
+  else if (op[16] == "meanintegral")
+    centermethod = cmeanintegral;
+  else if (op[16] == "meanf")
+    centermethod = meanf;
+  else if (op[16] == "meanfd")
+    centermethod = meanfd;
+
+  // the SPDE with alpha=2 in two dimensions corresponds to nu=1
+
+  nu = 1;
+
+  op[23].strtodouble(maxdist);
+  if (maxdist <= 0)        // x K_1(x) = 0.0001
+    maxdist = 10.65271053;
+
+  }
+
+
+DESIGN_spde::DESIGN_spde(void) : DESIGN_kriging()
+  {
+
+  }
+
+
+DESIGN_spde::DESIGN_spde(const datamatrix & dm,const datamatrix & iv,
+                         GENERAL_OPTIONS * o,DISTR * dp,FC_linear * fcl,
+                         vector<ST::string> & op,vector<ST::string> & vn)
+                         : DESIGN_kriging(o,dp,fcl)
+  {
+
+  read_options(op,vn);
+
+  type = Grf;
+
+  init_data(dm,iv);
+
+  compute_mesh();
+
+  nrpar = nx*ny;
+
+  compute_projector();
+
+  compute_Zout_transposed();
+
+  compute_penalty();
+
+  XWX = envmatdouble(0.0,nrpar,nx+1);
+  XWres = datamatrix(nrpar,1);
+  Wsum = datamatrix(posbeg.size(),1,1);
+
+  compute_precision(1.0);
+
+  compute_basisNull();
+
+  }
+
+
+DESIGN_spde::DESIGN_spde(const DESIGN_spde & m)
+    : DESIGN_kriging(DESIGN_kriging(m))
+  {
+  nx = m.nx;
+  ny = m.ny;
+  x0 = m.x0;
+  y0 = m.y0;
+  h = m.h;
+  }
+
+
+const DESIGN_spde & DESIGN_spde::operator=(const DESIGN_spde & m)
+  {
+  if (this == &m)
+    return *this;
+  DESIGN_kriging::operator=(DESIGN_kriging(m));
+  nx = m.nx;
+  ny = m.ny;
+  x0 = m.x0;
+  y0 = m.y0;
+  h = m.h;
+  return *this;
+  }
+
+
+void DESIGN_spde::compute_mesh(void)
+  {
+
+  unsigned i;
+  double xmin = xvalues[0];
+  double xmax = xvalues[0];
+  double ymin = yvalues[0];
+  double ymax = yvalues[0];
+  for(i=1;i<xvalues.size();i++)
+    {
+    if (xvalues[i] < xmin)
+      xmin = xvalues[i];
+    if (xvalues[i] > xmax)
+      xmax = xvalues[i];
+    if (yvalues[i] < ymin)
+      ymin = yvalues[i];
+    if (yvalues[i] > ymax)
+      ymax = yvalues[i];
+    }
+
+  // rho: see DESIGN_vecchia
+
+  rho = sqrt((xmax-xmin)*(xmax-xmin)+(ymax-ymin)*(ymax-ymin))/maxdist;
+  if (rho <= 0)
+    rho = 1;
+
+  // margin of 10 percent of the larger extent on each side reduces the
+  // boundary effects of the Neumann boundary conditions
+
+  double extent = xmax-xmin;
+  if (ymax-ymin > extent)
+    extent = ymax-ymin;
+  if (extent <= 0)
+    extent = 1;
+  double margin = 0.1*extent;
+
+  h = (extent+2*margin)/(nrknots-1);
+
+  nx = unsigned(ceil((xmax-xmin+2*margin)/h-1e-8))+1;
+  ny = unsigned(ceil((ymax-ymin+2*margin)/h-1e-8))+1;
+  if (nx < 3)
+    nx = 3;
+  if (ny < 3)
+    ny = 3;
+
+  x0 = 0.5*(xmin+xmax)-0.5*(nx-1)*h;
+  y0 = 0.5*(ymin+ymax)-0.5*(ny-1)*h;
+
+  }
+
+
+void DESIGN_spde::compute_projector(void)
+  {
+
+  unsigned i;
+  unsigned ix,iy,node;
+  double u,v;
+
+  Zout = datamatrix(posbeg.size(),3);
+  index_Zout = statmatrix<int>(posbeg.size(),3);
+
+  double * workZout = Zout.getV();
+  int * workindex = index_Zout.getV();
+
+  // each cell (ix,iy) is divided along the diagonal (ix,iy)-(ix+1,iy+1),
+  // node (ix,iy) has number ix+iy*nx
+
+  for(i=0;i<posbeg.size();i++)
+    {
+    u = (xvalues[i]-x0)/h;
+    v = (yvalues[i]-y0)/h;
+    ix = unsigned(floor(u));
+    iy = unsigned(floor(v));
+    if (ix > nx-2)
+      ix = nx-2;
+    if (iy > ny-2)
+      iy = ny-2;
+    u -= ix;
+    v -= iy;
+    node = ix+iy*nx;
+
+    if (u >= v)             // lower triangle (ix,iy),(ix+1,iy),(ix+1,iy+1)
+      {
+      *workZout = 1-u;
+      *workindex = node;
+      workZout++;
+      workindex++;
+      *workZout = u-v;
+      *workindex = node+1;
+      workZout++;
+      workindex++;
+      *workZout = v;
+      *workindex = node+nx+1;
+      workZout++;
+      workindex++;
+      }
+    else                    // upper triangle (ix,iy),(ix,iy+1),(ix+1,iy+1)
+      {
+      *workZout = 1-v;
+      *workindex = node;
+      workZout++;
+      workindex++;
+      *workZout = v-u;
+      *workindex = node+nx;
+      workZout++;
+      workindex++;
+      *workZout = u;
+      *workindex = node+nx+1;
+      workZout++;
+      workindex++;
+      }
+
+    }
+
+  }
+
+
+void DESIGN_spde::compute_penalty(void)
+  {
+
+  unsigned i,j,k,l,t;
+  unsigned ix,iy,node;
+
+  // finite element matrices: lumped mass matrix C (diagonal) and stiffness
+  // matrix G, stored as lists of the nonzero entries of each row
+
+  vector<double> C(nrpar,0);
+  vector< vector<unsigned> > Gindex(nrpar);
+  vector< vector<double> > Gvalue(nrpar);
+
+  unsigned tri[3];
+  double xt[3];
+  double yt[3];
+  double b[3];
+  double c[3];
+  double area;
+
+  for(iy=0;iy<ny-1;iy++)
+    for(ix=0;ix<nx-1;ix++)
+      {
+      node = ix+iy*nx;
+      for(t=0;t<2;t++)
+        {
+        tri[0] = node;
+        tri[1] = (t==0) ? node+1 : node+nx;
+        tri[2] = node+nx+1;
+
+        for(k=0;k<3;k++)
+          {
+          xt[k] = x0+(tri[k] % nx)*h;
+          yt[k] = y0+(tri[k] / nx)*h;
+          }
+
+        for(k=0;k<3;k++)
+          {
+          b[k] = yt[(k+1)%3]-yt[(k+2)%3];
+          c[k] = xt[(k+2)%3]-xt[(k+1)%3];
+          }
+
+        area = 0.5*fabs(c[2]*b[1]-c[1]*b[2]);
+
+        for(k=0;k<3;k++)
+          {
+          C[tri[k]] += area/3;
+          for(l=0;l<3;l++)
+            {
+            for(j=0;j<Gindex[tri[k]].size() && Gindex[tri[k]][j] != tri[l];j++)
+              {
+              }
+            if (j == Gindex[tri[k]].size())
+              {
+              Gindex[tri[k]].push_back(tri[l]);
+              Gvalue[tri[k]].push_back(0);
+              }
+            Gvalue[tri[k]][j] += (b[k]*b[l]+c[k]*c[l])/(4*area);
+            }
+          }
+
+        }
+      }
+
+  // band storage of K
+
+  unsigned bw = 2*nx+2;
+
+  vector<unsigned> xenv(nrpar+1,0);
+  vector<unsigned> first(nrpar,0);
+  for(i=0;i<nrpar;i++)
+    {
+    if (i > bw)
+      first[i] = i-bw;
+    xenv[i+1] = xenv[i]+i-first[i];
+    }
+
+  vector<double> diag(nrpar,0);
+  vector<double> env(xenv[nrpar],0);
+
+  double kappa = 1/rho;
+  double kappa2 = kappa*kappa;
+  double norm = 1/(4*M_PI*kappa2);
+
+  // kappa^4 C + 2 kappa^2 G
+
+  for(i=0;i<nrpar;i++)
+    {
+    diag[i] += norm*kappa2*kappa2*C[i];
+    for(j=0;j<Gindex[i].size();j++)
+      {
+      k = Gindex[i][j];
+      if (k == i)
+        diag[i] += norm*2*kappa2*Gvalue[i][j];
+      else if (k < i)
+        env[xenv[i]+k-first[i]] += norm*2*kappa2*Gvalue[i][j];
+      }
+    }
+
+  // G C^{-1} G
+
+  unsigned p,q;
+  for(k=0;k<nrpar;k++)
+    {
+    for(j=0;j<Gindex[k].size();j++)
+      for(l=0;l<=j;l++)
+        {
+        p = Gindex[k][j];
+        q = Gindex[k][l];
+        if (p == q)
+          diag[p] += norm*Gvalue[k][j]*Gvalue[k][l]/C[k];
+        else
+          {
+          if (p < q)
+            {
+            i = p;
+            p = q;
+            q = i;
+            }
+          env[xenv[p]+q-first[p]] +=
+                                      norm*Gvalue[k][j]*Gvalue[k][l]/C[k];
+          }
+        }
+    }
+
+  K = envmatdouble(env,diag,xenv,bw);
+
+  rankK = nrpar;
+
+  }
+
+
+double DESIGN_spde::penalty_compute_quadform(datamatrix & beta)
+  {
+  return K.compute_quadform(beta,0);
+  }
+
+
+void DESIGN_spde::compute_basisNull(void)
+  {
+  unsigned i,j;
+
+  basisNull = datamatrix(1,nrpar,1);
+
+  unsigned k;
+  if (centermethod==meanf || centermethod==cmeanintegral)
+    {
+    for (k=0;k<nrpar;k++)
+      basisNull(0,k) = compute_sumBk(k);
+    }
+  else if (centermethod==meanfd)
+    {
+    for (k=0;k<nrpar;k++)
+      basisNull(0,k) = compute_sumBk_different(k);
+    }
+
+  position_lin = -1;
+
+  for(i=0;i<basisNull.rows();i++)
+    {
+    basisNullt.push_back(datamatrix(basisNull.cols(),1));
+    for(j=0;j<basisNull.cols();j++)
+      basisNullt[i](j,0) = basisNull(i,j);
+    }
+
+  }
+
+
+void DESIGN_spde::compute_XtransposedWres(datamatrix & partres, double l,
+                                          double t2)
+  {
+  DESIGN::compute_XtransposedWres(partres,l,t2);
+  }
+
+
+void DESIGN_spde::compute_XtransposedWX(void)
+  {
+  DESIGN::compute_XtransposedWX();
+  }
+
+
+void DESIGN_spde::compute_precision(double l)
+  {
+
+  if (precisiondeclared==false)
+    {
+    precision = envmatdouble(0.0,nrpar,2*nx+2);
+    precisiondeclared = true;
+    }
+
+  precision.addto(XWX,K,1.0,l);
+
+  }
+
+
+void DESIGN_spde::compute_orthogonaldecomp(void)
+  {
+  DESIGN::compute_orthogonaldecomp();
+  }
+
+
+void DESIGN_spde::outoptions(GENERAL_OPTIONS * op)
+  {
+
+  op->out("  Correlation function: Matern (SPDE approximation)\n");
+  op->out("  Parameter nu: " + ST::doubletostring(nu) + "\n");
+  op->out("  Parameter rho: " + ST::doubletostring(rho) + "\n");
+  op->out("  Number of mesh nodes: " + ST::inttostring(nx) + " x " +
+          ST::inttostring(ny) + "\n");
+  op->out("  Mesh width: " + ST::doubletostring(h) + "\n");
+
+  }
+
+} // end: namespace MCMC
@@ -0,0 +1,126 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+#include "../export_type.h"
+
+#if !defined (DESIGNspdeINCLUDED)
+
+#define DESIGNspdeINCLUDED
+
+#include"design_kriging.h"
+
+
+namespace MCMC
+{
+
+
+//------------------------------------------------------------------------------
+//---------------------------- CLASS: DESIGN_spde ------------------------------
+//------------------------------------------------------------------------------
+
+// Matern field (nu = 1) for two dimensional covariates based on the
+// stochastic partial differential equation (SPDE) representation. The field
+// is represented by its values at the nodes of a regular triangulated mesh
+// covering the locations (plus a margin), the values at the locations are
+// obtained by linear interpolation within the triangles, i.e. Zout has three
+// nonzero entries per location. The prior precision is the GMRF
+// approximation
+//   K = (kappa^4 C + 2 kappa^2 G + G C^{-1} G) / (4 pi kappa^2)
+// with lumped mass matrix C and stiffness matrix G of the finite element
+// discretization, scaled to unit marginal variance. Since the nodes are
+// numbered row by row, K is a band matrix with bandwidth 2*nx+2. The band
+// Cholesky decomposition of the N = nx*ny nodes costs O(N*bw^2), i.e.
+// O(N^2) for a square mesh.
+
+class __EXPORT_TYPE DESIGN_spde : public DESIGN_kriging
+  {
+
+  void read_options(vector<ST::string> & op,vector<ST::string> & vn);
+
+  protected:
+
+  unsigned nx;                        // number of nodes in x direction
+  unsigned ny;                        // number of nodes in y direction
+  double x0;                          // lower left node of the mesh
+  double y0;
+  double h;                           // mesh width
+
+  // FUNCTION: compute_mesh
+  // TASK: computes the regular mesh covering the locations, nrknots nodes
+  //       are used in the direction of the larger extent
+
+  void compute_mesh(void);
+
+  // FUNCTION: compute_projector
+  // TASK: computes Zout and index_Zout, i.e. the barycentric coordinates of
+  //       the locations with respect to the enclosing triangles
+
+  void compute_projector(void);
+
+  public:
+
+//----------------------- CONSTRUCTORS, DESTRUCTOR -----------------------------
+
+  // DEFAULT CONSTRUCTOR
+
+  DESIGN_spde(void);
+
+  // CONSTRUCTOR
+  // x,y covariates
+
+  DESIGN_spde(const datamatrix & dm, const datamatrix & iv,
+              GENERAL_OPTIONS * o,DISTR * dp,FC_linear * fcl,
+              vector<ST::string> & op,vector<ST::string> & vn);
+
+  // COPY CONSTRUCTOR
+
+  DESIGN_spde(const DESIGN_spde & m);
+
+  // OVERLOADED ASSIGNMENT OPERATOR
+
+  const DESIGN_spde & operator=(const DESIGN_spde & m);
+
+  // VIRTUAL FUNCTIONS
+
+  void compute_penalty(void);
+
+  void compute_basisNull(void);
+
+  void compute_XtransposedWres(datamatrix & partres, double l, double t2);
+
+  void compute_XtransposedWX(void);
+
+  void compute_precision(double l);
+
+  void outoptions(GENERAL_OPTIONS * op);
+
+  void compute_orthogonaldecomp(void);
+
+  double penalty_compute_quadform(datamatrix & beta);
+
+  // DESTRUCTOR
+
+  ~DESIGN_spde() {}
+
+  };
+
+
+} // end: namespace MCMC
+
+#endif
@@ -775,7 +775,239 @@ void DESIGN_userdefined_tensor::read_options(vector<ST::string> & op,
 
 DESIGN_userdefined_tensor::DESIGN_userdefined_tensor(void) : DESIGN_userdefined()
   {
+  tensor = false;
+  }
+
+
+void DESIGN_userdefined_tensor::compute_Zout_marginal(datamatrix & Z,
+                                   vector< vector<double> > & Zm,
+                                   vector< vector<int> > & index_Zm)
+  {
+  unsigned i,j;
+  unsigned r;
+
+  Zm = vector< vector<double> >(posbeg.size());
+  index_Zm = vector< vector<int> >(posbeg.size());
+
+  for(i=0; i<posbeg.size() ; i++)
+    {
+    if(Z.rows()<data.rows())
+      r = i;
+    else
+      r = index_data(posbeg[i],0);
+
+    for(j=0; j<Z.cols(); j++)
+      {
+      if(Z(r,j)!=0)
+        {
+        Zm[i].push_back(Z(r,j));
+        index_Zm[i].push_back(j);
+        }
+      }
+    }
+  }
+
+
+unsigned DESIGN_userdefined_tensor::tensorrow(unsigned i,vector<double> & z,
+                                             vector<unsigned> & index)
+  {
+  unsigned n1 = Zmarg1[i].size();
+  unsigned n2 = Zmarg2[i].size();
+  if (z.size() < n1*n2)
+    {
+    z.resize(n1*n2);
+    index.resize(n1*n2);
+    }
+
+  unsigned j,k,n=0;
+  for (j=0;j<n1;j++)
+    for (k=0;k<n2;k++,n++)
+      {
+      z[n] = Zmarg1[i][j]*Zmarg2[i][k];
+      index[n] = index_Zmarg1[i][j]*nrpar2+index_Zmarg2[i][k];
+      }
+
+  return n;
+  }
+
+
+void DESIGN_userdefined_tensor::compute_XWX_envelope(void)
+  {
+  unsigned i,p,q,n;
+  vector<double> z;
+  vector<unsigned> index;
+
+  // first[a] = first column with non null element in row a of XWX,
+  // columns of the tensor product are increasing within a row
+
+  vector<unsigned> first(nrpar);
+  for (i=0;i<nrpar;i++)
+    first[i] = i;
+
+  for (i=0;i<posbeg.size();i++)
+    {
+    n = tensorrow(i,z,index);
+    for (p=1;p<n;p++)
+      for (q=0;q<p;q++)
+        if (index[q] < first[index[p]])
+          first[index[p]] = index[q];
+    }
+
+  xenvXWX = vector<unsigned>(nrpar+1,0);
+  for (i=0;i<nrpar;i++)
+    xenvXWX[i+1] = xenvXWX[i]+(i-first[i]);
+
+  XWX = envmatdouble(xenvXWX,0.0,nrpar);
+  }
+
+
+void DESIGN_userdefined_tensor::compute_f(datamatrix & beta,
+                       datamatrix & betalin,datamatrix & f, datamatrix & ftot)
+  {
+  if (!tensor)
+    {
+    DESIGN_userdefined::compute_f(beta,betalin,f,ftot);
+    return;
+    }
+
+  unsigned i,j,k;
+  unsigned n1,n2;
+  double h;
+  double * workf = f.getV();
+  double * workbeta = beta.getV();
+
+  for(i=0; i<Zmarg1.size(); i++, workf++)
+    {
+    *workf = 0.0;
+    n1 = Zmarg1[i].size();
+    n2 = Zmarg2[i].size();
+    for(j=0; j<n1; j++)
+      {
+      double * betaj = workbeta + index_Zmarg1[i][j]*nrpar2;
+      h = 0.0;
+      for(k=0; k<n2; k++)
+        h += Zmarg2[i][k]*betaj[index_Zmarg2[i][k]];
+      *workf += Zmarg1[i][j]*h;
+      }
+    }
+  }
+
+
+void DESIGN_userdefined_tensor::compute_XtransposedWres(datamatrix & partres,
+                                                       double l, double t2)
+  {
+  if (!tensor)
+    {
+    DESIGN_userdefined::compute_XtransposedWres(partres,l,t2);
+    return;
+    }
+
+  unsigned i,j,k;
+  unsigned n1,n2;
+  double h;
+  double * workXWres = XWres.getV();
+  double * workmK = mK.getV();
+
+  for(i=0;i<nrpar;i++,workXWres++,workmK++)
+    *workXWres = *workmK/t2;
 
+  workXWres = XWres.getV();
+  double * workpartres = partres.getV();
+  for(i=0; i<Zmarg1.size(); i++, workpartres++)
+    {
+    n1 = Zmarg1[i].size();
+    n2 = Zmarg2[i].size();
+    for(j=0; j<n1; j++)
+      {
+      double * XWresj = workXWres + index_Zmarg1[i][j]*nrpar2;
+      h = Zmarg1[i][j]*(*workpartres);
+      for(k=0; k<n2; k++)
+        XWresj[index_Zmarg2[i][k]] += h*Zmarg2[i][k];
+      }
+    }
+
+  XWres_p = &XWres;
+  XWX_p = &XWX;
+  }
+
+
+void DESIGN_userdefined_tensor::compute_XtransposedWX(void)
+  {
+  if (!tensor)
+    {
+    DESIGN::compute_XtransposedWX();
+    return;
+    }
+
+  unsigned i,p,q,n,a;
+  double wz;
+  vector<double> z;
+  vector<unsigned> index;
+
+  vector<double>::iterator diag = XWX.getDiagIterator();
+  vector<double>::iterator env = XWX.getEnvIterator();
+
+  for (i=0;i<nrpar;i++)
+    *(diag+i) = 0;
+  for (i=0;i<xenvXWX[nrpar];i++)
+    *(env+i) = 0;
+
+  double * workWsum = Wsum.getV();
+  for (i=0;i<posbeg.size();i++,workWsum++)
+    {
+    n = tensorrow(i,z,index);
+    for (p=0;p<n;p++)
+      {
+      a = index[p];
+      wz = *workWsum*z[p];
+      *(diag+a) += wz*z[p];
+      // element (a,index[q]) is stored at xenvXWX[a+1]-(a-index[q])
+      for (q=0;q<p;q++)
+        *(env+(xenvXWX[a+1]-a+index[q])) += wz*z[q];
+      }
+    }
+  }
+
+
+double DESIGN_userdefined_tensor::compute_sumBk(unsigned & k)
+  {
+  if (!tensor)
+    return DESIGN::compute_sumBk(k);
+
+  unsigned j1 = k/nrpar2;
+  unsigned j2 = k%nrpar2;
+  unsigned i,j,l;
+  double sum=0;
+
+  for (i=0;i<Zmarg1.size();i++)
+    for (j=0;j<Zmarg1[i].size();j++)
+      if (unsigned(index_Zmarg1[i][j]) == j1)
+        for (l=0;l<Zmarg2[i].size();l++)
+          if (unsigned(index_Zmarg2[i][l]) == j2)
+            sum += Zmarg1[i][j]*Zmarg2[i][l]*(posend[i]-posbeg[i]+1);
+
+  return sum;
+  }
+
+
+double DESIGN_userdefined_tensor::compute_sumBk_different(unsigned & k)
+  {
+  if (!tensor)
+    return DESIGN::compute_sumBk_different(k);
+
+  unsigned j1 = k/nrpar2;
+  unsigned j2 = k%nrpar2;
+  unsigned i,j,l;
+  double sum=0;
+
+  for (i=0;i<Zmarg1.size();i++)
+    for (j=0;j<Zmarg1[i].size();j++)
+      if (unsigned(index_Zmarg1[i][j]) == j1)
+        for (l=0;l<Zmarg2[i].size();l++)
+          if (unsigned(index_Zmarg2[i][l]) == j2)
+            sum += Zmarg1[i][j]*Zmarg2[i][l];
+
+  return sum;
   }
 
 
@@ -1049,19 +1281,20 @@ DESIGN_userdefined_tensor::DESIGN_userdefined_tensor(datamatrix & dm,datamatrix
     basisNull = constrmat;
     }
 
-  unsigned i,j,k,l;
+  unsigned i;
   datamatrix designmat;
   if(designmat2.cols()==1 && designmat2.rows()==1)
     {
+    tensor = false;
     designmat.assign(designmat1);
     }
   else
     {
-    designmat= datamatrix(designmat1.rows(), nrpar, 0.0);
-    for(i=0; i<designmat1.rows(); i++)
-      for(j=0, l=0; j<designmat1.cols(); j++)
-         for(k=0; k<designmat2.cols(); k++, l++)
-           designmat(i,l) = designmat1(i,j)*designmat2(i,k);
+    tensor = true;
+    nrpar1 = designmat1.cols();
+    nrpar2 = designmat2.cols();
+    compute_Zout_marginal(designmat1,Zmarg1,index_Zmarg1);
+    compute_Zout_marginal(designmat2,Zmarg2,index_Zmarg2);
     }
 
 /*  ofstream out("c:\\temp\\Z.raw");
@@ -1115,8 +1348,11 @@ DESIGN_userdefined_tensor::DESIGN_userdefined_tensor(datamatrix & dm,datamatrix
       }
     }
 
-  compute_Zout(designmat);
-  compute_Zout_transposed_vector();
+  if (!tensor)
+    {
+    compute_Zout(designmat);
+    compute_Zout_transposed_vector();
+    }
 
   K = envmatdouble(omegas[omegaindex]*K1help+(1-omegas[omegaindex])*K2help, 0.00000001);
 //  K = envmatdouble(K1help+K2help, 0.00000001);
@@ -1148,8 +1384,13 @@ DESIGN_userdefined_tensor::DESIGN_userdefined_tensor(datamatrix & dm,datamatrix
 
   Wsum = datamatrix(posbeg.size(),1,1);
 
-  datamatrix help = designmat.transposed()*designmat;
-  XWX = envmatdouble(help, 0.0);
+  if (tensor)
+    compute_XWX_envelope();
+  else
+    {
+    datamatrix help = designmat.transposed()*designmat;
+    XWX = envmatdouble(help, 0.0);
+    }
   compute_XtransposedWX();
   XWres = datamatrix(nrpar,1);
 
@@ -1173,6 +1414,14 @@ DESIGN_userdefined_tensor::DESIGN_userdefined_tensor(const DESIGN_userdefined_te
   xvalues = m.xvalues;
   yvalues = m.yvalues;
   logdets = m.logdets;
+  tensor = m.tensor;
+  nrpar1 = m.nrpar1;
+  nrpar2 = m.nrpar2;
+  Zmarg1 = m.Zmarg1;
+  index_Zmarg1 = m.index_Zmarg1;
+  Zmarg2 = m.Zmarg2;
+  index_Zmarg2 = m.index_Zmarg2;
+  xenvXWX = m.xenvXWX;
   }
 
 
@@ -1193,6 +1442,14 @@ const DESIGN_userdefined_tensor & DESIGN_userdefined_tensor::operator=(const DES
   xvalues = m.xvalues;
   yvalues = m.yvalues;
   logdets = m.logdets;
+  tensor = m.tensor;
+  nrpar1 = m.nrpar1;
+  nrpar2 = m.nrpar2;
+  Zmarg1 = m.Zmarg1;
+  index_Zmarg1 = m.index_Zmarg1;
+  Zmarg2 = m.Zmarg2;
+  index_Zmarg2 = m.index_Zmarg2;
+  xenvXWX = m.xenvXWX;
   return *this;
   }
 
@@ -1200,6 +1457,22 @@ void DESIGN_userdefined_tensor::outbasis_R(ofstream & out)
   {
   }
 
+void DESIGN_userdefined_tensor::write_state(ofstream & out)
+  {
+  DESIGN::write_state(out);
+  save_value(out,omegaindex);
+  FC_omegas.write_state(out);
+  }
+
+
+void DESIGN_userdefined_tensor::read_state(ifstream & in)
+  {
+  DESIGN::read_state(in);
+  load_value(in,omegaindex);
+  FC_omegas.read_state(in);
+  }
+
+
 void DESIGN_userdefined_tensor::outoptions(GENERAL_OPTIONS * op)
   {
   ST::string centerm;
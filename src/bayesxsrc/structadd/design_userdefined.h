@@ -129,6 +129,40 @@ class __EXPORT_TYPE DESIGN_userdefined_tensor : public DESIGN_userdefined
   vector<double> xvalues;             // unterschiedliche Werte der Kovariablen
   vector<double> yvalues;
 
+  // tensor product of two marginal design matrices: only the non null
+  // elements of the marginal design matrices are stored, the row-wise
+  // Kronecker product is never formed
+
+  bool tensor;                        // true if two marginal design
+                                      // matrices are specified
+  unsigned nrpar1;                    // number of columns of the marginal
+  unsigned nrpar2;                    // design matrices
+  vector< vector<double> > Zmarg1;    // non null elements of the marginal
+  vector< vector<int> > index_Zmarg1; // design matrices and their columns
+  vector< vector<double> > Zmarg2;    // for the different covariate values
+  vector< vector<int> > index_Zmarg2;
+  vector<unsigned> xenvXWX;           // envelope structure of XWX
+
+  // FUNCTION: compute_Zout_marginal
+  // TASK: stores the non null elements of the marginal design matrix Z in
+  //       Zm and their columns in index_Zm
+
+  void compute_Zout_marginal(datamatrix & Z,vector< vector<double> > & Zm,
+                             vector< vector<int> > & index_Zm);
+
+  // FUNCTION: compute_XWX_envelope
+  // TASK: determines the envelope structure of XWX from the marginal design
+  //       matrices and initializes XWX
+
+  void compute_XWX_envelope(void);
+
+  // FUNCTION: tensorrow
+  // TASK: computes the non null elements of row i of the tensor product
+  //       design matrix (stored in z) and their columns (stored in index),
+  //       returns the number of non null elements
+
+  unsigned tensorrow(unsigned i,vector<double> & z,vector<unsigned> & index);
+
   public:
 
   vector<double> omegas;   // vector of fixed weights (grid between 0 and 1)
@@ -178,6 +212,31 @@ class __EXPORT_TYPE DESIGN_userdefined_tensor : public DESIGN_userdefined
 
   double penalty_compute_quadform(datamatrix & beta);
 
+  // FUNCTION: compute_f, compute_XtransposedWres, compute_XtransposedWX,
+  //           compute_sumBk, compute_sumBk_different
+  // TASK: array arithmetic based on the marginal design matrices
+  //       (generalized linear array models), e.g. the function evaluated
+  //       at covariate value i is computed as
+  //       f(i) = sum_j Z1(i,j) sum_k Z2(i,k) beta(j*nrpar2+k)
+
+  void compute_f(datamatrix & beta,datamatrix & betalin,
+                 datamatrix & f, datamatrix & ftot);
+
+  void compute_XtransposedWres(datamatrix & partres, double l, double t2);
+
+  void compute_XtransposedWX(void);
+
+  double compute_sumBk(unsigned & k);
+
+  double compute_sumBk_different(unsigned & k);
+
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -0,0 +1,390 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+#include "design_vecchia.h"
+#include "clstring.h"
+
+namespace MCMC
+{
+
+//------------------------------------------------------------------------------
+//------------ CLASS: DESIGN_vecchia implementation of member functions --------
+//------------------------------------------------------------------------------
+
+
+void DESIGN_vecchia::read_options(vector<ST::string> & op,
+                                  vector<ST::string> & vn)
+  {
+
+  // nu, maxdist
+
+  DESIGN_kriging::read_options(op,vn);
+
+  if (op[7] == "false")   //nocenter==false, i.e. center
+    center = true;
+  else
+    center = false;
+
+  if (op[16]=="meancoeff" || op[16] == "nullspace")
+    centermethod = meancoeff;
+  else if (op[16] == "meansimple")
+    centermethod = meansimple;
+  else if (op[16] == "meaninvvar")
+    centermethod = cmeaninvvar;
+  else if (op[16] == "meanintegral")
+    centermethod = cmeanintegral;
+  else if (op[16] == "meanf")
+    centermethod = meanf;
+
+  long h;
+  op[81].strtolong(h);
+  nrneighbors = h;
+
+  }
+
+
+DESIGN_vecchia::DESIGN_vecchia(void) : DESIGN_kriging()
+  {
+
+  }
+
+
+DESIGN_vecchia::DESIGN_vecchia(const datamatrix & dm,const datamatrix & iv,
+                               GENERAL_OPTIONS * o,DISTR * dp,FC_linear * fcl,
+                               vector<ST::string> & op,vector<ST::string> & vn)
+                               : DESIGN_kriging(o,dp,fcl)
+  {
+
+  read_options(op,vn);
+
+  type = Grf;
+  discrete = true;
+
+  init_data(dm,iv);
+
+  nrpar = posbeg.size();
+  nrknots = nrpar;
+  consecutive = true;
+
+  Zout = datamatrix(nrpar,1,1);
+  index_Zout = statmatrix<int>(Zout.rows(),1);
+  index_Zout.indexinit();
+
+  // rho: diagonal of the bounding box of the locations (upper bound for the
+  // maximum distance used by DESIGN_kriging, avoids the quadratic search)
+
+  unsigned i;
+  double xmin = xvalues[0];
+  double xmax = xvalues[0];
+  double ymin = yvalues[0];
+  double ymax = yvalues[0];
+  for(i=1;i<xvalues.size();i++)
+    {
+    if (xvalues[i] < xmin)
+      xmin = xvalues[i];
+    if (xvalues[i] > xmax)
+      xmax = xvalues[i];
+    if (yvalues[i] < ymin)
+      ymin = yvalues[i];
+    if (yvalues[i] > ymax)
+      ymax = yvalues[i];
+    }
+  rho = sqrt((xmax-xmin)*(xmax-xmin)+(ymax-ymin)*(ymax-ymin))/maxdist;
+  if (rho <= 0)
+    rho = 1;
+
+  compute_penalty();
+
+  XWX = envmatdouble(0,nrpar);
+  XWres = datamatrix(nrpar,1);
+  Wsum = datamatrix(nrpar,1,1);
+
+  compute_precision(1.0);
+
+  compute_basisNull();
+
+  identity = true;
+
+  }
+
+
+DESIGN_vecchia::DESIGN_vecchia(const DESIGN_vecchia & m)
+    : DESIGN_kriging(DESIGN_kriging(m))
+  {
+  nrneighbors = m.nrneighbors;
+  }
+
+
+const DESIGN_vecchia & DESIGN_vecchia::operator=(const DESIGN_vecchia & m)
+  {
+  if (this == &m)
+    return *this;
+  DESIGN_kriging::operator=(DESIGN_kriging(m));
+  nrneighbors = m.nrneighbors;
+  return *this;
+  }
+
+
+void DESIGN_vecchia::compute_neighbors(vector< vector<unsigned> > & neighbors)
+  {
+
+  unsigned n = xvalues.size();
+  unsigned i,j,l;
+  double dx,dist;
+
+  // the locations are sorted with respect to x (see init_data), hence the
+  // search for the nearest predecessors can stop as soon as the distance in
+  // x exceeds the distance of the current nrneighbors-th neighbour
+
+  vector<double> nbdist;
+
+  neighbors = vector< vector<unsigned> >(n);
+
+  for(i=1;i<n;i++)
+    {
+
+    nbdist.erase(nbdist.begin(),nbdist.end());
+
+    for(j=i;j>0;j--)
+      {
+      dx = xvalues[i]-xvalues[j-1];
+
+      if ((nbdist.size() == nrneighbors) && (dx*dx > nbdist[nrneighbors-1]))
+        break;
+
+      dist = dx*dx + (yvalues[i]-yvalues[j-1])*(yvalues[i]-yvalues[j-1]);
+
+      if ((nbdist.size() < nrneighbors) || (dist < nbdist[nbdist.size()-1]))
+        {
+        // insertion into the ordered list of neighbours
+
+        if (nbdist.size() == nrneighbors)
+          {
+          nbdist.pop_back();
+          neighbors[i].pop_back();
+          }
+
+        l = nbdist.size();
+        while ((l > 0) && (nbdist[l-1] > dist))
+          l--;
+
+        nbdist.insert(nbdist.begin()+l,dist);
+        neighbors[i].insert(neighbors[i].begin()+l,j-1);
+        }
+
+      }
+
+    }
+
+  }
+
+
+void DESIGN_vecchia::compute_penalty(void)
+  {
+
+  unsigned n = xvalues.size();
+  unsigned i,j,k,m,p,q;
+  double r;
+
+  vector< vector<unsigned> > neighbors;
+  compute_neighbors(neighbors);
+
+  // conditional regressions f_i | f_N(i): coefficients and variances
+
+  vector< vector<double> > coeff(n);
+  vector<double> condvar(n,1);
+
+  for(i=1;i<n;i++)
+    {
+    m = neighbors[i].size();
+
+    datamatrix C(m,m);
+    datamatrix c(m,1);
+    for(j=0;j<m;j++)
+      {
+      r = sqrt(pow(xvalues[i]-xvalues[neighbors[i][j]],2) +
+               pow(yvalues[i]-yvalues[neighbors[i][j]],2))/rho;
+      c(j,0) = compute_matern(nu,r);
+      C(j,j) = 1;
+      for(k=0;k<j;k++)
+        {
+        r = sqrt(pow(xvalues[neighbors[i][k]]-xvalues[neighbors[i][j]],2) +
+                 pow(yvalues[neighbors[i][k]]-yvalues[neighbors[i][j]],2))/rho;
+        C(j,k) = compute_matern(nu,r);
+        C(k,j) = C(j,k);
+        }
+      }
+
+    datamatrix b = C.solve(c);
+
+    coeff[i] = vector<double>(m);
+    for(j=0;j<m;j++)
+      {
+      coeff[i][j] = b(j,0);
+      condvar[i] -= b(j,0)*c(j,0);
+      }
+
+    if (condvar[i] < 1e-8)
+      condvar[i] = 1e-8;
+    }
+
+  // envelope structure of K = (I-B)' D^{-1} (I-B)
+
+  vector<unsigned> first(n);
+  for(i=0;i<n;i++)
+    first[i] = i;
+
+  unsigned minnb;
+  for(i=1;i<n;i++)
+    {
+    minnb = i;
+    for(j=0;j<neighbors[i].size();j++)
+      if (neighbors[i][j] < minnb)
+        minnb = neighbors[i][j];
+    if (minnb < first[i])
+      first[i] = minnb;
+    for(j=0;j<neighbors[i].size();j++)
+      if (minnb < first[neighbors[i][j]])
+        first[neighbors[i][j]] = minnb;
+    }
+
+  vector<unsigned> xenv(n+1,0);
+  for(i=0;i<n;i++)
+    xenv[i+1] = xenv[i]+i-first[i];
+
+  vector<double> diag(n,0);
+  vector<double> env(xenv[n],0);
+
+  // row i of I-B: 1 at position i, -coeff at the neighbours
+
+  vector<unsigned> pos;
+  vector<double> val;
+  for(i=0;i<n;i++)
+    {
+    pos = neighbors[i];
+    pos.push_back(i);
+    val = vector<double>(pos.size());
+    for(j=0;j<neighbors[i].size();j++)
+      val[j] = -coeff[i][j];
+    val[neighbors[i].size()] = 1;
+
+    for(j=0;j<pos.size();j++)
+      {
+      diag[pos[j]] += val[j]*val[j]/condvar[i];
+      for(k=0;k<j;k++)
+        {
+        if (pos[j] > pos[k])
+          {
+          p = pos[j];
+          q = pos[k];
+          }
+        else
+          {
+          p = pos[k];
+          q = pos[j];
+          }
+        env[xenv[p]+q-first[p]] += val[j]*val[k]/condvar[i];
+        }
+      }
+    }
+
+  K = envmatdouble(env,diag,xenv);
+
+  rankK = nrpar;
+
+  }
+
+
+double DESIGN_vecchia::penalty_compute_quadform(datamatrix & beta)
+  {
+  return K.compute_quadform(beta,0);
+  }
+
+
+void DESIGN_vecchia::compute_basisNull(void)
+  {
+  unsigned i,j;
+
+  basisNull = datamatrix(1,nrpar,1);
+
+  if (centermethod==meanf || centermethod==cmeanintegral)
+    {
+    unsigned k;
+    for (k=0;k<nrpar;k++)
+      basisNull(0,k) = posend[k]-posbeg[k]+1;
+    }
+
+  position_lin = -1;
+
+  for(i=0;i<basisNull.rows();i++)
+    {
+    basisNullt.push_back(datamatrix(basisNull.cols(),1));
+    for(j=0;j<basisNull.cols();j++)
+      basisNullt[i](j,0) = basisNull(i,j);
+    }
+
+  }
+
+
+void DESIGN_vecchia::compute_XtransposedWres(datamatrix & partres, double l,
+                                             double t2)
+  {
+  XWres_p = &partres;
+  }
+
+
+void DESIGN_vecchia::compute_XtransposedWX(void)
+  {
+  DESIGN::compute_XtransposedWX();
+  }
+
+
+void DESIGN_vecchia::compute_precision(double l)
+  {
+
+  if (precisiondeclared==false)
+    {
+    precision = envmatdouble(K.getXenv(),0,nrpar);
+    precisiondeclared = true;
+    }
+
+  precision.addtodiag(XWX,K,1.0,l);
+
+  }
+
+
+void DESIGN_vecchia::compute_orthogonaldecomp(void)
+  {
+  DESIGN::compute_orthogonaldecomp();
+  }
+
+
+void DESIGN_vecchia::outoptions(GENERAL_OPTIONS * op)
+  {
+
+  op->out("  Correlation function: Matern (Vecchia approximation)\n");
+  op->out("  Parameter nu: " + ST::doubletostring(nu) + "\n");
+  op->out("  Parameter rho: " + ST::doubletostring(rho) + "\n");
+  op->out("  Number of locations: " + ST::inttostring(nrpar) + "\n");
+  op->out("  Number of neighbours: " + ST::inttostring(nrneighbors) + "\n");
+  op->out("  Size of envelope: " + ST::inttostring(K.getXenv(nrpar)) + "\n");
+
+  }
+
+} // end: namespace MCMC
@@ -0,0 +1,112 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+#include "../export_type.h"
+
+#if !defined (DESIGNvecchiaINCLUDED)
+
+#define DESIGNvecchiaINCLUDED
+
+#include"design_kriging.h"
+
+
+namespace MCMC
+{
+
+
+//------------------------------------------------------------------------------
+//--------------------------- CLASS: DESIGN_vecchia ----------------------------
+//------------------------------------------------------------------------------
+
+// Nearest neighbour Gaussian process (Vecchia approximation) for two
+// dimensional covariates. The parameters are the function values at the
+// different locations, the prior precision is the sparse precision of the
+// Vecchia approximation of the Matern correlation used in DESIGN_kriging:
+// in the ordering of the (sorted) locations each value depends only on its
+// 'nrneighbors' nearest predecessors. The penalty is stored as an envelope
+// matrix, so that memory and computing time grow with the number of
+// locations times the envelope width instead of quadratically.
+
+class __EXPORT_TYPE DESIGN_vecchia : public DESIGN_kriging
+  {
+
+  void read_options(vector<ST::string> & op,vector<ST::string> & vn);
+
+  protected:
+
+  unsigned nrneighbors;               // size of the conditioning sets
+
+  // FUNCTION: compute_neighbors
+  // TASK: computes the indices of the nrneighbors nearest predecessors of
+  //       each location (sweep over the locations sorted by the x
+  //       coordinate)
+
+  void compute_neighbors(vector< vector<unsigned> > & neighbors);
+
+  public:
+
+//----------------------- CONSTRUCTORS, DESTRUCTOR -----------------------------
+
+  // DEFAULT CONSTRUCTOR
+
+  DESIGN_vecchia(void);
+
+  // CONSTRUCTOR
+  // x,y covariates
+
+  DESIGN_vecchia(const datamatrix & dm, const datamatrix & iv,
+                 GENERAL_OPTIONS * o,DISTR * dp,FC_linear * fcl,
+                 vector<ST::string> & op,vector<ST::string> & vn);
+
+  // COPY CONSTRUCTOR
+
+  DESIGN_vecchia(const DESIGN_vecchia & m);
+
+  // OVERLOADED ASSIGNMENT OPERATOR
+
+  const DESIGN_vecchia & operator=(const DESIGN_vecchia & m);
+
+  // VIRTUAL FUNCTIONS
+
+  void compute_penalty(void);
+
+  void compute_basisNull(void);
+
+  void compute_XtransposedWres(datamatrix & partres, double l, double t2);
+
+  void compute_XtransposedWX(void);
+
+  void compute_precision(double l);
+
+  void outoptions(GENERAL_OPTIONS * op);
+
+  void compute_orthogonaldecomp(void);
+
+  double penalty_compute_quadform(datamatrix & beta);
+
+  // DESTRUCTOR
+
+  ~DESIGN_vecchia() {}
+
+  };
+
+
+} // end: namespace MCMC
+
+#endif
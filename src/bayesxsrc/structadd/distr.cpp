@@ -96,6 +96,7 @@ DISTR::DISTR(GENERAL_OPTIONS * o, const datamatrix & r,
   family = "unknown";
   familyshort = "unknown";
   updateIWLS = false;
+  predict_specialized = false;
   copularotate = false;
   copulaoffset = 0;
   copulapos = 0;
@@ -182,6 +183,7 @@ DISTR::DISTR(const DISTR & d)
   workingweight = d.workingweight;
   weightsone = d.weightsone;
   wtype = d.wtype;
+  predict_specialized = d.predict_specialized;
 
   linearpred1 = d.linearpred1;
   linearpred2 = d.linearpred2;
@@ -266,6 +268,7 @@ const DISTR & DISTR::operator=(const DISTR & d)
   workingweight = d.workingweight;
   weightsone = d.weightsone;
   wtype = d.wtype;
+  predict_specialized = d.predict_specialized;
 
   linearpred1 = d.linearpred1;
   linearpred2 = d.linearpred2;
@@ -378,6 +381,16 @@ bool DISTR::check_linpred(bool current)
     // cmp with nan value is always false, thus check for nan first
     if (isnan(*worklin))
       {
+      if (optionsp->inmemory)
+        {
+        // in-process runs must not terminate the calling program
+
+        if (!errors)
+          errormessages.push_back("ERROR: linear predictor is NaN in equation "
+                                  + this->equationtype + "\n");
+        errors = true;
+        return false;
+        }
       cerr << "linear predictor is NaN in equation " << this->equationtype
            << ".\ncan not recover.\nterminating bayesx.\n";
       abort(); // FIXME unify error handling (exit/abort/exceptions/retval)
@@ -741,6 +754,48 @@ void DISTR::compute_deviance_mult(vector<double *> response,
 
 
 
+double DISTR::compute_predict(double * pred,double * dev)
+  {
+
+  unsigned i;
+
+  double * worklin;
+  if (linpred_current==1)
+    worklin = linearpred1.getV();
+  else
+    worklin = linearpred2.getV();
+
+  double * workresponse = response.getV();
+  double * workweight = weight.getV();
+  double scalehelp = get_scale();
+  double mu;
+  double param;
+  double deviance = 0;
+
+  for (i=0;i<nrobs;i++,worklin++,workresponse++,workweight++)
+    {
+    compute_param(worklin,&param);
+    compute_mu(worklin,&mu);
+
+    if (dev != NULL)
+      {
+      compute_deviance(workresponse,workweight,&mu,dev,&scalehelp);
+      deviance += *dev;
+      dev++;
+      }
+
+    *pred = *worklin;
+    pred++;
+    *pred = mu;
+    pred++;
+    *pred = param;
+    pred++;
+    }
+
+  return deviance;
+  }
+
+
 void DISTR::compute_mu(const double * linpred,double * mu)
   {
 
@@ -822,6 +877,55 @@ void DISTR::update_end(void)
   } // end: update_end
 
 
+void DISTR::write_state(ofstream & out)
+  {
+  save_value(out,response);
+  save_value(out,workingresponse);
+  save_value(out,weight);
+  save_value(out,workingweight);
+  save_value(out,linearpred1);
+  save_value(out,linearpred2);
+  save_value(out,linpred_current);
+  save_value(out,sigma2);
+  save_value(out,meaneffect);
+  save_value(out,counter);
+  save_value(out,helpmat1);
+  save_value(out,helpmat2);
+  save_value(out,helpmat3);
+  save_value(out,fx);
+  save_value(out,helpquantity1);
+  save_value(out,helpquantity2);
+  save_value(out,helpquantity3);
+  }
+
+
+void DISTR::read_state(ifstream & in)
+  {
+  load_value(in,response);
+  if (response.rows() != nrobs)
+    {
+    in.setstate(std::ios::failbit);
+    return;
+    }
+  load_value(in,workingresponse);
+  load_value(in,weight);
+  load_value(in,workingweight);
+  load_value(in,linearpred1);
+  load_value(in,linearpred2);
+  load_value(in,linpred_current);
+  load_value(in,sigma2);
+  load_value(in,meaneffect);
+  load_value(in,counter);
+  load_value(in,helpmat1);
+  load_value(in,helpmat2);
+  load_value(in,helpmat3);
+  load_value(in,fx);
+  load_value(in,helpquantity1);
+  load_value(in,helpquantity2);
+  load_value(in,helpquantity3);
+  }
+
+
 bool DISTR::posteriormode(void)
   {
   double h = 0.0;
@@ -1152,6 +1256,44 @@ void DISTR::addmult(datamatrix & design, datamatrix & betadiff)
     linearpred2.addmult(design,betadiff);
   }
 
+bool DISTR::changed_workingweights(vector<double> & wold,
+                                   vector<unsigned> & changed,
+                                   vector<double> & dw,
+                                   const double & maxfrac)
+  {
+  unsigned i;
+  double * workweight = workingweight.getV();
+  unsigned maxchanged = unsigned(maxfrac*nrobs);
+
+  bool ok = (wold.size() == nrobs);
+  if (!ok)
+    wold = vector<double>(nrobs,0);
+
+  changed.erase(changed.begin(),changed.end());
+  dw.erase(dw.begin(),dw.end());
+
+  for (i=0;i<nrobs;i++,workweight++)
+    {
+    if (wold[i] != *workweight)
+      {
+      if (ok)
+        {
+        if (changed.size() < maxchanged)
+          {
+          changed.push_back(i);
+          dw.push_back(*workweight-wold[i]);
+          }
+        else
+          ok = false;
+        }
+      wold[i] = *workweight;
+      }
+    }
+
+  return ok;
+  }
+
+
 void DISTR::add_linpred(datamatrix & l)
   {
   if (linpred_current==1)
@@ -1253,6 +1395,7 @@ DISTR_gaussian::DISTR_gaussian(const double & a,
 
   {
 
+  predict_specialized = true;
   predictor_name = "mu";
   outexpectation = true;
 
@@ -1261,6 +1404,9 @@ DISTR_gaussian::DISTR_gaussian(const double & a,
   nrlasso=0;
   nrridge=0;
 
+  aggregatedss = 0;
+  aggregatednrobs = 0;
+
   if (check_weightsone())
     wtype = wweightsnochange_one;
   else
@@ -1290,6 +1436,8 @@ const DISTR_gaussian & DISTR_gaussian::operator=(
   ridgesum = nd.ridgesum;
   nrlasso = nd.nrlasso;
   nrridge = nd.nrridge;
+  aggregatedss = nd.aggregatedss;
+  aggregatednrobs = nd.aggregatednrobs;
   FCsigma2 = nd.FCsigma2;
   return *this;
   }
@@ -1305,11 +1453,24 @@ DISTR_gaussian::DISTR_gaussian(const DISTR_gaussian & nd)
   ridgesum = nd.ridgesum;
   nrlasso = nd.nrlasso;
   nrridge = nd.nrridge;
+  aggregatedss = nd.aggregatedss;
+  aggregatednrobs = nd.aggregatednrobs;
   FCsigma2 = nd.FCsigma2;
   }
 
 
 
+void DISTR_gaussian::set_aggregation(const double & ss,const double & nadd,
+                                     const double & sd)
+  {
+  aggregatedss = ss;
+  aggregatednrobs = nadd;
+  if (trmult > 0)
+    b_invgamma = (b_invgamma/trmult)*sd;
+  trmult = sd;
+  }
+
+
 void DISTR_gaussian::get_samples(const ST::string & filename,ofstream & outg) const
   {
   if (filename.isvalidfile() != 1)
@@ -1380,6 +1541,30 @@ void DISTR_gaussian::update_scale_hyperparameters(datamatrix & h)
   }
 
 
+void DISTR_gaussian::write_state(ofstream & out)
+  {
+  DISTR::write_state(out);
+  save_value(out,b_invgamma);
+  save_value(out,nrlasso);
+  save_value(out,nrridge);
+  save_value(out,lassosum);
+  save_value(out,ridgesum);
+  FCsigma2.write_state(out);
+  }
+
+
+void DISTR_gaussian::read_state(ifstream & in)
+  {
+  DISTR::read_state(in);
+  load_value(in,b_invgamma);
+  load_value(in,nrlasso);
+  load_value(in,nrridge);
+  load_value(in,lassosum);
+  load_value(in,ridgesum);
+  FCsigma2.read_state(in);
+  }
+
+
 void DISTR_gaussian::outoptions(void)
   {
   DISTR::outoptions();
@@ -1432,8 +1617,9 @@ void DISTR_gaussian::update(void)
       }
     }
 
-  sigma2  = rand_invgamma(a_invgamma+0.5*((nrobs-nrzeroweights)+nrlasso+nrridge),
-                          b_invgamma+0.5*(sum+lassosum+ridgesum));
+  sigma2  = rand_invgamma(a_invgamma+0.5*((nrobs-nrzeroweights)+nrlasso+nrridge+
+                                         aggregatednrobs),
+                          b_invgamma+0.5*(sum+lassosum+ridgesum+aggregatedss));
 
 
   FCsigma2.beta(0,0) = sigma2;
@@ -1468,6 +1654,58 @@ void DISTR_gaussian::compute_deviance(const double * response,
   }
 
 
+double DISTR_gaussian::compute_predict(double * pred,double * dev)
+  {
+
+  if (!predict_specialized)
+    return DISTR::compute_predict(pred,dev);
+
+  unsigned i;
+
+  double * worklin;
+  if (linpred_current==1)
+    worklin = linearpred1.getV();
+  else
+    worklin = linearpred2.getV();
+
+  double * workresponse = response.getV();
+  double * workweight = weight.getV();
+  double scale = get_scale();
+  double logscaleone = log(2*M_PI*scale/1.0);
+  double r;
+  double deviance = 0;
+
+  for (i=0;i<nrobs;i++,worklin++,workresponse++,workweight++)
+    {
+
+    if (dev != NULL)
+      {
+      if (*workweight == 0)
+        *dev = 0;
+      else
+        {
+        r = *workresponse-*worklin;
+        if (*workweight == 1)
+          *dev = (1.0/scale)*r*r+logscaleone;
+        else
+          *dev = (*workweight/scale)*r*r+log(2*M_PI*scale/(*workweight));
+        }
+      deviance += *dev;
+      dev++;
+      }
+
+    *pred = *worklin;
+    pred++;
+    *pred = *worklin;
+    pred++;
+    *pred = *worklin;
+    pred++;
+    }
+
+  return deviance;
+  }
+
+
 double DISTR_gaussian::compute_MSE(const double * response,
                           const double * weight,
                           const double * linpred, msetype t, double v)
@@ -1599,7 +1837,7 @@ bool DISTR_gaussian::posteriormode(void)
     sumweight+=*workweight;
     }
 
-  sigma2 = (1.0/sumweight)*sum;
+  sigma2 = (1.0/sumweight)*(sum+aggregatedss);
 
   FCsigma2.beta(0,0) = sigma2;
 
@@ -1685,6 +1923,11 @@ void DISTR_gaussian::outresults(ofstream & out_stata, ofstream & out_R, ofstream
     optionsp->out("\n");
 //    out_R << "scale=" << pathresults << ";" <<  endl;
 
+    if (optionsp->binaryoutput)
+      FCsigma2.outresults_binary(pathresults.substr(0,
+                                 pathresults.length()-4) + ".bin","",
+                                 vector<ST::string>());
+
     ofstream outscale(pathresults.strtochar());
 
     if (optionsp->samplesize > 1)
@@ -1807,6 +2050,20 @@ void DISTR_vargaussian::compute_mu(const double * linpred,double * mu)
 //                             const double * linpred, msetype t, double v);
 
 
+void DISTR_vargaussian::write_state(ofstream & out)
+  {
+  DISTR::write_state(out);
+  save_value(out,sigma2old);
+  }
+
+
+void DISTR_vargaussian::read_state(ifstream & in)
+  {
+  DISTR::read_state(in);
+  load_value(in,sigma2old);
+  }
+
+
   void DISTR_vargaussian::outoptions(void)
     {
     DISTR::outoptions();
@@ -1977,6 +2234,7 @@ DISTR_hetgaussian::DISTR_hetgaussian(double a,double b, GENERAL_OPTIONS * o,
 
   {
 
+  predict_specialized = false;
   predictor_name = "mu";
   outexpectation = true;
 
@@ -2104,6 +2362,8 @@ DISTR_quantreg::DISTR_quantreg(const double & a,const double & b,
                                const datamatrix & w)
   : DISTR_gaussian(a,b,o,r,ps,w)
   {
+  predict_specialized = false;
+
   family="Quantile regression based on asymmetric Laplace distribution";
   predictor_name = "quantile";
   outexpectation = true;
@@ -2395,6 +2655,8 @@ DISTR_loggaussian::DISTR_loggaussian(const double & a,
   : DISTR_gaussian(a,b,o,r,ps,w)
 
   {
+  predict_specialized = false;
+
   family = "log-Gaussian";
   outexpectation = true;
   }
@@ -2525,6 +2787,8 @@ DISTR_gaussian_exp::DISTR_gaussian_exp(const double & a,
   : DISTR_gaussian(a,b,o,r,ps,w)
 
   {
+  predict_specialized = false;
+
   updateIWLS = true;
   outexpectation = true;
   }
@@ -2889,6 +3153,8 @@ DISTR_gaussian_re::DISTR_gaussian_re(GENERAL_OPTIONS * o,const datamatrix & r,
   : DISTR_gaussian(1,1,o,r,"",w)
 
   {
+  predict_specialized = false;
+
   maindistribution=false;
 
   family = "Gaussian_random_effect";
@@ -2998,6 +3264,8 @@ DISTR_gaussian_multeffect::DISTR_gaussian_multeffect(const double & a,
                                              const datamatrix & w)
   : DISTR_gaussian(a,b,o,r,ps,w)
   {
+  predict_specialized = false;
+
   family = "Normal distribution for multiplicative effects";
   updateIWLS = true;
   dgexists = false;
@@ -3039,6 +3307,20 @@ void DISTR_gaussian_multeffect::update_scale_hyperparameters(datamatrix & h)
   {
   }
 
+void DISTR_gaussian_multeffect::write_state(ofstream & out)
+  {
+  DISTR_gaussian::write_state(out);
+  save_value(out,helpmat);
+  }
+
+
+void DISTR_gaussian_multeffect::read_state(ifstream & in)
+  {
+  DISTR_gaussian::read_state(in);
+  load_value(in,helpmat);
+  }
+
+
 void DISTR_gaussian_multeffect::outoptions(void)
   {
   DISTR_gaussian::outoptions();
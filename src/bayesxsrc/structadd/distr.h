@@ -42,9 +42,11 @@ using randnumbers::uniform;
 using randnumbers::trunc_normal;
 using randnumbers::trunc_normal2;
 using randnumbers::truncnormal;
+using randnumbers::trunc_normal_lower;
 using randnumbers::kssample;
 using randnumbers::rand_gamma;
 using randnumbers::rand_inv_gaussian;
+using randnumbers::rand_polyagamma;
 
 using randnumbers::invPhi2;
 
@@ -107,6 +109,13 @@ class __EXPORT_TYPE DISTR
 
   bool updateIWLS;
 
+  bool predict_specialized;       // true if compute_predict may use the
+                                  // loop of the class itself (set in the
+                                  // constructor). Derived classes that
+                                  // redefine compute_mu or compute_deviance
+                                  // set it to false, compute_predict then
+                                  // uses DISTR::compute_predict
+
   ST::string family;              // name of the distribution
   ST::string familyshort;
   unsigned hlevel;
@@ -167,6 +176,8 @@ class __EXPORT_TYPE DISTR
 
   // FUNCTION: check_linpred
   // TASK: checks whether current predictor vector is within linpredlimits
+  //       a NaN predictor terminates BayesX, for in-process runs an error
+  //       is set instead and the simulation stops after the iteration
 
   bool check_linpred(bool current = true);
 
@@ -461,6 +472,23 @@ class __EXPORT_TYPE DISTR
                              vector<datamatrix *> aux);
 
 
+  //----------------------------------------------------------------------------
+  //------------------------------- COMPUTE predict ----------------------------
+  //----------------------------------------------------------------------------
+
+  // FUNCTION: compute_predict
+  // TASK: single sweep over all observations for the current linear
+  //       predictor. Stores linear predictor, mu and param (3 consecutive
+  //       values per observation) in 'pred' and, if 'dev' is not NULL, the
+  //       deviance contributions (one value per observation) in 'dev'.
+  //       Returns the total deviance (0 if dev is NULL).
+  //       Distributions may override this with a loop that avoids the per
+  //       observation virtual calls of compute_param, compute_mu and
+  //       compute_deviance (see predict_specialized).
+
+  virtual double compute_predict(double * pred,double * dev);
+
+
   //----------------------------------------------------------------------------
   //------------------------------- COMPUTE MSE --------------------------------
   //----------------------------------------------------------------------------
@@ -638,6 +666,20 @@ class __EXPORT_TYPE DISTR
 
   virtual void addmult(datamatrix & design, datamatrix & betadiff);
 
+  // FUNCTION: changed_workingweights
+  // TASK: compares the current working weights with 'wold' (the working
+  //       weights a cross product X'WX was computed with), stores the
+  //       observations with changed weights in 'changed' and the changes
+  //       w_new-w_old in 'dw' and sets 'wold' to the current weights.
+  //       Returns false if 'wold' is not yet initialized or more than
+  //       maxfrac*nrobs weights changed, i.e. if X'WX should be recomputed
+  //       from scratch
+
+  bool changed_workingweights(vector<double> & wold,
+                              vector<unsigned> & changed,
+                              vector<double> & dw,
+                              const double & maxfrac);
+
   // FUNCTION: add_linpred
   // TASK: adds l to linpred
 
@@ -663,6 +705,24 @@ class __EXPORT_TYPE DISTR
 
   void reset(void);
 
+  //----------------------------------------------------------------------------
+  //------------------------------ CHECKPOINTS ---------------------------------
+  //----------------------------------------------------------------------------
+
+  // FUNCTION: write_state
+  // TASK: writes the current state (linear predictors, working quantities,
+  //       scale parameter) to a binary snapshot
+  //       derived classes with additional state (e.g. full conditionals for
+  //       the scale parameter) must call DISTR::write_state first
+
+  virtual void write_state(ofstream & out);
+
+  // FUNCTION: read_state
+  // TASK: restores the state written by write_state, errors are reported
+  //       via the state of 'in' (in.fail() == true)
+
+  virtual void read_state(ifstream & in);
+
   }; // end: class DISTR
 
 
@@ -685,6 +745,12 @@ class __EXPORT_TYPE DISTR_gaussian : public DISTR
   double lassosum;
   double ridgesum;
 
+  double aggregatedss;                  // grouped likelihood: within group
+                                        // sum of squares
+  double aggregatednrobs;               // grouped likelihood: number of
+                                        // observations not represented by
+                                        // the grouped records
+
   public:
 
   FC FCsigma2;
@@ -716,6 +782,16 @@ class __EXPORT_TYPE DISTR_gaussian : public DISTR
 
    ~DISTR_gaussian() {}
 
+   // FUNCTION: set_aggregation
+   // TASK: response and weights are group means and group sizes of
+   //       observations with identical covariates. ss is the within group
+   //       sum of squares, nadd the number of additional observations and
+   //       sd the standard deviation of the original response (used to
+   //       scale the prior of the variance)
+
+   void set_aggregation(const double & ss,const double & nadd,
+                        const double & sd);
+
 
    void get_samples(const ST::string & filename,ofstream & outg) const;
 
@@ -730,6 +806,8 @@ class __EXPORT_TYPE DISTR_gaussian : public DISTR
                            const double * mu, double * deviance,
                            double * scale) const;
 
+  double compute_predict(double * pred,double * dev);
+
   double get_intercept_start(void);
 
   double loglikelihood(double * res,
@@ -789,6 +867,13 @@ class __EXPORT_TYPE DISTR_gaussian : public DISTR
 
   void update_scale_hyperparameters(datamatrix & h);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 //------------------------------------------------------------------------------
@@ -1070,6 +1155,13 @@ class __EXPORT_TYPE DISTR_vargaussian  : public DISTR
 
   void update(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   }; // end: class DISTR_vargaussian
 
 
@@ -1470,6 +1562,14 @@ class __EXPORT_TYPE DISTR_gaussian_multeffect : public DISTR_gaussian
   // TASK: updates linpred (safely)
 
   bool update_linpred_save(datamatrix & f, datamatrix & intvar, statmatrix<unsigned> & ind);
+
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 } // end: namespace MCMC
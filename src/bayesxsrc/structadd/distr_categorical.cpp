@@ -38,6 +38,7 @@ DISTR_logit_fruehwirth::DISTR_logit_fruehwirth(const int h, GENERAL_OPTIONS * o,
   : DISTR_binomial(o, r, w), H(h)
   {
 
+  predict_specialized = false;
   predictor_name = "pi";
   outexpectation = true;
 
@@ -227,6 +228,130 @@ bool DISTR_logit_fruehwirth::posteriormode(void)
   return DISTR_binomial::posteriormode();
   }
 
+//------------------------------------------------------------------------------
+//------------------ CLASS: DISTRIBUTION_logit_polyagamma ----------------------
+//------------------------------------------------------------------------------
+
+DISTR_logit_polyagamma::DISTR_logit_polyagamma(GENERAL_OPTIONS * o,
+                                               const datamatrix & r,
+                                               const datamatrix & w)
+  : DISTR_binomial(o,r,w)
+  {
+
+  predict_specialized = false;
+  predictor_name = "pi";
+  outexpectation = true;
+
+  family = "Binomial_pg";
+  updateIWLS = false;
+
+  check_errors();
+  }
+
+
+void DISTR_logit_polyagamma::check_errors(void)
+  {
+
+  if (errors==false)
+    {
+    unsigned i=0;
+    double * workresp = response.getV();
+    double * workweight = weight.getV();
+    while ( (i<nrobs) && (errors==false) )
+      {
+
+      if ((*workweight < 0) || (*workweight != floor(*workweight)))
+        {
+        errors=true;
+        errormessages.push_back("ERROR: weights must be nonnegative integers (number of trials)\n");
+        }
+      else if ((*workresp < 0) || (*workresp > 1))
+        {
+        errors=true;
+        errormessages.push_back("ERROR: response must be between 0 and 1\n");
+        }
+
+      i++;
+      workresp++;
+      workweight++;
+      }
+
+    }
+
+  }
+
+
+DISTR_logit_polyagamma::DISTR_logit_polyagamma(
+                                       const DISTR_logit_polyagamma & nd)
+  : DISTR_binomial(DISTR_binomial(nd))
+  {
+  }
+
+
+const DISTR_logit_polyagamma & DISTR_logit_polyagamma::operator=(
+                                       const DISTR_logit_polyagamma & nd)
+  {
+  if (this==&nd)
+    return *this;
+  DISTR_binomial::operator=(DISTR_binomial(nd));
+  return *this;
+  }
+
+
+void DISTR_logit_polyagamma::outoptions(void)
+  {
+  DISTR::outoptions();
+  optionsp->out("  Response function: logistic distribution function\n");
+  optionsp->out("  Polya-Gamma data augmentation\n");
+  optionsp->out("\n");
+  optionsp->out("\n");
+  }
+
+
+void DISTR_logit_polyagamma::update(void)
+  {
+
+  double * workresp = response.getV();
+  double * workwresp = workingresponse.getV();
+  double * weightwork = weight.getV();
+  double * wweightwork = workingweight.getV();
+
+  double * worklin;
+  if (linpred_current==1)
+    worklin = linearpred1.getV();
+  else
+    worklin = linearpred2.getV();
+
+  double omega;
+  unsigned i;
+
+  for(i=0;i<nrobs;i++,worklin++,workresp++,weightwork++,workwresp++,
+      wweightwork++)
+    {
+    if (*weightwork == 0)
+      {
+      *wweightwork = 0;
+      *workwresp = *worklin;
+      }
+    else
+      {
+      omega = rand_polyagamma(unsigned(*weightwork),*worklin);
+      *wweightwork = omega;
+      *workwresp = *weightwork*(*workresp-0.5)/omega;
+      }
+    }
+
+  DISTR::update();
+
+  }
+
+
+bool DISTR_logit_polyagamma::posteriormode(void)
+  {
+  return DISTR_binomial::posteriormode();
+  }
+
+
 //------------------------------------------------------------------------------
 //----------------------- CLASS DISTRIBUTION_binomial --------------------------
 //------------------------------------------------------------------------------
@@ -238,6 +363,7 @@ DISTR_binomial::DISTR_binomial(GENERAL_OPTIONS * o, const datamatrix & r,
 
   {
 
+  predict_specialized = true;
   predictor_name = "pi";
   outexpectation = true;
 
@@ -356,6 +482,55 @@ void DISTR_binomial::outoptions(void)
   }
 
 
+double DISTR_binomial::compute_predict(double * pred,double * dev)
+  {
+
+  if (!predict_specialized)
+    return DISTR::compute_predict(pred,dev);
+
+  unsigned i;
+
+  double * worklin;
+  if (linpred_current==1)
+    worklin = linearpred1.getV();
+  else
+    worklin = linearpred2.getV();
+
+  double * workresponse = response.getV();
+  double * workweight = weight.getV();
+  double el;
+  double mu;
+  double deviance = 0;
+
+  for (i=0;i<nrobs;i++,worklin++,workresponse++,workweight++)
+    {
+    el = exp(*worklin);
+    mu = el/(1+el);
+
+    if (dev != NULL)
+      {
+      if (*workresponse==0)
+        *dev = -2* *workweight * log(1-mu);
+      else if (*workresponse == 1)
+        *dev = -2* *workweight*log(mu);
+      else
+        *dev = -2* *workweight*( *workresponse*log(mu)+(1-*workresponse)*log(1-mu) );
+      deviance += *dev;
+      dev++;
+      }
+
+    *pred = *worklin;
+    pred++;
+    *pred = mu;
+    pred++;
+    *pred = mu;
+    pred++;
+    }
+
+  return deviance;
+  }
+
+
 double DISTR_binomial::get_intercept_start(void)
   {
   double m = response.mean(0);
@@ -576,6 +751,8 @@ DISTR_binomialprobit::DISTR_binomialprobit(GENERAL_OPTIONS * o,
 
   {
 
+  predict_specialized = true;
+
   outexpectation = true;
   predictor_name = "pi";
 
@@ -662,6 +839,20 @@ DISTR_binomialprobit::DISTR_binomialprobit(const DISTR_binomialprobit & nd)
   }
 
 
+void DISTR_binomialprobit::write_state(ofstream & out)
+  {
+  DISTR::write_state(out);
+  FC_latentutilities.write_state(out);
+  }
+
+
+void DISTR_binomialprobit::read_state(ifstream & in)
+  {
+  DISTR::read_state(in);
+  FC_latentutilities.read_state(in);
+  }
+
+
 void DISTR_binomialprobit::outoptions(void)
   {
   DISTR::outoptions();
@@ -671,6 +862,56 @@ void DISTR_binomialprobit::outoptions(void)
   }
 
 
+double DISTR_binomialprobit::compute_predict(double * pred,double * dev)
+  {
+
+  if (!predict_specialized)
+    return DISTR::compute_predict(pred,dev);
+
+  unsigned i;
+
+  double * worklin;
+  if (linpred_current==1)
+    worklin = linearpred1.getV();
+  else
+    worklin = linearpred2.getV();
+
+  double * workresponse = response.getV();
+  double * workweight = weight.getV();
+  double mu;
+  double deviance = 0;
+
+  for (i=0;i<nrobs;i++,worklin++,workresponse++,workweight++)
+    {
+    mu = randnumbers::Phi2(*worklin);
+
+    if (dev != NULL)
+      {
+      if (*workweight !=  0)
+        {
+        if (*workresponse<=0)
+          *dev = -2*log(1-mu);
+        else
+          *dev = -2*log(mu);
+        }
+      else
+        *dev = 0;
+      deviance += *dev;
+      dev++;
+      }
+
+    *pred = *worklin;
+    pred++;
+    *pred = mu;
+    pred++;
+    *pred = mu;
+    pred++;
+    }
+
+  return deviance;
+  }
+
+
 double DISTR_binomialprobit::get_intercept_start(void)
   {
 //  double m = response.mean(0);
@@ -996,15 +1237,62 @@ void DISTR_binomialprobit::update(void)
     worklin = linearpred2.getV();
 
 
-  for(i=0;i<nrobs;i++,worklin++,workresp++,weightwork++,workwresp++)
+  if (optionsp->fastprobit)
     {
 
-    if (*weightwork != 0)
+    // blocks of latent variables: z = lin + x with x >= -lin for positive
+    // and z = lin - x with x >= lin for non-positive responses
+
+    const unsigned blocksize = 256;
+    double lower[blocksize];
+    double draws[blocksize];
+    double sign[blocksize];
+    unsigned pos[blocksize];
+    unsigned k,nrblock;
+
+    double * linstart = worklin;
+    i = 0;
+    while (i < nrobs)
       {
-      if (*workresp > 0)
-        *workwresp = trunc_normal2(0,20,*worklin,1);
-      else
-        *workwresp = trunc_normal2(-20,0,*worklin,1);
+
+      nrblock = 0;
+      for(;(i<nrobs) && (nrblock<blocksize);i++,worklin++,workresp++,
+          weightwork++)
+        {
+        if (*weightwork != 0)
+          {
+          if (*workresp > 0)
+            sign[nrblock] = 1;
+          else
+            sign[nrblock] = -1;
+          lower[nrblock] = -sign[nrblock] * *worklin;
+          pos[nrblock] = i;
+          nrblock++;
+          }
+        }
+
+      trunc_normal_lower(lower,draws,nrblock);
+
+      for (k=0;k<nrblock;k++)
+        workwresp[pos[k]] = linstart[pos[k]]+sign[k]*draws[k];
+
+      }
+
+    }
+  else
+    {
+
+    for(i=0;i<nrobs;i++,worklin++,workresp++,weightwork++,workwresp++)
+      {
+
+      if (*weightwork != 0)
+        {
+        if (*workresp > 0)
+          *workwresp = trunc_normal2(0,20,*worklin,1);
+        else
+          *workwresp = trunc_normal2(-20,0,*worklin,1);
+        }
+
       }
 
     }
@@ -1301,6 +1589,8 @@ void DISTR_poisson::check_errors(void)
   if (errors==false)
     {
     unsigned i=0;
+    double counts;
+    bool noninteger;
     double * workresp = response.getV();
     double * workweight = weight.getV();
     while ( (i<nrobs) && (errors==false) )
@@ -1308,7 +1598,18 @@ void DISTR_poisson::check_errors(void)
 
       if (*workweight > 0)
         {
-        if (*workresp != int(*workresp))
+        // grouped records store the mean count of the group, only the total
+        // count has to be integer
+
+        if (optionsp->aggregate)
+          {
+          counts = *workresp * *workweight;
+          noninteger = fabs(counts - floor(counts+0.5)) > 1e-8*(1+counts);
+          }
+        else
+          noninteger = (*workresp != int(*workresp));
+
+        if (noninteger)
           {
           errors=true;
           errormessages.push_back("ERROR: response must be integer values\n");
@@ -1349,6 +1650,7 @@ DISTR_poisson::DISTR_poisson(GENERAL_OPTIONS * o, const datamatrix & r,
 
   {
 
+  predict_specialized = true;
   predictor_name = "lambda";
   outexpectation = true;
 
@@ -1373,6 +1675,7 @@ const DISTR_poisson & DISTR_poisson::operator=(
   if (this==&nd)
     return *this;
   DISTR::operator=(DISTR(nd));
+  lngammaresponse = nd.lngammaresponse;
   return *this;
   }
 
@@ -1380,6 +1683,7 @@ const DISTR_poisson & DISTR_poisson::operator=(
 DISTR_poisson::DISTR_poisson(const DISTR_poisson & nd)
    : DISTR(DISTR(nd))
   {
+  lngammaresponse = nd.lngammaresponse;
   }
 
 
@@ -1392,6 +1696,75 @@ void DISTR_poisson::outoptions(void)
   }
 
 
+double DISTR_poisson::compute_predict(double * pred,double * dev)
+  {
+
+  if (!predict_specialized)
+    return DISTR::compute_predict(pred,dev);
+
+  unsigned i;
+
+  double * worklin;
+  if (linpred_current==1)
+    worklin = linearpred1.getV();
+  else
+    worklin = linearpred2.getV();
+
+  double * workresponse = response.getV();
+  double * workweight = weight.getV();
+  double mu;
+  double deviance = 0;
+
+  // log(response!) does not change during the simulation
+
+  if ((dev != NULL) && (lngammaresponse.rows() != nrobs))
+    {
+    lngammaresponse = datamatrix(nrobs,1,0);
+    double rplusone;
+    for (i=0;i<nrobs;i++)
+      {
+      rplusone = response(i,0)+1;
+      lngammaresponse(i,0) = randnumbers::lngamma_exact(rplusone);
+      }
+    }
+
+  double * worklngamma = lngammaresponse.getV();
+
+  for (i=0;i<nrobs;i++,worklin++,workresponse++,workweight++)
+    {
+
+    if (*worklin <= linpredminlimit)
+      mu = exp(linpredminlimit);
+    else if (*worklin >= linpredmaxlimit)
+      mu = exp(linpredmaxlimit);
+    else
+      mu = exp(*worklin);
+
+    if (dev != NULL)
+      {
+      if (*workweight==0)
+        *dev = 0;
+      else if (*workresponse==0)
+        *dev = 2* *workweight * mu;
+      else
+        *dev = -2* *workweight*(*workresponse*log(mu)-mu-*worklngamma);
+      deviance += *dev;
+      dev++;
+      worklngamma++;
+      }
+
+    *pred = *worklin;
+    pred++;
+    *pred = mu;
+    pred++;
+    *pred = mu;
+    pred++;
+    }
+
+  return deviance;
+  }
+
+
 double DISTR_poisson::get_intercept_start(void)
   {
 //  return log(response.mean(0));
@@ -1634,6 +2007,8 @@ DISTR_poisson_ext::DISTR_poisson_ext(GENERAL_OPTIONS * o, const datamatrix & r,
   : DISTR_poisson(o,r,w)
 
   {
+  predict_specialized = false;
+
   a=ap;
   b=bp;
   adapt = ada;
@@ -1778,6 +2153,8 @@ DISTR_poisson_extlin::DISTR_poisson_extlin(GENERAL_OPTIONS * o,
   : DISTR_poisson(o,r,w)
 
   {
+  predict_specialized = false;
+
   }
 
 
@@ -82,6 +82,8 @@ class __EXPORT_TYPE DISTR_binomial : public DISTR
                         const double * mu,double * deviance,
                         double * scale) const;
 
+  double compute_predict(double * pred,double * dev);
+
   double get_intercept_start(void);
 
   double loglikelihood(double * response, double * linpred,
@@ -242,6 +244,63 @@ class __EXPORT_TYPE DISTR_logit_fruehwirth : public DISTR_binomial
 
 
 
+//------------------------------------------------------------------------------
+//------------------ CLASS: DISTRIBUTION_logit_polyagamma ----------------------
+//------------------------------------------------------------------------------
+
+// Binomial logit model with Polya-Gamma data augmentation (Polson, Scott and
+// Windle, 2013): given omega_i ~ PG(w_i,eta_i) the working observations
+// z_i = w_i*(y_i-0.5)/omega_i are Gaussian with mean eta_i and variance
+// 1/omega_i, i.e. all full conditionals are updated with Gibbs steps.
+// w_i (number of trials) must be a nonnegative integer.
+
+class __EXPORT_TYPE DISTR_logit_polyagamma : public DISTR_binomial
+  {
+
+  protected:
+
+  public:
+
+  void check_errors(void);
+
+  // DEFAULT CONSTRUCTOR
+
+  DISTR_logit_polyagamma(void) : DISTR_binomial()
+    {
+    }
+
+  // CONSTRUCTOR
+
+  DISTR_logit_polyagamma(GENERAL_OPTIONS * o, const datamatrix & r,
+                         const datamatrix & w=datamatrix());
+
+  // COPY CONSTRUCTOR
+
+  DISTR_logit_polyagamma(const DISTR_logit_polyagamma & nd);
+
+  // OVERLOADED ASSIGNMENT OPERATOR
+
+  const DISTR_logit_polyagamma & operator=(const DISTR_logit_polyagamma & nd);
+
+  // DESTRUCTOR
+
+  ~DISTR_logit_polyagamma()
+    {
+    }
+
+  void outoptions(void);
+
+  // FUNCTION: update
+  // TASK: draws the Polya-Gamma variables and computes working weights and
+  //       working response
+
+  void update(void);
+
+  bool posteriormode(void);
+
+  };
+
+
 //------------------------------------------------------------------------------
 //-------------------- CLASS: DISTRIBUTION_binomialprobit ----------------------
 //------------------------------------------------------------------------------
@@ -291,6 +350,8 @@ class __EXPORT_TYPE DISTR_binomialprobit : public DISTR
                         const double * mu,double * deviance,
                         double * scale) const;
 
+  double compute_predict(double * pred,double * dev);
+
   double get_intercept_start(void);
 
  // double cdf(const double & resp, const bool & ifcop);
@@ -336,6 +397,13 @@ class __EXPORT_TYPE DISTR_binomialprobit : public DISTR
 
   void get_samples(const ST::string & filename,ofstream & outg) const;
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -414,6 +482,8 @@ class __EXPORT_TYPE DISTR_poisson : public DISTR
 
   protected:
 
+  datamatrix lngammaresponse;    // log(response!), used in compute_predict
+
   public:
 
   void check_errors(void);
@@ -447,6 +517,8 @@ class __EXPORT_TYPE DISTR_poisson : public DISTR
                         const double * mu,double * deviance,
                         double * scale) const;
 
+  double compute_predict(double * pred,double * dev);
+
   double get_intercept_start(void);
 
   double cdf(double * res,double * param,double * weight,double * scale);
@@ -94,6 +94,22 @@ DISTR_multgaussian::DISTR_multgaussian(const DISTR_multgaussian & nd)
   }
 
 
+void DISTR_multgaussian::write_state(ofstream & out)
+  {
+  DISTR::write_state(out);
+  FC_scale.write_state(out);
+  FC_corr.write_state(out);
+  }
+
+
+void DISTR_multgaussian::read_state(ifstream & in)
+  {
+  DISTR::read_state(in);
+  FC_scale.read_state(in);
+  FC_corr.read_state(in);
+  }
+
+
 void DISTR_multgaussian::outoptions(void)
   {
   DISTR::outoptions();
@@ -322,13 +338,14 @@ void DISTR_multgaussian::compute_SIGMA_mr(unsigned r)
 
 void DISTR_multgaussian::compute_offset(void)
   {
-  unsigned i,j,k;
+  unsigned j;
 
   vector<double *> workresp;
   vector<double *> worklin;
 
   double * workresp_c = workingresponse.getV();
   double * workrespcat = response.getV();
+  double * workhelp = helpmat1.getV();
 
   for (j=0;j<nrcat;j++)
     {
@@ -345,23 +362,23 @@ void DISTR_multgaussian::compute_offset(void)
       }
     }
 
-  double o;
+  // helpmat1 has been computed by the master in compute_sigmarmr, the
+  // observations are independent
 
-  for (i=0;i<nrobs;i++,workresp_c++,workrespcat++)
+  int i;
+
+#if defined(_OPENMP)
+#pragma omp parallel for if(nrobs >= 1000)
+#endif
+  for (i=0;i<int(nrobs);i++)
     {
+    unsigned k;
+    double o = 0;
 
-    o = 0;
     for (k=0;k<nrcat-1;k++)
-      {
-      o += helpmat1(0,k)*((*workresp[k]) - (*worklin[k]));
-      if (i<nrobs-1)
-        {
-        workresp[k]++;
-        worklin[k]++;
-        }
-      }
+      o += workhelp[k]*(workresp[k][i] - worklin[k][i]);
 
-    *workresp_c = *workrespcat-o;
+    workresp_c[i] = workrespcat[i]-o;
 
     } // end: for (i=0;i<nrobs;i++)
 
@@ -384,30 +401,36 @@ void DISTR_multgaussian::initpointer(unsigned j,double* & worklin, double* & wor
 void DISTR_multgaussian::compute_IWproduct(void)
   {
 
-  unsigned i,j,k;
+  // sumB is symmetric, only the upper triangle is computed
 
-  double * sumBwork = sumB.getV();
+  int i;
 
-  double * worklin1;
-  double * worklin2;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if(nrobs >= 1000)
+#endif
+  for(i=0;i<int(sumB.rows());i++)
+    {
+    unsigned j,k;
+    double sum;
 
-  double * workresp1;
-  double * workresp2;
+    double * worklin1;
+    double * worklin2;
 
+    double * workresp1;
+    double * workresp2;
 
-  for(i=0;i<sumB.rows();i++)
-    {
-    for(j=0;j<sumB.cols();j++,sumBwork++)
+    for(j=i;j<sumB.cols();j++)
       {
-      *sumBwork = 0;
+      sum = 0;
 
       initpointer(i,worklin1,workresp1);
       initpointer(j,worklin2,workresp2);
 
       for(k=0;k<nrobs;k++,worklin1++,worklin2++,workresp1++,workresp2++)
-        *sumBwork +=  (*workresp1-(*worklin1)) * (*workresp2-(*worklin2));
+        sum +=  (*workresp1-(*worklin1)) * (*workresp2-(*worklin2));
 
-      *sumBwork *= 0.5;
+      sumB(i,j) = 0.5*sum;
+      sumB(j,i) = sumB(i,j);
       }
     }
 
@@ -947,6 +970,46 @@ void DISTR_multinomprobit::update(void)
 
     double lin;
 
+    if (optionsp->fastprobit)
+      {
+
+      // exact one-sided sampler, the bounds -20 and 20 of the default
+      // sampler are ignored
+
+      for (i=0;i<nrobs;i++,wresponsecat++)
+        {
+        if (*wresponsecat == -1)   // reference category
+          {
+
+          for (j=0;j<=nrothercat;j++)
+            {
+            lin = (*worklin[j])(i,0);
+            (*responsep[j])(i,0) = lin-trunc_normal_lower(lin);
+            }
+
+          }
+        else
+          {
+          lin = (*worklin[*wresponsecat])(i,0);
+          (*responsep[*wresponsecat])(i,0) = lin +
+          trunc_normal_lower(maxutility(responsep,i,*wresponsecat) - lin);
+
+          for (j=0;j<=nrothercat;j++)
+            {
+            if (j != (*wresponsecat))
+              {
+              lin = (*worklin[j])(i,0);
+              (*responsep[j])(i,0) = lin -
+              trunc_normal_lower(lin-(*responsep[*wresponsecat])(i,0));
+              }
+            }
+
+          }
+
+        }
+
+      }
+    else
     for (i=0;i<nrobs;i++,wresponsecat++)
       {
       if (*wresponsecat == -1)   // reference category
@@ -280,6 +280,13 @@ class __EXPORT_TYPE DISTR_multgaussian : public DISTR_multinomprobit
 
   void get_samples(const ST::string & filename,ofstream & outg) const;
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -330,6 +330,22 @@ void DISTR_negbin_delta::compute_iwls_wweightschange_weightsone(
   }
 
 
+void DISTR_negbin_delta::write_state(ofstream & out)
+  {
+  DISTR::write_state(out);
+  save_value(out,E_dig_y_delta_m);
+  save_value(out,E_trig_y_delta_m);
+  }
+
+
+void DISTR_negbin_delta::read_state(ifstream & in)
+  {
+  DISTR::read_state(in);
+  load_value(in,E_dig_y_delta_m);
+  load_value(in,E_trig_y_delta_m);
+  }
+
+
 void DISTR_negbin_delta::outoptions(void)
   {
   DISTR::outoptions();
@@ -2138,6 +2154,22 @@ DISTR_negbinzip_delta::DISTR_negbinzip_delta(const DISTR_negbinzip_delta & nd)
   }
 
 
+void DISTR_negbinzip_delta::write_state(ofstream & out)
+  {
+  DISTR::write_state(out);
+  save_value(out,E_dig_y_delta_m);
+  save_value(out,E_trig_y_delta_m);
+  }
+
+
+void DISTR_negbinzip_delta::read_state(ifstream & in)
+  {
+  DISTR::read_state(in);
+  load_value(in,E_dig_y_delta_m);
+  load_value(in,E_trig_y_delta_m);
+  }
+
+
 void DISTR_negbinzip_delta::outoptions(void)
   {
   DISTR::outoptions();
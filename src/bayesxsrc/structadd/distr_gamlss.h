@@ -193,6 +193,13 @@ class __EXPORT_TYPE DISTR_negbin_delta : public DISTR_gamlss
 
   void update_end(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -683,6 +690,13 @@ class __EXPORT_TYPE DISTR_negbinzip_delta : public DISTR
 
   void update_end(void);
 
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
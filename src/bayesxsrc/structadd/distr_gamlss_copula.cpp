@@ -1621,6 +1621,13 @@ double DISTR_gumbel_copula::condfc(double & x, double & linpred_F, double & y, d
   #if defined(BayesX_gsl_included)
   if (this->optionsp->rotation != 0)
     {
+    if (optionsp->inmemory)
+      {
+      if (!errors)
+        errormessages.push_back("ERROR: rotations are not implemented for Gumbel copula\n");
+      errors = true;
+      return linpred_F;
+      }
     std::cerr << "Roatations are not implemented for Gumbel Copula" << std::endl;
     exit(1);
     }
@@ -1672,6 +1679,13 @@ double DISTR_gumbel_copula::condfc(double & x, double & linpred_F, double & y, d
   return res;
 
   #else
+  if (optionsp->inmemory)
+    {
+    if (!errors)
+      errormessages.push_back("ERROR: Gumbel copula requires GSL\n");
+    errors = true;
+    return linpred_F;
+    }
   std::cerr << "Gumbel Copula requires GSL" << std::endl;
   exit(1);
   #endif
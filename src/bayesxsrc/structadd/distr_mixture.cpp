@@ -52,6 +52,8 @@ DISTR_gaussianmixture::DISTR_gaussianmixture(const double & a,const double & b,
   : DISTR_gaussian(a,b,o,r,ps,w)
   {
 
+  predict_specialized = false;
+
   family = "Mixture of Gaussians";
 
   nrknots = 5;
@@ -176,6 +178,24 @@ void DISTR_gaussianmixture::compute_iwls_wweightsnochange_one(double * response,
 */
 
 
+void DISTR_gaussianmixture::write_state(ofstream & out)
+  {
+  DISTR_gaussian::write_state(out);
+  save_value(out,alpha);
+  save_value(out,alpha_prob);
+  alphasample.write_state(out);
+  }
+
+
+void DISTR_gaussianmixture::read_state(ifstream & in)
+  {
+  DISTR_gaussian::read_state(in);
+  load_value(in,alpha);
+  load_value(in,alpha_prob);
+  alphasample.read_state(in);
+  }
+
+
 void DISTR_gaussianmixture::outoptions(void)
   {
   DISTR::outoptions();
@@ -148,6 +148,14 @@ class __EXPORT_TYPE DISTR_gaussianmixture : public DISTR_gaussian
 
   void outresults_predictive_check(datamatrix & D,datamatrix & sr);
   */
+
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the state to/from a binary snapshot
+
+  void write_state(ofstream & out);
+
+  void read_state(ifstream & in);
+
   };
 
 
@@ -22,11 +22,20 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include"clstring.h"
 #include <stdlib.h>
 #include<math.h>
+#include<stdio.h>
+#include<algorithm>
+#include"checkpoint.h"
+#include"arena.h"
 
 
 namespace MCMC
 {
 
+// identification of snapshot files written by MCMCsim::write_checkpoint
+
+static const char checkpointheader[] = "BayesX MCMC snapshot";
+static const unsigned checkpointversion = 4;
+
 //------------------------------------------------------------------------------
 //---------------------------- class equation  ---------------------------------
 //------------------------------------------------------------------------------
@@ -213,12 +222,39 @@ const int & seed, const bool & computemode, const bool & skipfirst)
     ST::string h = "";
     bool c = false;
     c = posteriormode(h,skipfirst,true);
+    if (genoptions->inmemory && runtime_errors())
+      return true;
     }
 
   //-------------- end: Compute posterior mode as starting value ---------------
 
 
 
+  genoptions->storedFC.erase(genoptions->storedFC.begin(),
+                             genoptions->storedFC.end());
+
+  //----------------------- Resume from snapshot -------------------------------
+
+  // the posterior mode has been computed as for a new run, i.e. all
+  // quantities that are initialized there (design matrices, etc.) are
+  // available before the state is overwritten by the snapshot
+
+  ST::string pathcheckpoint = pathgraphs + "_checkpoint.bin";
+  unsigned itstart = 1;
+
+  if (genoptions->resume)
+    {
+    if (read_checkpoint(pathcheckpoint))
+      return true;
+
+    itstart = genoptions->nriter+1;
+    genoptions->out("  SIMULATION RESUMED AFTER ITERATION " +
+                    ST::inttostring(genoptions->nriter) + "\n");
+    genoptions->out("\n");
+    }
+
+  //--------------------- end: Resume from snapshot ----------------------------
+
   clock_t beginsim = clock();
   clock_t it1per;
   clock_t endsim;
@@ -230,7 +266,12 @@ const int & seed, const bool & computemode, const bool & skipfirst)
     double clk = (double)CLK_TCK;
   #endif
 
-  for (it=1;it<=iterations;it++)
+#if defined(COUNT_ALLOCATIONS)
+  unsigned long nrallocstart = scratch::nrheapallocations;
+  unsigned itcount = 0;
+#endif
+
+  for (it=itstart;it<=iterations;it++)
     {
 
 
@@ -280,8 +321,57 @@ const int & seed, const bool & computemode, const bool & skipfirst)
          }
       equations[nrmodels-1-i].distrp->update_end();
       }
+
+    // scratch memory of the updates is released after each iteration
+
+    scratch::iteration_arena().reset();
+
+    if (genoptions->inmemory && runtime_errors())
+      return true;
+
+#if defined(COUNT_ALLOCATIONS)
+    itcount++;
+#endif
+
+    bool stop = false;
+
+    if (genoptions->earlystopping() && (it > genoptions->burnin) &&
+        (it < iterations) &&
+        ((it-genoptions->burnin) % genoptions->stopcheck == 0) )
+      {
+      if (check_convergence())
+        {
+        genoptions->out("\n");
+        genoptions->out("  STOPPING RULE MET AFTER ITERATION " +
+                        ST::inttostring(it) + "\n");
+        genoptions->out("\n");
+
+        genoptions->iterations = it;
+        for (j=0;j<genoptions->storedFC.size();j++)
+          genoptions->storedFC[j]->truncate_samples();
+        stop = true;
+        }
+      }
+
+    if ( (genoptions->checkpoint > 0) &&
+         (stop || (it == iterations) || (it % genoptions->checkpoint == 0)) )
+      write_checkpoint(pathcheckpoint);
+
+    if (stop)
+      break;
+
     } // end: for (i=1;i<=genoptions->iterations;i++)
 
+#if defined(COUNT_ALLOCATIONS)
+  if (itcount > 0)
+    {
+    genoptions->out("\n");
+    genoptions->out("  HEAP ALLOCATIONS PER ITERATION: " +
+           ST::doubletostring(double(scratch::nrheapallocations-nrallocstart)/
+                              double(itcount),6) + "\n");
+    }
+#endif
+
 
       {
       genoptions->out("\n");
@@ -313,6 +403,12 @@ const int & seed, const bool & computemode, const bool & skipfirst)
         genoptions->out("\n");
         }
 
+      // in-process runs: the results are collected by the caller directly
+      // from the full conditionals (see genoptions->storedFC)
+
+      if (genoptions->inmemory)
+        return false;
+
       genoptions->out("\n");
       genoptions->out("ESTIMATION RESULTS:\n",true);
       genoptions->out("\n");
@@ -357,6 +453,16 @@ const int & seed, const bool & computemode, const bool & skipfirst)
 
         }
 
+      if (genoptions->convdiag)
+        {
+        ST::string pathdiag = pathgraphs + "_convdiag.res";
+        out_diagnostics(pathdiag);
+        genoptions->out("  CONVERGENCE DIAGNOSTICS ARE STORED IN FILE\n");
+        genoptions->out("\n");
+        genoptions->out("    " + pathdiag + "\n");
+        genoptions->out("\n");
+        }
+
       genoptions->out("  FILES FOR VISUALIZING RESULTS:\n",true,true,12,255,0,0);
       genoptions->out("\n");
       genoptions->out("    STATA DO-FILE\n");
@@ -477,6 +583,9 @@ bool MCMCsim::posteriormode(ST::string & pathgraphs, const bool & skipfirst, con
 
         }
 
+      if (genoptions->inmemory && runtime_errors())
+        break;
+
       if (allconverged)
         converged = true;
       else
@@ -544,6 +653,258 @@ bool MCMCsim::posteriormode(ST::string & pathgraphs, const bool & skipfirst, con
   }
 
 
+bool MCMCsim::write_checkpoint(const ST::string & path)
+  {
+  unsigned i,j;
+  unsigned nrmodels = equations.size();
+
+  // the state of the random number generator is stored in the snapshot,
+  // i.e. a resumed run continues with exactly the same random numbers as an
+  // uninterrupted run. If the state is not accessible, the generator is
+  // reseeded with a value drawn from the current stream and the seed is
+  // stored instead (a resumed run then continues like an uninterrupted run
+  // with the same checkpoint setting)
+
+  vector<int> randomstate;
+  bool staterandom = get_randomstate(randomstate);
+  unsigned newseed = 0;
+  if (!staterandom)
+    {
+    newseed = rand();
+    srand(newseed);
+    }
+
+  ST::string pathtmp = path + ".tmp";
+  ofstream out(pathtmp.strtochar(),std::ios::binary);
+
+  save_value(out,ST::string(checkpointheader));
+  save_value(out,checkpointversion);
+  save_value(out,staterandom);
+  if (staterandom)
+    save_value(out,randomstate);
+  else
+    save_value(out,newseed);
+  genoptions->write_state(out);
+
+  // model signature
+
+  save_value(out,nrmodels);
+  for (i=0;i<nrmodels;i++)
+    {
+    save_value(out,equations[i].distrp->family);
+    save_value(out,unsigned(equations[i].FCpointer.size()));
+    for (j=0;j<equations[i].FCpointer.size();j++)
+      save_value(out,equations[i].FCpointer[j]->title);
+    }
+
+  // states, objects shared by several equations are stored only once
+
+  vector<DISTR*> distrdone;
+  vector<FC*> FCdone;
+  for (i=0;i<nrmodels;i++)
+    {
+    if (find(distrdone.begin(),distrdone.end(),equations[i].distrp) ==
+        distrdone.end())
+      {
+      equations[i].distrp->write_state(out);
+      distrdone.push_back(equations[i].distrp);
+      }
+    for (j=0;j<equations[i].FCpointer.size();j++)
+      {
+      if (find(FCdone.begin(),FCdone.end(),equations[i].FCpointer[j]) ==
+          FCdone.end())
+        {
+        equations[i].FCpointer[j]->write_state(out);
+        FCdone.push_back(equations[i].FCpointer[j]);
+        }
+      }
+    }
+
+  save_value(out,ST::string(checkpointheader));
+
+  bool failed = out.fail();
+  out.close();
+
+  // atomic replacement of the previous snapshot
+
+  if (!failed)
+    {
+#if !defined(__BUILDING_LINUX)
+    remove(path.strtochar());
+#endif
+    failed = (rename(pathtmp.strtochar(),path.strtochar()) != 0);
+    }
+
+  if (failed)
+    {
+    remove(pathtmp.strtochar());
+    genoptions->out("  WARNING: Could not write snapshot to file " + path +
+                    "\n");
+    return true;
+    }
+
+  return false;
+  }
+
+
+bool MCMCsim::read_checkpoint(const ST::string & path)
+  {
+  unsigned i,j;
+  unsigned nrmodels = equations.size();
+
+  ifstream in(path.strtochar(),std::ios::binary);
+  if (in.fail())
+    {
+    genoptions->out("ERROR: snapshot file " + path + " could not be opened\n",
+                    true,true,12,255,0,0);
+    return true;
+    }
+
+  ST::string header = checkpointheader;
+  ST::string h;
+  unsigned version;
+  bool staterandom;
+  vector<int> randomstate;
+  unsigned newseed = 0;
+  load_value(in,h);
+  load_value(in,version);
+  if (in.fail() || (h != header) || (version != checkpointversion))
+    {
+    genoptions->out("ERROR: " + path + " is not a valid snapshot file\n",
+                    true,true,12,255,0,0);
+    return true;
+    }
+
+  load_value(in,staterandom);
+  if (staterandom)
+    load_value(in,randomstate);
+  else
+    load_value(in,newseed);
+  if (!genoptions->read_state(in))
+    {
+    genoptions->out("ERROR: snapshot is incompatible with current options\n",
+                    true,true,12,255,0,0);
+    genoptions->out("       burnin and step must not be changed, iterations must not be decreased\n",
+                    true,true,12,255,0,0);
+    return true;
+    }
+
+  bool ok = true;
+  unsigned n;
+  load_value(in,n);
+  if (n != nrmodels)
+    ok = false;
+  for (i=0;(i<nrmodels) && ok;i++)
+    {
+    load_value(in,h);
+    load_value(in,n);
+    if ((h != equations[i].distrp->family) ||
+        (n != equations[i].FCpointer.size()))
+      ok = false;
+    for (j=0;(j<n) && ok;j++)
+      {
+      load_value(in,h);
+      if (h != equations[i].FCpointer[j]->title)
+        ok = false;
+      }
+    }
+
+  if (ok && !in.fail())
+    {
+    vector<DISTR*> distrdone;
+    vector<FC*> FCdone;
+    for (i=0;(i<nrmodels) && !in.fail();i++)
+      {
+      if (find(distrdone.begin(),distrdone.end(),equations[i].distrp) ==
+          distrdone.end())
+        {
+        equations[i].distrp->read_state(in);
+        distrdone.push_back(equations[i].distrp);
+        }
+      for (j=0;(j<equations[i].FCpointer.size()) && !in.fail();j++)
+        {
+        if (find(FCdone.begin(),FCdone.end(),equations[i].FCpointer[j]) ==
+            FCdone.end())
+          {
+          equations[i].FCpointer[j]->read_state(in);
+          FCdone.push_back(equations[i].FCpointer[j]);
+          }
+        }
+      }
+    load_value(in,h);
+    if (in.fail() || (h != header))
+      ok = false;
+    }
+  else
+    ok = false;
+
+  if (!ok)
+    {
+    genoptions->out("ERROR: snapshot " + path +
+                    " does not match the current model\n",
+                    true,true,12,255,0,0);
+    return true;
+    }
+
+  if (staterandom)
+    {
+    if (!set_randomstate(randomstate))
+      {
+      genoptions->out("ERROR: state of the random number generator in snapshot " +
+                      path + " cannot be restored on this platform\n",
+                      true,true,12,255,0,0);
+      return true;
+      }
+    }
+  else
+    srand(newseed);
+
+  return false;
+  }
+
+
+
+bool MCMCsim::runtime_errors(void)
+  {
+  unsigned i;
+  for (i=0;i<equations.size();i++)
+    if (equations[i].distrp->errors)
+      return true;
+  return false;
+  }
+
+
+bool MCMCsim::check_convergence(void)
+  {
+  unsigned j;
+  bool monitored = false;
+  for (j=0;j<genoptions->storedFC.size();j++)
+    {
+    if (genoptions->storedFC[j]->diagnostics.get_nrpar() > 0)
+      {
+      monitored = true;
+      if (!genoptions->storedFC[j]->diagnostics.converged(genoptions->essstop,
+                                                          genoptions->rhatstop))
+        return false;
+      }
+    }
+  return monitored;
+  }
+
+
+void MCMCsim::out_diagnostics(const ST::string & path)
+  {
+  unsigned j,l;
+  ofstream out(path.strtochar());
+  out << "fc   paramnr   ess   rhat   geweke   ";
+  for (l=1;l<=genoptions->diaglag;l++)
+    out << "acf" << l << "   ";
+  out << endl;
+  for (j=0;j<genoptions->storedFC.size();j++)
+    genoptions->storedFC[j]->outresults_diagnostics(out);
+  }
+
+
 void MCMCsim::out_effects(const vector<ST::string> & paths)
   {
 
@@ -129,6 +129,42 @@ class __EXPORT_TYPE MCMCsim
 
   bool posteriormode(ST::string & pathgraphs, const bool & skipfirst, const bool & presim);
 
+  // FUNCTION: runtime_errors
+  // TASK: returns true if an error occured during the updates of one of the
+  //       response distributions (only possible for in-process runs, see
+  //       DISTR::check_linpred), the simulation is then terminated
+
+  bool runtime_errors(void);
+
+  // FUNCTION: check_convergence
+  // TASK: returns true if the online convergence diagnostics of all
+  //       monitored parameters meet the stopping rule
+
+  bool check_convergence(void);
+
+  // FUNCTION: write_checkpoint
+  // TASK: writes a binary snapshot of the current MCMC state (iteration
+  //       counters, random number generator, all distributions and full
+  //       conditionals) to file 'path'. The file is written to 'path'.tmp
+  //       first and renamed afterwards, i.e. an existing snapshot is
+  //       never left in an incomplete state.
+  //       returns true if the snapshot could not be written
+
+  bool write_checkpoint(const ST::string & path);
+
+  // FUNCTION: read_checkpoint
+  // TASK: restores the MCMC state from the snapshot stored in file 'path'
+  //       returns true if the snapshot could not be read or does not match
+  //       the current model
+
+  bool read_checkpoint(const ST::string & path);
+
+  // FUNCTION: out_diagnostics
+  // TASK: writes online convergence diagnostics of all monitored parameters
+  //       to file 'path'
+
+  void out_diagnostics(const ST::string & path);
+
   void out_effects(const vector<ST::string> & paths);
 
 
@@ -0,0 +1,371 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+#include "model_comparison.h"
+#include<algorithm>
+#include<functional>
+#include<cmath>
+
+namespace MCMC
+{
+
+//------------------------------------------------------------------------------
+//----------------------- CLASS: model_comparison ------------------------------
+//------------------------------------------------------------------------------
+
+
+model_comparison::model_comparison(void)
+  {
+  nrobs = 0;
+  tailsize = 0;
+  nrdraws = 0;
+  }
+
+
+model_comparison::model_comparison(const unsigned & n,const unsigned & ss)
+  {
+  nrobs = n;
+
+  double s = ss;
+  double t = 0.2*s;
+  if (3*sqrt(s) < t)
+    t = 3*sqrt(s);
+  tailsize = unsigned(ceil(t));
+  if (tailsize < 1)
+    tailsize = 1;
+
+  nrdraws = 0;
+
+  maxlogp = datamatrix(nrobs,1,0);
+  sumexp = datamatrix(nrobs,1,0);
+  meanlogp = datamatrix(nrobs,1,0);
+  ssqlogp = datamatrix(nrobs,1,0);
+  maxlogr = datamatrix(nrobs,1,0);
+  sumratio = datamatrix(nrobs,1,0);
+  tail = datamatrix(nrobs,tailsize+1,0);
+  }
+
+
+model_comparison::model_comparison(const model_comparison & m)
+  {
+  nrobs = m.nrobs;
+  tailsize = m.tailsize;
+  nrdraws = m.nrdraws;
+  maxlogp = m.maxlogp;
+  sumexp = m.sumexp;
+  meanlogp = m.meanlogp;
+  ssqlogp = m.ssqlogp;
+  maxlogr = m.maxlogr;
+  sumratio = m.sumratio;
+  tail = m.tail;
+  }
+
+
+const model_comparison & model_comparison::operator=(
+                                            const model_comparison & m)
+  {
+  if (this==&m)
+    return *this;
+  nrobs = m.nrobs;
+  tailsize = m.tailsize;
+  nrdraws = m.nrdraws;
+  maxlogp = m.maxlogp;
+  sumexp = m.sumexp;
+  meanlogp = m.meanlogp;
+  ssqlogp = m.ssqlogp;
+  maxlogr = m.maxlogr;
+  sumratio = m.sumratio;
+  tail = m.tail;
+  return *this;
+  }
+
+
+void model_comparison::update(const unsigned & i,const double & logp)
+  {
+
+  double * mp = maxlogp.getV()+i;
+  double * se = sumexp.getV()+i;
+
+  // log-sum-exp of log p, rescaled if the maximum changes
+
+  if (nrdraws==0)
+    {
+    *mp = logp;
+    *se = 1;
+    }
+  else if (logp > *mp)
+    {
+    *se = *se*exp(*mp-logp)+1;
+    *mp = logp;
+    }
+  else
+    *se += exp(logp-*mp);
+
+  // running mean and sum of squared deviations
+
+  double * m = meanlogp.getV()+i;
+  double delta = logp - *m;
+  *m += delta/(nrdraws+1);
+  *(ssqlogp.getV()+i) += delta*(logp - *m);
+
+  // log-sum-exp of the log importance ratios log r = -log p
+
+  double logr = -logp;
+  double * mr = maxlogr.getV()+i;
+  double * sr = sumratio.getV()+i;
+
+  if (nrdraws==0)
+    {
+    *mr = logr;
+    *sr = 1;
+    }
+  else if (logr > *mr)
+    {
+    *sr = *sr*exp(*mr-logr)+1;
+    *mr = logr;
+    }
+  else
+    *sr += exp(logr-*mr);
+
+  // min-heap of the tailsize+1 largest log ratios
+
+  double * h = tail.getV()+i*(tailsize+1);
+  if (nrdraws < tailsize+1)
+    {
+    h[nrdraws] = logr;
+    std::push_heap(h,h+nrdraws+1,std::greater<double>());
+    }
+  else if (logr > h[0])
+    {
+    std::pop_heap(h,h+tailsize+1,std::greater<double>());
+    h[tailsize] = logr;
+    std::push_heap(h,h+tailsize+1,std::greater<double>());
+    }
+
+  }
+
+
+void model_comparison::reset(void)
+  {
+  nrdraws = 0;
+  maxlogp = datamatrix(nrobs,1,0);
+  sumexp = datamatrix(nrobs,1,0);
+  meanlogp = datamatrix(nrobs,1,0);
+  ssqlogp = datamatrix(nrobs,1,0);
+  maxlogr = datamatrix(nrobs,1,0);
+  sumratio = datamatrix(nrobs,1,0);
+  tail = datamatrix(nrobs,tailsize+1,0);
+  }
+
+
+void model_comparison::compute_WAIC(double & l_pd,double & p_d) const
+  {
+  l_pd = 0;
+  p_d = 0;
+
+  if (nrdraws < 2)
+    return;
+
+  double logS = log(double(nrdraws));
+  double r = 1.0/(nrdraws-1);
+
+  unsigned i;
+  double * mp = maxlogp.getV();
+  double * se = sumexp.getV();
+  double * ssq = ssqlogp.getV();
+  for (i=0;i<nrobs;i++,mp++,se++,ssq++)
+    {
+    l_pd += *mp + log(*se) - logS;
+    p_d += *ssq*r;
+    }
+
+  l_pd *= -2.0;
+  }
+
+
+void model_comparison::fit_gpd(const vector<double> & x,double & k,
+                               double & sigma) const
+  {
+
+  unsigned n = x.size();
+  double xmax = x[n-1];
+
+  if (xmax <= 0)
+    {
+    k = 0;
+    sigma = 0;
+    return;
+    }
+
+  double xq = x[unsigned(floor(n/4.0+0.5))-1];
+  if (xq <= 0)
+    xq = xmax;
+
+  unsigned m = 30 + unsigned(floor(sqrt(double(n))));
+  vector<double> b(m);
+  vector<double> L(m);
+
+  unsigned j,l;
+  for (j=0;j<m;j++)
+    {
+    b[j] = 1/xmax + (1-sqrt(m/(j+0.5)))/(3*xq);
+
+    double kj=0;
+    for (l=0;l<n;l++)
+      kj += log1p(-b[j]*x[l]);
+    kj /= n;
+
+    L[j] = n*(log(-b[j]/kj) - kj - 1);
+    }
+
+  // posterior mean of b
+
+  double bhat=0;
+  for (j=0;j<m;j++)
+    {
+    double s=0;
+    for (l=0;l<m;l++)
+      s += exp(L[l]-L[j]);
+    bhat += b[j]/s;
+    }
+
+  k=0;
+  for (l=0;l<n;l++)
+    k += log1p(-bhat*x[l]);
+  k /= n;
+  sigma = -k/bhat;
+
+  // weakly informative prior for k
+
+  k = (n*k + 10*0.5)/(n+10);
+  }
+
+
+void model_comparison::compute_LOO(double & elpd,double & p_loo,
+                                   datamatrix & k) const
+  {
+
+  elpd = 0;
+  p_loo = 0;
+  k = datamatrix(nrobs,1,0);
+
+  if (nrdraws < 2)
+    return;
+
+  double S = nrdraws;
+  double logS = log(S);
+  bool smooth = (nrdraws > tailsize) && (tailsize >= 5);
+
+  vector<double> lr(tailsize+1);
+  vector<double> x(tailsize);
+
+  unsigned i,j;
+  for (i=0;i<nrobs;i++)
+    {
+
+    double lmax = maxlogr(i,0);
+    double elpdi;
+
+    if (smooth)
+      {
+      double * h = tail.getV()+i*(tailsize+1);
+      for (j=0;j<=tailsize;j++)
+        lr[j] = h[j];
+      std::sort(lr.begin(),lr.end());
+
+      double u = exp(lr[0]-lmax);
+      double rawtail=0;
+      for (j=0;j<tailsize;j++)
+        {
+        double r = exp(lr[j+1]-lmax);
+        rawtail += r;
+        x[j] = r-u;
+        }
+
+      double kh,sigma;
+      fit_gpd(x,kh,sigma);
+      k(i,0) = kh;
+
+      // replace the tail by the expected order statistics of the fitted
+      // distribution, truncated at the largest raw ratio
+
+      double num = S-tailsize;
+      double den = sumratio(i,0)-rawtail;
+      if (den < 0)
+        den = 0;
+
+      for (j=0;j<tailsize;j++)
+        {
+        double p = (j+0.5)/tailsize;
+        double q;
+        if (fabs(kh) < 1e-12)
+          q = -sigma*log1p(-p);
+        else
+          q = sigma*expm1(-kh*log1p(-p))/kh;
+        double w = u+q;
+        if (w > 1)
+          w = 1;
+        den += w;
+        num += w*exp(lmax-lr[j+1]);
+        }
+
+      elpdi = log(num) - lmax - log(den);
+      }
+    else
+      elpdi = logS - lmax - log(sumratio(i,0));
+
+    elpd += elpdi;
+    p_loo += maxlogp(i,0) + log(sumexp(i,0)) - logS - elpdi;
+    }
+
+  }
+
+
+void model_comparison::write_state(ofstream & out) const
+  {
+  save_value(out,nrobs);
+  save_value(out,tailsize);
+  save_value(out,nrdraws);
+  save_value(out,maxlogp);
+  save_value(out,sumexp);
+  save_value(out,meanlogp);
+  save_value(out,ssqlogp);
+  save_value(out,maxlogr);
+  save_value(out,sumratio);
+  save_value(out,tail);
+  }
+
+
+void model_comparison::read_state(ifstream & in)
+  {
+  load_value(in,nrobs);
+  load_value(in,tailsize);
+  load_value(in,nrdraws);
+  load_value(in,maxlogp);
+  load_value(in,sumexp);
+  load_value(in,meanlogp);
+  load_value(in,ssqlogp);
+  load_value(in,maxlogr);
+  load_value(in,sumratio);
+  load_value(in,tail);
+  }
+
+
+} // end: namespace MCMC
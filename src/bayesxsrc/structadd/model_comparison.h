@@ -0,0 +1,152 @@
+/* BayesX - Software for Bayesian Inference in
+Structured Additive Regression Models.
+Copyright (C) 2019 Christiane Belitz, Andreas Brezger,
+Nadja Klein, Thomas Kneib, Stefan Lang, Nikolaus Umlauf
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA. */
+
+
+#if !defined (MODELCOMP_INCLUDED)
+
+#define MODELCOMP_INCLUDED
+
+#include"../export_type.h"
+#include"statmat.h"
+#include"checkpoint.h"
+
+namespace MCMC
+{
+
+//------------------------------------------------------------------------------
+//----------------------- CLASS: model_comparison ------------------------------
+//------------------------------------------------------------------------------
+
+// Streaming computation of the WAIC and of the Pareto smoothed importance
+// sampling approximation of leave-one-out cross validation (PSIS-LOO).
+// The pointwise log-likelihoods of the retained draws are processed one
+// draw at a time, the n x S matrix of log-likelihoods is never stored.
+//
+// - WAIC: per observation a running log-sum-exp of log p(y_i|theta_s)
+//   (log pointwise predictive density) and running mean and variance of
+//   log p(y_i|theta_s) (effective number of parameters, Welford updates)
+// - PSIS-LOO: per observation a running log-sum-exp of the importance
+//   ratios 1/p(y_i|theta_s) and a min-heap of the 'tailsize'+1 largest
+//   log ratios. The generalized Pareto distribution is fitted to the
+//   'tailsize' largest ratios (Zhang and Stephens, 2009) and the ratios are
+//   replaced by the expected order statistics of the fitted distribution.
+//
+// Memory is O(n * tailsize) with tailsize = min(S/5,3*sqrt(S)).
+
+class __EXPORT_TYPE model_comparison
+  {
+
+  protected:
+
+  unsigned nrobs;                  // number of observations
+  unsigned tailsize;               // number of smoothed importance ratios
+  unsigned nrdraws;                // number of processed draws
+
+  datamatrix maxlogp;              // nrobs x 1, maximum of log p
+  datamatrix sumexp;               // nrobs x 1, sum of exp(log p - maxlogp)
+  datamatrix meanlogp;             // nrobs x 1, running mean of log p
+  datamatrix ssqlogp;              // nrobs x 1, running sum of squared
+                                   // deviations of log p
+  datamatrix maxlogr;              // nrobs x 1, maximum log ratio
+  datamatrix sumratio;             // nrobs x 1, sum of exp(log r - maxlogr)
+  datamatrix tail;                 // nrobs x (tailsize+1), min-heaps of the
+                                   // largest log ratios
+
+  // FUNCTION: fit_gpd
+  // TASK: fits the generalized Pareto distribution to the (sorted,
+  //       positive) exceedances x[0],...,x[n-1], returns the shape 'k' and
+  //       the scale 'sigma'
+
+  void fit_gpd(const vector<double> & x,double & k,double & sigma) const;
+
+  public:
+
+  // DEFAULT CONSTRUCTOR
+
+  model_comparison(void);
+
+  // CONSTRUCTOR
+  // n  : number of observations
+  // ss : expected number of retained draws (determines the tail size)
+
+  model_comparison(const unsigned & n,const unsigned & ss);
+
+  // COPY CONSTRUCTOR
+
+  model_comparison(const model_comparison & m);
+
+  // OVERLOADED ASSIGNMENT OPERATOR
+
+  const model_comparison & operator=(const model_comparison & m);
+
+  // DESTRUCTOR
+
+  ~model_comparison() {}
+
+  // FUNCTION: update
+  // TASK: adds the log-likelihood 'logp' of observation i for the current
+  //       draw. Must be called for all observations before next_draw.
+
+  void update(const unsigned & i,const double & logp);
+
+  // FUNCTION: next_draw
+  // TASK: completes the current draw
+
+  void next_draw(void)
+    {
+    nrdraws++;
+    }
+
+  unsigned get_nrdraws(void) const
+    {
+    return nrdraws;
+    }
+
+  // FUNCTION: reset
+  // TASK: discards all processed draws
+
+  void reset(void);
+
+  // FUNCTION: compute_WAIC
+  // TASK: computes -2 * log pointwise predictive density (l_pd) and the
+  //       effective number of parameters (p_d)
+
+  void compute_WAIC(double & l_pd,double & p_d) const;
+
+  // FUNCTION: compute_LOO
+  // TASK: computes the PSIS-LOO expected log pointwise predictive density
+  //       'elpd' and the effective number of parameters 'p_loo'.
+  //       'k' (nrobs x 1) returns the estimated Pareto shape parameters
+  //       (values above 0.7 indicate unreliable estimates).
+
+  void compute_LOO(double & elpd,double & p_loo,datamatrix & k) const;
+
+  // FUNCTION: write_state, read_state
+  // TASK: writes/reads the complete state to/from a binary snapshot
+
+  void write_state(ofstream & out) const;
+
+  void read_state(ifstream & in);
+
+  };
+
+
+} // end: namespace MCMC
+
+#endif
@@ -189,6 +189,8 @@ term_nonp::term_nonp(vector<ST::string> & na)
   ssvsupdates.push_back("gibbs"); // Gibbs update for tau^2 based GIG full conditional
   ssvsupdate = stroption("ssvsupdate",ssvsupdates,"regcoeff");
 
+  nrneighbors = intoption("nrneighbors",10,1,100);
+
   }
 
 void term_nonp::setdefault(void)
@@ -289,6 +291,7 @@ void term_nonp::setdefault(void)
   reduceddesign.setdefault();
 
   ssvsupdate.setdefault();
+  nrneighbors.setdefault();
   }
 
 
@@ -437,6 +440,8 @@ bool term_nonp::check(term & t)
 
 	optlist.push_back(&ssvsupdate);
 
+    optlist.push_back(&nrneighbors);
+
     unsigned i;
     bool rec = true;
     for (i=1;i<t.options.size();i++)
@@ -658,6 +663,8 @@ bool term_nonp::check(term & t)
 
     t.options[80] = ssvsupdate.getvalue();
 
+    t.options[81] = ST::inttostring(nrneighbors.getvalue());
+
     setdefault();
     return true;
 
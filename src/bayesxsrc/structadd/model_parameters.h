@@ -141,6 +141,9 @@ class __EXPORT_TYPE term_nonp : public basic_termtype
 
   stroption ssvsupdate;
 
+  // size of the conditioning sets of nearest neighbour GPs (vecchia)
+  intoption nrneighbors;
+
   vector<ST::string> termnames;
 
   void setdefault(void);
@@ -24,6 +24,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 //#include<typeinfo.h>
 
 #include<stddef.h>
+#include<algorithm>
 using std::ifstream;
 
 
@@ -50,6 +51,11 @@ bool superbayesreg::find_binomial(DISTR* & b)
     found = true;
     b = &distr_logit_fruehwirths[0];
     }
+  else if (distr_logit_polyagammas.size()==1)
+    {
+    found = true;
+    b = &distr_logit_polyagammas[0];
+    }
   else if (distr_cloglogs.size()==1)
     {
     found = true;
@@ -195,6 +201,8 @@ void superbayesreg::create_hregress(void)
   tnames.push_back("spatial");
   tnames.push_back("kriging");
   tnames.push_back("geokriging");
+  tnames.push_back("vecchia");
+  tnames.push_back("spde");
   tnames.push_back("hrandom_pspline");
   tnames.push_back("hrandom_mrf");
   tnames.push_back("mrf_pspline");
@@ -249,6 +257,7 @@ void superbayesreg::create_hregress(void)
   families.push_back("multinom_probit");
   families.push_back("multgaussian");
   families.push_back("binomial_logit_l1");
+  families.push_back("binomial_logit_pg");
   families.push_back("multinom_logit");
   families.push_back("zip");
   families.push_back("hurdle");
@@ -403,6 +412,8 @@ void superbayesreg::create_hregress(void)
 
   WAICoff = simpleoption("WAICoff",false);
 
+  fusedpredict = simpleoption("fusedpredict",false);
+
   pred_check = simpleoption("pred_check",false);
 
   cv = simpleoption("cv",false);
@@ -465,11 +476,30 @@ void superbayesreg::create_hregress(void)
 
   ssvsvarlimit = doubleoption("ssvsvarlimit",0.0000000001,0,0.1);
   IWLSlineff = simpleoption("IWLSlineff", false);
+  XWXsingle = simpleoption("XWXsingle", false);
   forceIWLS = simpleoption("forceIWLS", false);
   highspeedon = simpleoption("highspeedon", false);
 
   importance = simpleoption("importance", false);
 
+  convdiag = simpleoption("convdiag",false);
+  diaglag = intoption("diaglag",10,1,100);
+  essstop = doubleoption("essstop",0,0,1000000000);
+  rhatstop = doubleoption("rhatstop",0,0,10);
+  stopcheck = intoption("stopcheck",1000,1,10000000);
+
+  checkpoint = intoption("checkpoint",0,0,100000000);
+  resume = simpleoption("resume",false);
+
+  adaptiwls = simpleoption("adaptiwls",false);
+  targetacceptance = doubleoption("targetacceptance",0.5,0.05,0.95);
+
+  fastprobit = simpleoption("fastprobit",false);
+
+  aggregate = simpleoption("aggregate",false);
+
+  binaryoutput = simpleoption("binaryoutput",false);
+
 
   regressoptions.reserve(200);
 
@@ -519,11 +549,25 @@ void superbayesreg::create_hregress(void)
   regressoptions.push_back(&samplesel);
   regressoptions.push_back(&sampleselval);
   regressoptions.push_back(&WAICoff);
+  regressoptions.push_back(&fusedpredict);
   regressoptions.push_back(&ssvsvarlimit);
   regressoptions.push_back(&IWLSlineff);
+  regressoptions.push_back(&XWXsingle);
   regressoptions.push_back(&forceIWLS);
   regressoptions.push_back(&highspeedon);
   regressoptions.push_back(&importance);
+  regressoptions.push_back(&convdiag);
+  regressoptions.push_back(&diaglag);
+  regressoptions.push_back(&essstop);
+  regressoptions.push_back(&rhatstop);
+  regressoptions.push_back(&stopcheck);
+  regressoptions.push_back(&checkpoint);
+  regressoptions.push_back(&resume);
+  regressoptions.push_back(&adaptiwls);
+  regressoptions.push_back(&targetacceptance);
+  regressoptions.push_back(&fastprobit);
+  regressoptions.push_back(&aggregate);
+  regressoptions.push_back(&binaryoutput);
 
   // methods 0
   methods.push_back(command("hregress",&modreg,&regressoptions,&udata,required,
@@ -661,6 +705,10 @@ void superbayesreg::clear(void)
                                distr_logit_fruehwirths.end());
   distr_logit_fruehwirths.reserve(20);
 
+  distr_logit_polyagammas.erase(distr_logit_polyagammas.begin(),
+                                distr_logit_polyagammas.end());
+  distr_logit_polyagammas.reserve(20);
+
   distr_ziplambdas.erase(distr_ziplambdas.begin(),distr_ziplambdas.end());
   distr_ziplambdas.reserve(20);
 
@@ -1082,6 +1130,12 @@ void superbayesreg::clear(void)
   design_krigings.erase(design_krigings.begin(),design_krigings.end());
   design_krigings.reserve(200);
 
+  design_vecchias.erase(design_vecchias.begin(),design_vecchias.end());
+  design_vecchias.reserve(200);
+
+  design_spdes.erase(design_spdes.begin(),design_spdes.end());
+  design_spdes.reserve(200);
+
   design_hrandoms.erase(design_hrandoms.begin(),design_hrandoms.end());
   design_hrandoms.reserve(200);
 
@@ -1171,6 +1225,7 @@ superbayesreg::superbayesreg(const ST::string & n,ofstream * lo,istream * in,
   posteriormode = false;
   computemodeforstartingvalues = true;
   firstvarselection = true;
+  inmemory = false;
   describetext.push_back("CURRENT REGRESSION RESULTS: none\n");
   }
 
@@ -1188,6 +1243,9 @@ superbayesreg::superbayesreg(const superbayesreg & b) : statobject(statobject(b)
   statobj = b.statobj;
 
   D = b.D;
+  Dexpanded = b.Dexpanded;
+  aggregationindex = b.aggregationindex;
+  inmemory = b.inmemory;
 
   modelvarnamesv = b.modelvarnamesv;
 
@@ -1224,6 +1282,7 @@ superbayesreg::superbayesreg(const superbayesreg & b) : statobject(statobject(b)
   distr_multgaussians = b.distr_multgaussians;
   distr_multinomlogits = b.distr_multinomlogits;
   distr_logit_fruehwirths = b.distr_logit_fruehwirths;
+  distr_logit_polyagammas = b.distr_logit_polyagammas;
   distr_ziplambdas = b.distr_ziplambdas;
   distr_zippis = b.distr_zippis;
   distr_hurdle_lambdas = b.distr_hurdle_lambdas;
@@ -1396,6 +1455,8 @@ superbayesreg::superbayesreg(const superbayesreg & b) : statobject(statobject(b)
   FC_hrandom_variance_ssvss = b.FC_hrandom_variance_ssvss;
 
   design_krigings = b.design_krigings;
+  design_vecchias = b.design_vecchias;
+  design_spdes = b.design_spdes;
   design_mrfs = b.design_mrfs;
 
   errors = b.errors;
@@ -1419,6 +1480,9 @@ const superbayesreg & superbayesreg::operator=(const superbayesreg & b)
   statobj = b.statobj;
 
   D = b.D;
+  Dexpanded = b.Dexpanded;
+  aggregationindex = b.aggregationindex;
+  inmemory = b.inmemory;
 
   modelvarnamesv = b.modelvarnamesv;
 
@@ -1454,6 +1518,7 @@ const superbayesreg & superbayesreg::operator=(const superbayesreg & b)
   distr_multgaussians = b.distr_multgaussians;
   distr_multinomlogits = b.distr_multinomlogits;
   distr_logit_fruehwirths = b.distr_logit_fruehwirths;
+  distr_logit_polyagammas = b.distr_logit_polyagammas;
   distr_ziplambdas = b.distr_ziplambdas;
   distr_zippis = b.distr_zippis;
   distr_hurdle_lambdas = b.distr_hurdle_lambdas;
@@ -1625,6 +1690,8 @@ const superbayesreg & superbayesreg::operator=(const superbayesreg & b)
   FC_hrandom_variance_ssvss = b.FC_hrandom_variance_ssvss;
 
   design_krigings = b.design_krigings;
+  design_vecchias = b.design_vecchias;
+  design_spdes = b.design_spdes;
   design_mrfs = b.design_mrfs;
 
   errors = b.errors;
@@ -1674,6 +1741,50 @@ bool superbayesreg::create_generaloptions(void)
                                 logout,
                                 level1.getvalue(),level2.getvalue());
 
+    generaloptions.set_convdiag(convdiag.getvalue(),diaglag.getvalue(),
+                                essstop.getvalue(),rhatstop.getvalue(),
+                                stopcheck.getvalue());
+
+    if (generaloptions.earlystopping() &&
+        (cv.getvalue() || pred_check.getvalue()))
+      {
+      outerror("ERROR: stopping rule (essstop, rhatstop) cannot be combined with options cv and pred_check\n");
+      return true;
+      }
+
+    generaloptions.set_checkpoint(checkpoint.getvalue(),resume.getvalue());
+
+    if ((checkpoint.getvalue() > 0 || resume.getvalue()) &&
+        (cv.getvalue() || pred_check.getvalue()))
+      {
+      outerror("ERROR: options checkpoint and resume cannot be combined with options cv and pred_check\n");
+      return true;
+      }
+
+    generaloptions.set_adaptiwls(adaptiwls.getvalue(),
+                                 targetacceptance.getvalue());
+
+    generaloptions.set_fastprobit(fastprobit.getvalue());
+
+    generaloptions.set_aggregate(aggregate.getvalue());
+
+    if (aggregate.getvalue() && (cv.getvalue() || pred_check.getvalue()))
+      {
+      outerror("ERROR: option aggregate cannot be combined with options cv and pred_check\n");
+      return true;
+      }
+
+    generaloptions.set_inmemory(inmemory);
+
+    generaloptions.set_binaryoutput(binaryoutput.getvalue());
+
+    if (inmemory &&
+        (cv.getvalue() || pred_check.getvalue() || modeonly.getvalue()))
+      {
+      outerror("ERROR: options cv, pred_check and modeonly are not available for in-process runs\n");
+      return true;
+      }
+
     describetext.push_back("ESTIMATION OPTIONS:\n");
     describetext.push_back("\n");
     describetext.push_back("Number of Iterations: "
@@ -1813,6 +1924,11 @@ void hregressrun(superbayesreg & b)
         else
           failure = b.simobj.simulate(pathgraphs,b.setseed.getvalue(),
           b.computemodeforstartingvalues, skipfirst);
+
+        // errors during the simulation (in-process runs only)
+
+        if (failure)
+          b.check_errors();
         }
 
       if (!failure)
@@ -1873,6 +1989,289 @@ bool superbayesreg::check_errors(void)
   }
 
 
+bool superbayesreg::get_results(vector<ST::string> & names,
+                                vector< vector<ST::string> > & labels,
+                                vector<datamatrix> & summaries,
+                                vector<datamatrix> & samples)
+  {
+
+  names.erase(names.begin(),names.end());
+  labels.erase(labels.begin(),labels.end());
+  summaries.erase(summaries.begin(),summaries.end());
+  samples.erase(samples.begin(),samples.end());
+
+  if (resultsyesno == false)
+    return true;
+
+  unsigned i,j,k;
+  unsigned nrmodels = equations.size();
+
+  // full conditionals in the order of the results output
+
+  vector<FC*> fcs;
+  vector<ST::string> paths;
+  for (i=0;i<nrmodels;i++)
+    {
+    DISTR_gaussian * dg =
+                   dynamic_cast<DISTR_gaussian*>(equations[nrmodels-1-i].distrp);
+    if (dg != NULL)
+      {
+      fcs.push_back(&(dg->FCsigma2));
+      paths.push_back(equations[nrmodels-1-i].pathd);
+      }
+
+    for(j=0;j<equations[nrmodels-1-i].nrfc;j++)
+      {
+      fcs.push_back(equations[nrmodels-1-i].FCpointer[j]);
+      paths.push_back(equations[nrmodels-1-i].FCpaths[j]);
+      }
+    }
+
+  ST::string prefix = outfile.getvalue();
+  int pos = prefix.checksign('/');
+  while (pos >= 0)
+    {
+    prefix = prefix.substr(pos+1,prefix.length()-pos-1);
+    pos = prefix.checksign('/');
+    }
+  pos = prefix.checksign('\\');
+  while (pos >= 0)
+    {
+    prefix = prefix.substr(pos+1,prefix.length()-pos-1);
+    pos = prefix.checksign('\\');
+    }
+
+  for (i=0;i<fcs.size();i++)
+    {
+
+    bool stored = false;
+    for (j=0;j<generaloptions.storedFC.size();j++)
+      if (generaloptions.storedFC[j] == fcs[i])
+        stored = true;
+
+    if (stored)
+      {
+
+      // name: path and ending removed
+
+      ST::string n = paths[i];
+      pos = n.checksign('/');
+      while (pos >= 0)
+        {
+        n = n.substr(pos+1,n.length()-pos-1);
+        pos = n.checksign('/');
+        }
+      pos = n.checksign('\\');
+      while (pos >= 0)
+        {
+        n = n.substr(pos+1,n.length()-pos-1);
+        pos = n.checksign('\\');
+        }
+      if ((n.length() > 4) && (n.substr(n.length()-4,4) == ".res"))
+        n = n.substr(0,n.length()-4);
+      if ((n.length() > prefix.length()+1) &&
+          (n.substr(0,prefix.length()+1) == prefix + "_"))
+        n = n.substr(prefix.length()+1,n.length()-prefix.length()-1);
+      else if ((n.length() > name.length()+1) &&
+               (n.substr(0,name.length()+1) == name + "_"))
+        n = n.substr(name.length()+1,n.length()-name.length()-1);
+      if (n == "")
+        n = "fc" + ST::inttostring(i+1);
+      names.push_back(n);
+
+      // labels
+
+      unsigned nrpar = fcs[i]->beta.rows()*fcs[i]->beta.cols();
+
+      vector<ST::string> l;
+      FC_linear * fcl = dynamic_cast<FC_linear*>(fcs[i]);
+      FC_nonp * fcn = dynamic_cast<FC_nonp*>(fcs[i]);
+      if ((fcl != NULL) && (fcl->datanames.size() == nrpar))
+        l = fcl->datanames;
+      else if ((fcn != NULL) && (fcn->designp->effectvalues.size() == nrpar))
+        l = fcn->designp->effectvalues;
+      labels.push_back(l);
+
+      // summaries, the quantiles are only available if samples are stored
+
+      fcs[i]->compute_quantiles();
+
+      datamatrix s(nrpar,7,NA);
+      double * workmean = fcs[i]->betamean.getV();
+      double * workvar = fcs[i]->betavar.getV();
+      for (k=0;k<nrpar;k++,workmean++,workvar++)
+        {
+        s(k,0) = *workmean;
+        if (*workvar < 0.0000000000001)
+          s(k,1) = 0;
+        else
+          s(k,1) = sqrt(*workvar);
+        if (fcs[i]->nosamplessave == false)
+          {
+          s(k,2) = fcs[i]->betaqu_l1_lower.getV()[k];
+          s(k,3) = fcs[i]->betaqu_l2_lower.getV()[k];
+          s(k,4) = fcs[i]->betaqu50.getV()[k];
+          s(k,5) = fcs[i]->betaqu_l2_upper.getV()[k];
+          s(k,6) = fcs[i]->betaqu_l1_upper.getV()[k];
+          }
+        }
+      summaries.push_back(s);
+
+      if (fcs[i]->nosamplessave == false)
+        samples.push_back(fcs[i]->sampled_beta);
+      else
+        samples.push_back(datamatrix(0,nrpar));
+
+      }
+
+    }
+
+  return false;
+  }
+
+
+// compares two observations (rows of a datamatrix) lexicographically with
+// respect to the covariates, i.e. all columns except the response (column 0)
+// and the weights
+
+class aggregation_compare
+  {
+
+  const datamatrix * Dp;
+  unsigned weightpos;
+
+  public:
+
+  aggregation_compare(const datamatrix * d,const unsigned & wp)
+    {
+    Dp = d;
+    weightpos = wp;
+    }
+
+  bool operator()(const unsigned & i,const unsigned & j) const
+    {
+    unsigned c;
+    for (c=1;c<Dp->cols();c++)
+      {
+      if (c != weightpos)
+        {
+        if ((*Dp)(i,c) < (*Dp)(j,c))
+          return true;
+        else if ((*Dp)(i,c) > (*Dp)(j,c))
+          return false;
+        }
+      }
+    return false;
+    }
+
+  };
+
+
+void superbayesreg::aggregate_data(const unsigned & weightpos,
+                                   const bool & sums,datamatrix & w,
+                                   double & ss,double & nadd)
+  {
+
+  unsigned i,c,g;
+  unsigned nrobs = D.rows();
+  unsigned nrcols = D.cols();
+
+  Dexpanded = D;
+  aggregationindex = statmatrix<int>(nrobs,1,0);
+
+  datamatrix wexpanded(nrobs,1,1);
+  if (weightpos > 0)
+    wexpanded = D.getCol(weightpos);
+
+  // sorting the observations with respect to the covariates
+
+  vector<unsigned> order(nrobs);
+  for (i=0;i<nrobs;i++)
+    order[i] = i;
+
+  aggregation_compare comp(&Dexpanded,weightpos);
+  std::stable_sort(order.begin(),order.end(),comp);
+
+  // grouping identical covariate patterns
+
+  unsigned nrgroups = 0;
+  vector<unsigned> first;
+  for (i=0;i<nrobs;i++)
+    {
+    if ((i==0) || comp(order[i-1],order[i]))
+      {
+      first.push_back(order[i]);
+      nrgroups++;
+      }
+    aggregationindex(order[i],0) = nrgroups-1;
+    }
+
+  datamatrix sumw(nrgroups,1,0);
+  datamatrix sumy(nrgroups,1,0);
+  datamatrix nrpos(nrgroups,1,0);
+
+  double * workw = wexpanded.getV();
+  for (i=0;i<nrobs;i++,workw++)
+    {
+    g = aggregationindex(i,0);
+    sumw(g,0) += *workw;
+    if (*workw > 0)
+      {
+      // observations with zero weight are excluded, i.e. their successes
+      // must not be added
+
+      if (sums)
+        sumy(g,0) += Dexpanded(i,0);
+      else
+        sumy(g,0) += *workw * Dexpanded(i,0);
+      nrpos(g,0)++;
+      }
+    }
+
+  D = datamatrix(nrgroups,nrcols);
+  w = datamatrix(nrgroups,1);
+
+  nadd = 0;
+  for (g=0;g<nrgroups;g++)
+    {
+    for (c=1;c<nrcols;c++)
+      D(g,c) = Dexpanded(first[g],c);
+
+    if (sums)
+      D(g,0) = sumy(g,0);
+    else if (sumw(g,0) > 0)
+      D(g,0) = sumy(g,0)/sumw(g,0);
+    else
+      D(g,0) = Dexpanded(first[g],0);
+
+    w(g,0) = sumw(g,0);
+    if (weightpos > 0)
+      D(g,weightpos) = sumw(g,0);
+
+    if (nrpos(g,0) > 0)
+      nadd += nrpos(g,0)-1;
+    }
+
+  // weighted within group sum of squares
+
+  ss = 0;
+  double help;
+  workw = wexpanded.getV();
+  for (i=0;i<nrobs;i++,workw++)
+    {
+    if (*workw > 0)
+      {
+      help = Dexpanded(i,0) - D(aggregationindex(i,0),0);
+      ss += *workw*help*help;
+      }
+    }
+
+  if (sums)
+    ss = 0;
+
+  }
+
+
 bool superbayesreg::create_distribution(void)
   {
 
@@ -1971,6 +2370,52 @@ bool superbayesreg::create_distribution(void)
   if(generaloptions.samplesel && distr_binomialprobit_copulas.size()>0)
     w = distr_binomialprobit_copulas[0].responseorig;
 
+  // grouped likelihood
+
+  double aggregatedss = 0;
+  double aggregatednrobs = 0;
+  double responsesd = 0;
+
+  if (aggregate.getvalue() == true)
+    {
+
+    ST::string f = family.getvalue();
+
+    if ( ((f != "gaussian") && (f != "poisson") && (f != "binomial_logit") &&
+          (f != "binomial_logit_pg")) || (equationtype.getvalue() != "mu") ||
+         (hlevel.getvalue() != 1) || (equations.size() > 1) )
+      {
+      outerror("ERROR: option aggregate is allowed only for single equation models with\n");
+      outerror("       family=gaussian, poisson, binomial_logit or binomial_logit_pg\n");
+      return true;
+      }
+
+    if ((predict.getvalue() == "predictor") || (predict.getvalue() == "fulls"))
+      {
+      outerror("ERROR: option aggregate cannot be combined with predict=" +
+               predict.getvalue() + "\n");
+      return true;
+      }
+
+    if (f == "gaussian")
+      {
+      datamatrix resp = D.getCol(0);
+      if (weightsdefined)
+        responsesd = sqrt(resp.var(0,w));
+      else
+        responsesd = sqrt(resp.var(0,datamatrix(D.rows(),1,1)));
+      }
+
+    unsigned nrobsorig = D.rows();
+
+    aggregate_data(weightpos,(f != "gaussian") && (f != "poisson"),w,
+                   aggregatedss,aggregatednrobs);
+    weightsdefined = true;
+
+    out("NOTE: " + ST::inttostring(nrobsorig) + " observations grouped into "
+        + ST::inttostring(D.rows()) + " distinct covariate patterns\n");
+    }
+
   describetext.push_back("Response distribution: "
                            + family.getvalue() + "\n");
 
@@ -1997,6 +2442,10 @@ bool superbayesreg::create_distribution(void)
     distr_gaussians.push_back(DISTR_gaussian(aresp.getvalue(),bresp.getvalue(),
                                       &generaloptions,D.getCol(0),path,w) );
 
+    if (aggregate.getvalue() == true)
+      distr_gaussians[distr_gaussians.size()-1].set_aggregation(aggregatedss,
+                                           aggregatednrobs,responsesd);
+
     equations[modnr].distrp = &distr_gaussians[distr_gaussians.size()-1];
     equations[modnr].pathd = outfile.getvalue() + "_scale.res";
 
@@ -9026,6 +9475,23 @@ bool superbayesreg::create_distribution(void)
     equations[modnr].distrp = &distr_logit_fruehwirths[distr_logit_fruehwirths.size()-1];
     equations[modnr].pathd = "";
 
+    }
+//----------------------- Binomial response logit Polya-Gamma ------------------
+  else if (family.getvalue() == "binomial_logit_pg")
+    {
+
+    mainequation=true;
+
+    computemodeforstartingvalues = true;
+
+    equations[modnr].equationtype="pi";
+
+    distr_logit_polyagammas.push_back(DISTR_logit_polyagamma(
+    &generaloptions,D.getCol(0),w));
+
+    equations[modnr].distrp = &distr_logit_polyagammas[distr_logit_polyagammas.size()-1];
+    equations[modnr].pathd = "";
+
     }
 //-------------------------- END: Binomial response probit ---------------------
   else
@@ -9216,6 +9682,13 @@ bool superbayesreg::create_predict(void)
           if (predict.getvalue() == "light")
             FC_predicts[FC_predicts.size()-1].nosamplessave=true;
 
+          if (fusedpredict.getvalue() == true)
+            FC_predicts[FC_predicts.size()-1].fused=true;
+
+          if (aggregate.getvalue() == true)
+            FC_predicts[FC_predicts.size()-1].set_aggregation(Dexpanded,
+                                                        aggregationindex);
+
           if (mse.getvalue() ==  "yes")
             FC_predicts[FC_predicts.size()-1].MSE = MCMC::quadraticMSE;
 
@@ -9414,7 +9887,8 @@ bool superbayesreg::create_linear(void)
 
   FC_linears.push_back(FC_linear(&master,nrlevel1,&generaloptions,equations[modnr].distrp,X,
                          varnames,title,pathconst,
-                         centerlinear.getvalue(),IWLSlineff.getvalue()));
+                         centerlinear.getvalue(),IWLSlineff.getvalue(),
+                         XWXsingle.getvalue()));
 
   equations[modnr].add_FC(&FC_linears[FC_linears.size()-1],pathconstres);
 
@@ -10636,6 +11110,94 @@ bool superbayesreg::create_kriging(unsigned i)
   }
 
 
+bool superbayesreg::create_vecchia(unsigned i)
+  {
+
+  unsigned modnr = equations.size()-1;
+
+  make_paths(pathnonp,pathres,title,terms[i].varnames,
+             "_vecchia.raw","2dim_vecchia_effect_of",
+             "2dim effect (nearest neighbour GP) of ");
+
+  datamatrix d,iv;
+  extract_data(i,d,iv,2);
+
+  design_vecchias.push_back(DESIGN_vecchia(d,iv,&generaloptions,
+                            equations[modnr].distrp,
+                           &FC_linears[FC_linears.size()-1],
+                            terms[i].options,terms[i].varnames));
+
+  FC_nonps.push_back(FC_nonp(&master,nrlevel1,&generaloptions,equations[modnr].distrp,
+                     title, pathnonp,&design_vecchias[design_vecchias.size()-1],
+                     terms[i].options,terms[i].varnames));
+
+  if (FC_nonps[FC_nonps.size()-1].errors==true)
+    return true;
+
+  equations[modnr].add_FC(&FC_nonps[FC_nonps.size()-1],pathres);
+
+  // variances
+
+  make_paths(pathnonp,pathres,title,terms[i].varnames,
+  "_vecchia_var.raw","variance_of_2dim_vecchia_effect_of",
+  "Variance of 2dim effect of ");
+
+  FC_nonp_variances.push_back(FC_nonp_variance(&master,nrlevel1,
+                                &generaloptions,equations[modnr].distrp,
+                                title,pathnonp,&design_vecchias[design_vecchias.size()-1],
+                                &FC_nonps[FC_nonps.size()-1],terms[i].options,
+                                terms[i].varnames));
+
+  equations[modnr].add_FC(&FC_nonp_variances[FC_nonp_variances.size()-1],pathres);
+
+  return false;
+  }
+
+
+bool superbayesreg::create_spde(unsigned i)
+  {
+
+  unsigned modnr = equations.size()-1;
+
+  make_paths(pathnonp,pathres,title,terms[i].varnames,
+             "_spde.raw","2dim_spde_effect_of",
+             "2dim effect (SPDE Matern field) of ");
+
+  datamatrix d,iv;
+  extract_data(i,d,iv,2);
+
+  design_spdes.push_back(DESIGN_spde(d,iv,&generaloptions,
+                         equations[modnr].distrp,
+                         &FC_linears[FC_linears.size()-1],
+                         terms[i].options,terms[i].varnames));
+
+  FC_nonps.push_back(FC_nonp(&master,nrlevel1,&generaloptions,equations[modnr].distrp,
+                     title, pathnonp,&design_spdes[design_spdes.size()-1],
+                     terms[i].options,terms[i].varnames));
+
+  if (FC_nonps[FC_nonps.size()-1].errors==true)
+    return true;
+
+  equations[modnr].add_FC(&FC_nonps[FC_nonps.size()-1],pathres);
+
+  // variances
+
+  make_paths(pathnonp,pathres,title,terms[i].varnames,
+  "_spde_var.raw","variance_of_2dim_spde_effect_of",
+  "Variance of 2dim effect of ");
+
+  FC_nonp_variances.push_back(FC_nonp_variance(&master,nrlevel1,
+                                &generaloptions,equations[modnr].distrp,
+                                title,pathnonp,&design_spdes[design_spdes.size()-1],
+                                &FC_nonps[FC_nonps.size()-1],terms[i].options,
+                                terms[i].varnames));
+
+  equations[modnr].add_FC(&FC_nonp_variances[FC_nonp_variances.size()-1],pathres);
+
+  return false;
+  }
+
+
 bool superbayesreg::create_userdefined_tensor(unsigned i)
   {
 
@@ -11174,7 +11736,8 @@ bool superbayesreg::create_ridge_lasso(unsigned i)
 
     FC_linear_pens.push_back(FC_linear_pen(&master,nrlevel1,&generaloptions,
                          equations[modnr].distrp,d,terms[i].varnames,title,
-                         pathpen, centerlinear.getvalue(), IWLSlineff.getvalue()));
+                         pathpen, centerlinear.getvalue(), IWLSlineff.getvalue(),
+                         XWXsingle.getvalue()));
 
     equations[modnr].add_FC(&FC_linear_pens[FC_linear_pens.size()-1],pathpenres);
 
@@ -11328,6 +11891,10 @@ bool superbayesreg::create_nonp(void)
         error = create_kriging(i);
       if (terms[i].options[0] == "geokriging")
         error = create_geokriging(i);
+      if (terms[i].options[0] == "vecchia")
+        error = create_vecchia(i);
+      if (terms[i].options[0] == "spde")
+        error = create_spde(i);
       if ((terms[i].options[0] == "hrandom_pspline") ||
           (terms[i].options[0] == "hrandomexp_pspline"))
         error = create_random_pspline(i);
@@ -45,6 +45,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include"design_hrandom.h"
 #include"design_mrf.h"
 #include"design_kriging.h"
+#include"design_vecchia.h"
+#include"design_spde.h"
 #include"design_userdefined.h"
 
 #include"FC.h"
@@ -93,6 +95,7 @@ using MCMC::DISTR_binomialprobit;
 using MCMC::DISTR_cloglog;
 using MCMC::DISTR_binomialsvm;
 using MCMC::DISTR_logit_fruehwirth;
+using MCMC::DISTR_logit_polyagamma;
 using MCMC::DISTR_multinomprobit;
 using MCMC::DISTR_multgaussian;
 using MCMC::DISTR_multinomlogit;
@@ -244,6 +247,8 @@ using MCMC::DESIGN_pspline;
 using MCMC::DESIGN_hrandom;
 using MCMC::DESIGN_mrf;
 using MCMC::DESIGN_kriging;
+using MCMC::DESIGN_vecchia;
+using MCMC::DESIGN_spde;
 using MCMC::DESIGN_userdefined;
 using MCMC::DESIGN_userdefined_tensor;
 using MCMC::FC_tensor_omega;
@@ -319,6 +324,16 @@ class __EXPORT_TYPE superbayesreg : public statobject
 
   datamatrix D;
 
+  // grouped likelihood (option aggregate): original data and index of the
+  // grouped record (row of D) of each observation
+
+  datamatrix Dexpanded;
+  statmatrix<int> aggregationindex;
+
+  // in-process runs: results are kept in memory (see get_results)
+
+  bool inmemory;
+
   vector<ST::string> modelvarnamesv;
 
   // global options
@@ -387,6 +402,7 @@ class __EXPORT_TYPE superbayesreg : public statobject
   vector<ST::string> predictop;
   stroption predict;
   simpleoption WAICoff;
+  simpleoption fusedpredict;
 
   simpleoption pred_check;
 
@@ -447,11 +463,44 @@ class __EXPORT_TYPE superbayesreg : public statobject
 
   simpleoption IWLSlineff;
 
+  // accumulate X'WX of the linear effects in single precision
+  simpleoption XWXsingle;
+
   simpleoption forceIWLS;
 
   simpleoption highspeedon;
 
   simpleoption importance;
+
+  // online convergence diagnostics and stopping rule
+
+  simpleoption convdiag;
+  intoption diaglag;
+  doubleoption essstop;
+  doubleoption rhatstop;
+  intoption stopcheck;
+
+  // checkpoints
+
+  intoption checkpoint;
+  simpleoption resume;
+
+  // adaptive IWLS proposals
+
+  simpleoption adaptiwls;
+  doubleoption targetacceptance;
+
+  // sampler for the latent variables of probit models
+
+  simpleoption fastprobit;
+
+  // grouped likelihood for identical covariate patterns
+
+  simpleoption aggregate;
+
+  // results and samples in binary files
+
+  simpleoption binaryoutput;
   // end: OPTIONS for method regress
 
  // ------------------------------- MASTER_OBJ ---------------------------------
@@ -478,6 +527,7 @@ class __EXPORT_TYPE superbayesreg : public statobject
   vector<DISTR_cloglog> distr_cloglogs;
   vector<DISTR_binomialsvm> distr_binomialsvms;
   vector<DISTR_logit_fruehwirth> distr_logit_fruehwirths;
+  vector<DISTR_logit_polyagamma> distr_logit_polyagammas;
   vector<DISTR_multinomprobit> distr_multinomprobits;
   vector<DISTR_multgaussian> distr_multgaussians;
   vector<DISTR_multinomlogit> distr_multinomlogits;
@@ -624,6 +674,18 @@ class __EXPORT_TYPE superbayesreg : public statobject
 
   bool create_distribution(void);
 
+  // FUNCTION: aggregate_data
+  // TASK: collapses observations with identical covariates (all columns of
+  //       D except response and weights) into grouped records. For
+  //       binomial responses the grouped response is the number of
+  //       successes, otherwise the weighted mean. w contains the grouped
+  //       weights on exit, ss the weighted within group sum of squares of
+  //       the response and nadd the number of observations with positive
+  //       weight not represented by a grouped record.
+
+  void aggregate_data(const unsigned & weightpos,const bool & sums,
+                      datamatrix & w,double & ss,double & nadd);
+
   bool resultsyesno;
   bool posteriormode;
   bool computemodeforstartingvalues;
@@ -714,6 +776,8 @@ class __EXPORT_TYPE superbayesreg : public statobject
   vector<DESIGN_pspline> design_psplines;
   vector<DESIGN_mrf> design_mrfs;
   vector<DESIGN_kriging> design_krigings;
+  vector<DESIGN_vecchia> design_vecchias;
+  vector<DESIGN_spde> design_spdes;
   vector<FC_nonp> FC_nonps;
   vector<FC_merror> FC_merrors;
   vector<FC_nonp_variance> FC_nonp_variances;
@@ -726,6 +790,8 @@ class __EXPORT_TYPE superbayesreg : public statobject
   bool create_mrf(unsigned i);
   bool create_kriging(unsigned i);
   bool create_geokriging(unsigned i);
+  bool create_vecchia(unsigned i);
+  bool create_spde(unsigned i);
 
   bool find_map(unsigned i,MAP::map & m);
 
@@ -828,6 +894,7 @@ class __EXPORT_TYPE superbayesreg : public statobject
     {
     type = "mcmcreg";
     resultsyesno = false;
+    inmemory = false;
     }
 
   // CONSTRUCTOR
@@ -856,6 +923,32 @@ class __EXPORT_TYPE superbayesreg : public statobject
 
   void describe(const optionlist & globaloptions = optionlist());
 
+  // FUNCTION: set_inmemory
+  // TASK: the results of the following runs are kept in memory only, i.e. no
+  //       result files are written (in-process runs)
+
+  void set_inmemory(const bool & im)
+    {
+    inmemory = im;
+    }
+
+  // FUNCTION: get_results
+  // TASK: returns the results of the last run for all full conditionals
+  //       with stored samples:
+  //       names     : name of the results file without path, outfile prefix
+  //                   and ending (e.g. MAIN_mu_REGRESSION_y_LinearEffects)
+  //       labels    : parameter labels (covariate names or values), empty if
+  //                   not available
+  //       summaries : posterior mean, standard deviation and quantiles
+  //                   (same columns as in the results files)
+  //       samples   : stored samples (one row per sample)
+  //       returns true, if no results are available
+
+  bool get_results(vector<ST::string> & names,
+                   vector< vector<ST::string> > & labels,
+                   vector<datamatrix> & summaries,
+                   vector<datamatrix> & samples);
+
   };
 
 #endif